@@ -71,6 +71,7 @@ BICAPI  void  initialize_bintree(
 
     bintree->n_nodes = 0;
     bintree->root = (bintree_node_struct *) 0;
+    bintree->bvh = (bvh_struct *) NULL;
 }
 
 /* ----------------------------- MNI Header -----------------------------------
@@ -136,6 +137,12 @@ BICAPI  void  delete_bintree(
 {
     if( bintree->root != NULL )
         recursive_delete_bintree( bintree->root );
+
+    if( bintree->bvh != NULL )
+    {
+        delete_bvh( bintree->bvh );
+        bintree->bvh = NULL;
+    }
 }
 
 /* ----------------------------- MNI Header -----------------------------------
@@ -626,6 +633,15 @@ BICAPI  Status  io_bintree(
 {
     Status   status;
 
+    if( direction == WRITE_FILE && bintree->bvh != NULL )
+    {
+        print_error( "io_bintree: cannot write a bounding volume hierarchy.\n" );
+        return( ERROR );
+    }
+
+    if( direction == READ_FILE )
+        bintree->bvh = (bvh_struct *) NULL;
+
     status = io_range( file, direction, format, &bintree->range );
 
     if( status == OK && direction == WRITE_FILE )
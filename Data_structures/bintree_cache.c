@@ -0,0 +1,610 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "bicpl_internal.h"
+
+#if HAVE_SYS_MMAN_H && HAVE_MMAP
+#include  <sys/types.h>
+#include  <sys/stat.h>
+#include  <sys/mman.h>
+#define  USE_MMAP
+#endif
+
+#if HAVE_UNISTD_H
+#include  <unistd.h>
+#endif
+
+/*--- A bintree cache file holds the bounding volume hierarchy built for
+      one set of polygons, in the native byte order: a header, padded to
+      BVH_NODE_ALIGNMENT bytes, followed by the nodes and the object list,
+      so that the nodes can be used in place in a memory mapping of the
+      file.  The files are named by a hash of the points and topology of
+      the polygons and of the maximum number of nodes, and the header holds
+      a hash of the rest of the file, to detect damaged files. */
+
+#define  BINTREE_CACHE_MAGIC       "BICPLBVH"
+#define  BINTREE_CACHE_VERSION     1
+#define  BINTREE_CACHE_BYTE_ORDER  0x01020304
+#define  BINTREE_CACHE_SUFFIX      "bvh"
+
+typedef  struct
+{
+    char           magic[8];
+    int            version;
+    int            byte_order;
+    int            node_size;
+    int            max_nodes;
+    int            n_points;
+    int            n_items;
+    unsigned int   key[2];
+    int            n_nodes;
+    int            n_objects;
+    unsigned int   checksum[2];     /* --- of the nodes and object list */
+} bintree_cache_header;
+
+#define  BINTREE_CACHE_HEADER_SIZE                                          \
+            (((sizeof(bintree_cache_header) + BVH_NODE_ALIGNMENT - 1) /     \
+              BVH_NODE_ALIGNMENT) * BVH_NODE_ALIGNMENT)
+
+static  STRING   cache_directory = NULL;
+static  BOOLEAN  cache_directory_initialized = FALSE;
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : set_bintree_cache_directory
+@INPUT      : directory   - NULL or empty to turn off caching
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Sets the directory in which create_polygons_bintree() looks
+              for, and saves, the bounding volume hierarchies of polygons,
+              so that each set of polygons has its hierarchy built only
+              once.  The default is the environment variable
+              BICPL_BINTREE_CACHE, and caching is off if it is not set.
+              The directory must exist.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  set_bintree_cache_directory(
+    STRING  directory )
+{
+    if( cache_directory != NULL )
+        delete_string( cache_directory );
+
+    if( directory == NULL || string_length( directory ) == 0 )
+        cache_directory = NULL;
+    else
+        cache_directory = create_string( directory );
+
+    cache_directory_initialized = TRUE;
+}
+
+BICAPI  STRING  get_bintree_cache_directory( void )
+{
+    char   *env;
+
+    if( !cache_directory_initialized )
+    {
+        env = getenv( "BICPL_BINTREE_CACHE" );
+        set_bintree_cache_directory( env );
+    }
+
+    return( cache_directory );
+}
+
+/*--- adds bytes to the two 32 bit lanes of a hash key */
+
+static  void  hash_bytes(
+    unsigned int   key[],
+    void           *data,
+    size_t         n_bytes )
+{
+    size_t          i;
+    unsigned int    word;
+    unsigned char   *bytes;
+
+    bytes = (unsigned char *) data;
+
+    for( i = 0;  i + sizeof(word) <= n_bytes;  i += sizeof(word) )
+    {
+        (void) memcpy( &word, bytes + i, sizeof(word) );
+
+        key[0] = (key[0] ^ word) * 16777619u;
+        key[0] ^= key[0] >> 13;
+        key[1] = (key[1] ^ word) * 0x5bd1e995u;
+        key[1] ^= key[1] >> 15;
+    }
+
+    for( ;  i < n_bytes;  ++i )
+    {
+        key[0] = (key[0] ^ (unsigned int) bytes[i]) * 16777619u;
+        key[1] = (key[1] ^ (unsigned int) bytes[i]) * 0x5bd1e995u;
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_polygons_cache_key
+@INPUT      : polygons
+              max_nodes
+@OUTPUT     : key
+@RETURNS    :
+@DESCRIPTION: Hashes the points and topology of the polygons, and the
+              parameters of the bintree, into the key naming its cache file.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  get_polygons_cache_key(
+    polygons_struct   *polygons,
+    int               max_nodes,
+    unsigned int      key[] )
+{
+    int   sizes[4];
+
+    key[0] = 2166136261u;
+    key[1] = 0x9747b28cu;
+
+    sizes[0] = BINTREE_CACHE_VERSION;
+    sizes[1] = max_nodes;
+    sizes[2] = polygons->n_points;
+    sizes[3] = polygons->n_items;
+
+    hash_bytes( key, (void *) sizes, sizeof(sizes) );
+
+    hash_bytes( key, (void *) polygons->points,
+                (size_t) polygons->n_points * sizeof(polygons->points[0]) );
+    hash_bytes( key, (void *) polygons->end_indices,
+                (size_t) polygons->n_items * sizeof(int) );
+    hash_bytes( key, (void *) polygons->indices,
+                (size_t) NUMBER_INDICES( *polygons ) * sizeof(int) );
+}
+
+/*--- the checksum of the nodes and object list of a hierarchy */
+
+static  void  get_bvh_checksum(
+    bvh_struct     *bvh,
+    unsigned int   checksum[] )
+{
+    checksum[0] = 2166136261u;
+    checksum[1] = 0x9747b28cu;
+
+    hash_bytes( checksum, (void *) bvh->nodes,
+                (size_t) bvh->n_nodes * sizeof(bvh_node_struct) );
+    hash_bytes( checksum, (void *) bvh->object_list,
+                (size_t) bvh->n_objects * sizeof(int) );
+}
+
+/*--- the name of the cache file for a key, which must be deleted */
+
+static  STRING  get_cache_filename(
+    STRING         directory,
+    unsigned int   key[] )
+{
+    char     name[EXTREMELY_LARGE_STRING_SIZE];
+    STRING   filename;
+
+    (void) sprintf( name, "/bintree_%08x%08x.%s", key[0], key[1],
+                    BINTREE_CACHE_SUFFIX );
+
+    filename = create_string( directory );
+    concat_to_string( &filename, name );
+
+    return( filename );
+}
+
+/*--- checks a cache file header against the polygons it is read for */
+
+static  BOOLEAN  cache_header_matches(
+    bintree_cache_header  *header,
+    polygons_struct       *polygons,
+    int                   max_nodes,
+    unsigned int          key[] )
+{
+    return( memcmp( header->magic, BINTREE_CACHE_MAGIC,
+                    sizeof(header->magic) ) == 0 &&
+            header->version == BINTREE_CACHE_VERSION &&
+            header->byte_order == BINTREE_CACHE_BYTE_ORDER &&
+            header->node_size == (int) sizeof(bvh_node_struct) &&
+            header->max_nodes == max_nodes &&
+            header->n_points == polygons->n_points &&
+            header->n_items == polygons->n_items &&
+            header->key[0] == key[0] && header->key[1] == key[1] &&
+            header->n_nodes >= 1 &&
+            header->n_objects == polygons->n_items );
+}
+
+/*--- the size of a cache file with the given header */
+
+static  size_t  get_cache_file_size(
+    bintree_cache_header  *header )
+{
+    return( BINTREE_CACHE_HEADER_SIZE +
+            (size_t) header->n_nodes * sizeof(bvh_node_struct) +
+            (size_t) header->n_objects * sizeof(int) );
+}
+
+/*--- checks that a file is exactly the size given by its header, leaving
+      the file position unchanged */
+
+static  BOOLEAN  cache_file_size_matches(
+    FILE                  *file,
+    bintree_cache_header  *header )
+{
+    long   position, size;
+
+    position = ftell( file );
+
+    if( position < 0 || fseek( file, 0L, SEEK_END ) != 0 )
+        return( FALSE );
+
+    size = ftell( file );
+
+    if( fseek( file, position, SEEK_SET ) != 0 )
+        return( FALSE );
+
+    return( size >= 0 && (size_t) size == get_cache_file_size( header ) );
+}
+
+static  BOOLEAN  bvh_matches_checksum(
+    bvh_struct     *bvh,
+    unsigned int   checksum[] )
+{
+    unsigned int   bvh_checksum[2];
+
+    get_bvh_checksum( bvh, bvh_checksum );
+
+    return( bvh_checksum[0] == checksum[0] && bvh_checksum[1] == checksum[1] );
+}
+
+/*--- sets the bintree to use the hierarchy read from a cache file */
+
+static  void  install_cached_bvh(
+    bvh_struct           *bvh,
+    bintree_struct_ptr   bintree )
+{
+    initialize_bintree( (Real) bvh->nodes[0].limits[X][0],
+                        (Real) bvh->nodes[0].limits[X][1],
+                        (Real) bvh->nodes[0].limits[Y][0],
+                        (Real) bvh->nodes[0].limits[Y][1],
+                        (Real) bvh->nodes[0].limits[Z][0],
+                        (Real) bvh->nodes[0].limits[Z][1], bintree );
+
+    bintree->n_nodes = bvh->n_nodes;
+    bintree->bvh = bvh;
+}
+
+#ifdef  USE_MMAP
+
+/*--- maps a cache file, using the nodes and object list in place */
+
+static  bvh_struct  *map_cache_file(
+    FILE                  *file,
+    polygons_struct       *polygons,
+    int                   max_nodes,
+    unsigned int          key[] )
+{
+    struct  stat           file_stat;
+    void                   *mapping;
+    size_t                 size;
+    bintree_cache_header   header;
+    bvh_struct             *bvh;
+
+    if( fstat( fileno( file ), &file_stat ) != 0 ||
+        file_stat.st_size < (off_t) BINTREE_CACHE_HEADER_SIZE ||
+        (off_t) (size_t) file_stat.st_size != file_stat.st_size )
+        return( NULL );
+
+    size = (size_t) file_stat.st_size;
+
+    /*--- the mapping is private, so refitting the bintree does not change
+          the file */
+
+    mapping = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                    fileno( file ), 0 );
+
+    if( mapping == MAP_FAILED )
+        return( NULL );
+
+    (void) memcpy( &header, mapping, sizeof(header) );
+
+    if( !cache_header_matches( &header, polygons, max_nodes, key ) ||
+        get_cache_file_size( &header ) != size )
+    {
+        (void) munmap( mapping, size );
+        return( NULL );
+    }
+
+    ALLOC( bvh, 1 );
+    bvh->n_nodes = header.n_nodes;
+    bvh->n_objects = header.n_objects;
+    bvh->nodes_alloc = NULL;
+    bvh->nodes = (bvh_node_struct *) (void *)
+                 ((char *) mapping + BINTREE_CACHE_HEADER_SIZE);
+    bvh->object_list = (int *) (void *) ((char *) mapping +
+                       BINTREE_CACHE_HEADER_SIZE +
+                       (size_t) header.n_nodes * sizeof(bvh_node_struct));
+    bvh->mapping = mapping;
+    bvh->mapping_size = size;
+
+    if( !bvh_matches_checksum( bvh, header.checksum ) )
+    {
+        delete_bvh( bvh );
+        return( NULL );
+    }
+
+    return( bvh );
+}
+
+#endif
+
+/*--- reads a cache file into allocated memory */
+
+static  bvh_struct  *read_cache_file(
+    FILE                  *file,
+    polygons_struct       *polygons,
+    int                   max_nodes,
+    unsigned int          key[] )
+{
+    char                   padding[BINTREE_CACHE_HEADER_SIZE];
+    size_t                 address;
+    bintree_cache_header   header;
+    bvh_struct             *bvh;
+
+    if( io_binary_data( file, READ_FILE, (void *) &header, sizeof(header),
+                        1 ) != OK ||
+        !cache_header_matches( &header, polygons, max_nodes, key ) ||
+        !cache_file_size_matches( file, &header ) ||
+        io_binary_data( file, READ_FILE, (void *) padding, 1,
+                  (int) (BINTREE_CACHE_HEADER_SIZE - sizeof(header)) ) != OK )
+        return( NULL );
+
+    ALLOC( bvh, 1 );
+    bvh->n_nodes = header.n_nodes;
+    bvh->n_objects = header.n_objects;
+    bvh->mapping = NULL;
+    bvh->mapping_size = 0;
+
+    ALLOC( bvh->nodes_alloc, (size_t) bvh->n_nodes * sizeof(bvh_node_struct) +
+                             BVH_NODE_ALIGNMENT );
+    address = (size_t) bvh->nodes_alloc;
+    address = (address + BVH_NODE_ALIGNMENT - 1) &
+              ~((size_t) BVH_NODE_ALIGNMENT - 1);
+    bvh->nodes = (bvh_node_struct *) (void *) address;
+
+    if( bvh->n_objects > 0 )
+        ALLOC( bvh->object_list, bvh->n_objects );
+    else
+        bvh->object_list = NULL;
+
+    if( io_binary_data( file, READ_FILE, (void *) bvh->nodes,
+                        sizeof(bvh_node_struct), bvh->n_nodes ) != OK ||
+        (bvh->n_objects > 0 &&
+         io_binary_data( file, READ_FILE, (void *) bvh->object_list,
+                         sizeof(int), bvh->n_objects ) != OK) )
+    {
+        delete_bvh( bvh );
+        return( NULL );
+    }
+
+    if( !bvh_matches_checksum( bvh, header.checksum ) )
+    {
+        delete_bvh( bvh );
+        return( NULL );
+    }
+
+    return( bvh );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : input_polygons_bintree_cache
+@INPUT      : polygons
+              max_nodes
+@OUTPUT     : bintree
+@RETURNS    : TRUE if the bintree was found in the cache
+@DESCRIPTION: Looks in the bintree cache directory for the bounding volume
+              hierarchy of the polygons built with max_nodes, and if there
+              is a valid one, sets up the bintree with it.  Where possible
+              the file is memory mapped, and the hierarchy used in place.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  input_polygons_bintree_cache(
+    polygons_struct      *polygons,
+    int                  max_nodes,
+    bintree_struct_ptr   bintree )
+{
+    STRING         directory, filename;
+    unsigned int   key[2];
+    FILE           *file;
+    bvh_struct     *bvh;
+
+    directory = get_bintree_cache_directory();
+
+    if( directory == NULL || polygons->n_items == 0 )
+        return( FALSE );
+
+    get_polygons_cache_key( polygons, max_nodes, key );
+    filename = get_cache_filename( directory, key );
+
+    if( !file_exists( filename ) ||
+        open_file( filename, READ_FILE, BINARY_FORMAT, &file ) != OK )
+    {
+        delete_string( filename );
+        return( FALSE );
+    }
+
+    delete_string( filename );
+
+    bvh = NULL;
+
+#ifdef  USE_MMAP
+    bvh = map_cache_file( file, polygons, max_nodes, key );
+#endif
+
+    if( bvh == NULL )
+        bvh = read_cache_file( file, polygons, max_nodes, key );
+
+    (void) close_file( file );
+
+    if( bvh == NULL )
+        return( FALSE );
+
+    if( !bvh_is_valid( bvh ) )
+    {
+        delete_bvh( bvh );
+        return( FALSE );
+    }
+
+    install_cached_bvh( bvh, bintree );
+
+    return( TRUE );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : output_polygons_bintree_cache
+@INPUT      : polygons
+              max_nodes
+              bintree
+@OUTPUT     :
+@RETURNS    : OK or ERROR
+@DESCRIPTION: Saves the bounding volume hierarchy of the polygons, built
+              with max_nodes, in the bintree cache directory.  The file is
+              written under a temporary name and then renamed, so that
+              processes sharing the cache never read a partial file.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Status  output_polygons_bintree_cache(
+    polygons_struct      *polygons,
+    int                  max_nodes,
+    bintree_struct_ptr   bintree )
+{
+    Status                 status;
+    STRING                 directory, filename, tmp_filename;
+    char                   suffix[EXTREMELY_LARGE_STRING_SIZE];
+    char                   padding[BINTREE_CACHE_HEADER_SIZE];
+    unsigned int           key[2];
+    FILE                   *file;
+    bintree_cache_header   header;
+    bvh_struct             *bvh;
+
+    directory = get_bintree_cache_directory();
+    bvh = bintree->bvh;
+
+    if( directory == NULL || bvh == NULL )
+        return( ERROR );
+
+    get_polygons_cache_key( polygons, max_nodes, key );
+    filename = get_cache_filename( directory, key );
+
+    tmp_filename = create_string( filename );
+#if HAVE_UNISTD_H
+    (void) sprintf( suffix, ".%d.tmp", (int) getpid() );
+#else
+    (void) sprintf( suffix, ".tmp" );
+#endif
+    concat_to_string( &tmp_filename, suffix );
+
+    (void) memset( (void *) &header, 0, sizeof(header) );
+    (void) memcpy( header.magic, BINTREE_CACHE_MAGIC, sizeof(header.magic) );
+    header.version = BINTREE_CACHE_VERSION;
+    header.byte_order = BINTREE_CACHE_BYTE_ORDER;
+    header.node_size = (int) sizeof(bvh_node_struct);
+    header.max_nodes = max_nodes;
+    header.n_points = polygons->n_points;
+    header.n_items = polygons->n_items;
+    header.key[0] = key[0];
+    header.key[1] = key[1];
+    header.n_nodes = bvh->n_nodes;
+    header.n_objects = bvh->n_objects;
+    get_bvh_checksum( bvh, header.checksum );
+
+    (void) memset( (void *) padding, 0, sizeof(padding) );
+
+    status = open_file( tmp_filename, WRITE_FILE, BINARY_FORMAT, &file );
+
+    if( status == OK )
+    {
+        status = io_binary_data( file, WRITE_FILE, (void *) &header,
+                                 sizeof(header), 1 );
+
+        if( status == OK )
+            status = io_binary_data( file, WRITE_FILE, (void *) padding, 1,
+                      (int) (BINTREE_CACHE_HEADER_SIZE - sizeof(header)) );
+
+        if( status == OK )
+            status = io_binary_data( file, WRITE_FILE, (void *) bvh->nodes,
+                                     sizeof(bvh_node_struct), bvh->n_nodes );
+
+        if( status == OK && bvh->n_objects > 0 )
+            status = io_binary_data( file, WRITE_FILE,
+                                     (void *) bvh->object_list,
+                                     sizeof(int), bvh->n_objects );
+
+        if( close_file( file ) != OK )
+            status = ERROR;
+
+        if( status == OK && rename( tmp_filename, filename ) != 0 )
+            status = ERROR;
+
+        if( status != OK )
+            (void) remove( tmp_filename );
+    }
+
+    delete_string( tmp_filename );
+    delete_string( filename );
+
+    return( status );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : unmap_bintree_cache_file
+@INPUT      : mapping
+              mapping_size
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Unmaps a cache file mapped by input_polygons_bintree_cache(),
+              when the bintree using it is deleted.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  unmap_bintree_cache_file(
+    void     *mapping,
+    size_t   mapping_size )
+{
+#ifdef  USE_MMAP
+    (void) munmap( mapping, mapping_size );
+#endif
+}
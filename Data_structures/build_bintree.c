@@ -70,6 +70,12 @@ static  void  recursive_efficiency_count(
     Real                  *avg_objects_visited );
 static  Real  node_visit_estimation(
     range_struct  *limits );
+static  BOOLEAN  refit_bintree_node(
+    bintree_node_struct   *node,
+    range_struct          bound_vols[],
+    range_struct          *limits );
+static  Real  get_bintree_cost(
+    bintree_struct_ptr   bintree );
 
 /* ---------------------------------------------------------- */
 
@@ -236,6 +242,8 @@ static  void  subdivide_bintree(
     terminate_progress_report( &progress );
 
     delete_leaf_queue( &leaf_queue );
+
+    bintree->n_nodes = n_nodes;
 }
 
 /* ----------------------------- MNI Header -----------------------------------
@@ -679,6 +687,13 @@ BICAPI  void  evaluate_bintree_efficiency(
     Real           n_visits_top_level;
     range_struct   limits;
 
+    if( bintree->bvh != NULL )
+    {
+        evaluate_bvh_efficiency( bintree->bvh, avg_nodes_visited,
+                                 avg_objects_visited );
+        return;
+    }
+
     *avg_nodes_visited = 0.0;
     *avg_objects_visited = 0.0;
 
@@ -755,3 +770,214 @@ static  Real  node_visit_estimation(
     return( range_surface_area(limits) );
 #endif
 }
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : refit_object_bintree
+@INPUT      : n_objects
+              bound_vols
+              bintree
+@OUTPUT     : 
+@RETURNS    : 
+@DESCRIPTION: Updates a bintree in place for new bounding volumes of the
+              same objects, such as after the vertices of a surface move,
+              keeping the tree structure.  The bintree stays valid, but
+              may become less efficient than a new one as the objects move
+              away from the positions it was built for.
+@METHOD     : The split positions of each node are moved to the extent of
+              the objects below it.
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  void  refit_object_bintree(
+    int                  n_objects,
+    range_struct         bound_vols[],
+    bintree_struct_ptr   bintree )
+{
+    int            i, c;
+    Real           size;
+    range_struct   limits;
+
+    if( bintree->bvh != NULL )
+    {
+        refit_bvh( n_objects, bound_vols, bintree );
+        return;
+    }
+
+    for_less( i, 0, n_objects )
+    {
+        for_less( c, 0, N_DIMENSIONS )
+        {
+            size = (Real) bound_vols[i].limits[c][1] -
+                   (Real) bound_vols[i].limits[c][0];
+            bound_vols[i].limits[c][0] -= (float) (size * FACTOR);
+            bound_vols[i].limits[c][1] += (float) (size * FACTOR);
+        }
+    }
+
+    if( refit_bintree_node( bintree->root, bound_vols, &limits ) )
+        bintree->range = limits;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : refit_bintree_node
+@INPUT      : node
+              bound_vols
+@OUTPUT     : limits
+@RETURNS    : FALSE if there are no objects below the node
+@DESCRIPTION: Computes the range of the objects below a node, moving the
+              split positions of its children to the range of their
+              objects.
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+static  BOOLEAN  refit_bintree_node(
+    bintree_node_struct   *node,
+    range_struct          bound_vols[],
+    range_struct          *limits )
+{
+    int                   i, c, n_objects, *object_list, axis_index;
+    BOOLEAN               found;
+    bintree_node_struct   *left_child, *right_child;
+    range_struct          child_limits;
+
+    found = FALSE;
+
+    if( bintree_node_is_leaf( node ) )
+    {
+        n_objects = get_bintree_leaf_objects( node, &object_list );
+
+        for_less( i, 0, n_objects )
+        {
+            if( !found )
+            {
+                *limits = bound_vols[object_list[i]];
+                found = TRUE;
+                continue;
+            }
+
+            for_less( c, 0, N_DIMENSIONS )
+            {
+                if( bound_vols[object_list[i]].limits[c][0] <
+                    limits->limits[c][0] )
+                    limits->limits[c][0] =
+                                   bound_vols[object_list[i]].limits[c][0];
+                if( bound_vols[object_list[i]].limits[c][1] >
+                    limits->limits[c][1] )
+                    limits->limits[c][1] =
+                                   bound_vols[object_list[i]].limits[c][1];
+            }
+        }
+
+        return( found );
+    }
+
+    axis_index = get_node_split_axis( node );
+
+    if( get_bintree_left_child( node, &left_child ) &&
+        refit_bintree_node( left_child, bound_vols, &child_limits ) )
+    {
+        left_child->split_position = child_limits.limits[axis_index][1];
+        *limits = child_limits;
+        found = TRUE;
+    }
+
+    if( get_bintree_right_child( node, &right_child ) &&
+        refit_bintree_node( right_child, bound_vols, &child_limits ) )
+    {
+        right_child->split_position = child_limits.limits[axis_index][0];
+
+        if( !found )
+            *limits = child_limits;
+        else
+        {
+            for_less( c, 0, N_DIMENSIONS )
+            {
+                if( child_limits.limits[c][0] < limits->limits[c][0] )
+                    limits->limits[c][0] = child_limits.limits[c][0];
+                if( child_limits.limits[c][1] > limits->limits[c][1] )
+                    limits->limits[c][1] = child_limits.limits[c][1];
+            }
+        }
+        found = TRUE;
+    }
+
+    return( found );
+}
+
+/*--- the estimated cost of a random ray, as the number of nodes plus the
+      number of objects it visits */
+
+static  Real  get_bintree_cost(
+    bintree_struct_ptr   bintree )
+{
+    Real   avg_nodes, avg_objects;
+
+    evaluate_bintree_efficiency( bintree, &avg_nodes, &avg_objects );
+
+    return( avg_nodes + avg_objects );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : initialize_bintree_quality
+@INPUT      : bintree
+              max_nodes
+              threshold
+@OUTPUT     : quality
+@RETURNS    : 
+@DESCRIPTION: Starts tracking the efficiency of a bintree which is refitted
+              as its objects move, recording its current estimated cost.
+              bintree_needs_rebuild() reports when the cost exceeds the
+              threshold times this initial cost.  max_nodes is kept for
+              rebuilding the bintree.
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  void  initialize_bintree_quality(
+    bintree_quality_struct  *quality,
+    bintree_struct_ptr      bintree,
+    int                     max_nodes,
+    Real                    threshold )
+{
+    quality->max_nodes = max_nodes;
+    quality->threshold = threshold;
+    quality->initial_cost = get_bintree_cost( bintree );
+    quality->cost = quality->initial_cost;
+    quality->n_refits = 0;
+    quality->n_rebuilds = 0;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : bintree_needs_rebuild
+@INPUT      : quality
+              bintree
+@OUTPUT     : quality
+@RETURNS    : TRUE if the bintree should be rebuilt
+@DESCRIPTION: Evaluates a refitted bintree, returning TRUE if its estimated
+              cost has grown past the threshold given to
+              initialize_bintree_quality().
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  bintree_needs_rebuild(
+    bintree_quality_struct  *quality,
+    bintree_struct_ptr      bintree )
+{
+    quality->cost = get_bintree_cost( bintree );
+
+    return( quality->cost > quality->threshold * quality->initial_cost );
+}
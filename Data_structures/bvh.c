@@ -0,0 +1,1959 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#include "bicpl_internal.h"
+
+/*--- cost of visiting a node, relative to testing an object */
+
+#define  BVH_NODE_VISIT_COST     0.125
+
+/*--- a node is split when it has more objects, even if the surface area
+      heuristic says it is not worth it */
+
+#define  MAX_BVH_LEAF_OBJECTS    8
+
+#define  N_BVH_BINS              16
+
+/*--- deeper nodes are made leaves, which also bounds the traversal stacks */
+
+#define  MAX_BVH_DEPTH           64
+
+#define  FACTOR                  1.0e-4
+
+/*--- the parallel build splits the top of the hierarchy into about
+      BVH_TASKS_PER_THREAD subtrees per thread, each of at least
+      MIN_BVH_TASK_OBJECTS objects, and bins the objects of the top nodes
+      in parallel when they have at least MIN_PARALLEL_BVH_BIN_OBJECTS */
+
+#define  BVH_TASKS_PER_THREAD           4
+#define  MIN_BVH_TASK_OBJECTS           1024
+#define  MIN_PARALLEL_BVH_BIN_OBJECTS   65536
+
+/*--- packets of rays are traced together while at least this many rays
+      hit the same node */
+
+#define  MIN_BVH_PACKET_RAYS            (RAY_PACKET_SIZE / 2)
+
+typedef  struct
+{
+    range_struct     *bound_vols;
+    float            *centroids;
+    int              *object_list;
+    bvh_node_struct  *nodes;
+    int              n_nodes;
+} bvh_build_struct;
+
+typedef  struct
+{
+    range_struct     limits;
+    Real             centroid_min[N_DIMENSIONS];
+    Real             centroid_max[N_DIMENSIONS];
+} bvh_bounds_struct;
+
+typedef  struct
+{
+    int              counts[N_DIMENSIONS][N_BVH_BINS];
+    range_struct     ranges[N_DIMENSIONS][N_BVH_BINS];
+} bvh_bins_struct;
+
+typedef  struct
+{
+    bvh_build_struct   *build;
+    int                start;
+    int                n_objects;
+    int                n_chunks;
+    bvh_bounds_struct  *bounds;
+    Real               *scale;
+    bvh_bins_struct    *bins;
+} bvh_chunks_struct;
+
+typedef  struct
+{
+    int              start;
+    int              n_objects;
+    int              max_nodes;
+    int              depth;
+    bvh_node_struct  *nodes;
+    int              n_nodes;
+} bvh_task_struct;
+
+typedef  struct
+{
+    range_struct     limits;
+    int              axis;      /* --- -1 if the node is a task */
+    int              left;      /* --- task index if the node is a task */
+    int              right;
+} bvh_top_node_struct;
+
+typedef  struct
+{
+    bvh_build_struct     *build;
+    int                  n_threads;
+    int                  task_objects;
+    int                  n_top_nodes;
+    bvh_top_node_struct  *top_nodes;
+    int                  n_tasks;
+    bvh_task_struct      *tasks;
+} bvh_top_build_struct;
+
+typedef  struct
+{
+    int     node;
+    Real    dist;
+} bvh_stack_entry;
+
+static  void  empty_range(
+    range_struct  *range )
+{
+    int   c;
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        range->limits[c][0] = 1.0e30f;
+        range->limits[c][1] = -1.0e30f;
+    }
+}
+
+static  void  add_to_range(
+    range_struct  *range,
+    range_struct  *bound_vol )
+{
+    int   c;
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        if( bound_vol->limits[c][0] < range->limits[c][0] )
+            range->limits[c][0] = bound_vol->limits[c][0];
+        if( bound_vol->limits[c][1] > range->limits[c][1] )
+            range->limits[c][1] = bound_vol->limits[c][1];
+    }
+}
+
+/*--- surface area of a range which may be empty */
+
+static  Real  get_range_area(
+    range_struct  *range )
+{
+    if( range->limits[X][0] > range->limits[X][1] )
+        return( 0.0 );
+
+    return( range_surface_area( range ) );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_bvh_bounds
+@INPUT      : build
+              start
+              end
+@OUTPUT     : bounds
+@RETURNS    :
+@DESCRIPTION: Computes the range of the bounding volumes and of the
+              centroids of the objects start .. end-1 of the object list.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  get_bvh_bounds(
+    bvh_build_struct   *build,
+    int                start,
+    int                end,
+    bvh_bounds_struct  *bounds )
+{
+    int     i, c, obj;
+    Real    centroid;
+
+    empty_range( &bounds->limits );
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        bounds->centroid_min[c] = 1.0e30;
+        bounds->centroid_max[c] = -1.0e30;
+    }
+
+    for_less( i, start, end )
+    {
+        obj = build->object_list[i];
+        add_to_range( &bounds->limits, &build->bound_vols[obj] );
+
+        for_less( c, 0, N_DIMENSIONS )
+        {
+            centroid = (Real) build->centroids[N_DIMENSIONS*obj+c];
+            if( centroid < bounds->centroid_min[c] )
+                bounds->centroid_min[c] = centroid;
+            if( centroid > bounds->centroid_max[c] )
+                bounds->centroid_max[c] = centroid;
+        }
+    }
+}
+
+static  void  merge_bvh_bounds(
+    bvh_bounds_struct  *bounds,
+    bvh_bounds_struct  *other )
+{
+    int     c;
+
+    add_to_range( &bounds->limits, &other->limits );
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        if( other->centroid_min[c] < bounds->centroid_min[c] )
+            bounds->centroid_min[c] = other->centroid_min[c];
+        if( other->centroid_max[c] > bounds->centroid_max[c] )
+            bounds->centroid_max[c] = other->centroid_max[c];
+    }
+}
+
+/*--- the scale converting a centroid coordinate to a bin, or 0 if all the
+      centroids have the same coordinate */
+
+static  void  get_bvh_bin_scales(
+    bvh_bounds_struct  *bounds,
+    Real               scale[] )
+{
+    int     c;
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        if( bounds->centroid_max[c] > bounds->centroid_min[c] )
+            scale[c] = (Real) N_BVH_BINS /
+                       (bounds->centroid_max[c] - bounds->centroid_min[c]);
+        else
+            scale[c] = 0.0;
+    }
+}
+
+static  int  get_bvh_bin(
+    bvh_build_struct   *build,
+    int                obj,
+    int                axis,
+    Real               centroid_min,
+    Real               scale )
+{
+    int   bin;
+
+    bin = (int) (((Real) build->centroids[N_DIMENSIONS*obj+axis] -
+                  centroid_min) * scale);
+
+    if( bin >= N_BVH_BINS )
+        bin = N_BVH_BINS - 1;
+
+    return( bin );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_bvh_bins
+@INPUT      : build
+              start
+              end
+              bounds     - centroid range of the node
+              scale
+@OUTPUT     : bins
+@RETURNS    :
+@DESCRIPTION: Counts the objects start .. end-1 falling in each centroid bin
+              along each axis, and the range of their bounding volumes.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  get_bvh_bins(
+    bvh_build_struct   *build,
+    int                start,
+    int                end,
+    bvh_bounds_struct  *bounds,
+    Real               scale[],
+    bvh_bins_struct    *bins )
+{
+    int     i, c, b, bin, obj;
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        for_less( b, 0, N_BVH_BINS )
+        {
+            bins->counts[c][b] = 0;
+            empty_range( &bins->ranges[c][b] );
+        }
+    }
+
+    for_less( i, start, end )
+    {
+        obj = build->object_list[i];
+
+        for_less( c, 0, N_DIMENSIONS )
+        {
+            if( scale[c] == 0.0 )
+                continue;
+
+            bin = get_bvh_bin( build, obj, c, bounds->centroid_min[c],
+                               scale[c] );
+            ++bins->counts[c][bin];
+            add_to_range( &bins->ranges[c][bin], &build->bound_vols[obj] );
+        }
+    }
+}
+
+static  void  merge_bvh_bins(
+    bvh_bins_struct    *bins,
+    bvh_bins_struct    *other )
+{
+    int     c, b;
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        for_less( b, 0, N_BVH_BINS )
+        {
+            bins->counts[c][b] += other->counts[c][b];
+            add_to_range( &bins->ranges[c][b], &other->ranges[c][b] );
+        }
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : choose_bvh_split
+@INPUT      : bounds
+              scale
+              bins
+              n_objects
+@OUTPUT     : axis
+              split_bin
+@RETURNS    : TRUE if splitting is cheaper than a leaf
+@DESCRIPTION: Finds the best split of the objects into two groups by the
+              surface area heuristic, evaluated at the boundaries of the
+              centroid bins along each axis.  Objects in bins up to and
+              including split_bin go left.  The axis is -1 if all the
+              centroids coincide.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  BOOLEAN  choose_bvh_split(
+    bvh_bounds_struct  *bounds,
+    Real               scale[],
+    bvh_bins_struct    *bins,
+    int                n_objects,
+    int                *axis,
+    int                *split_bin )
+{
+    int           c, b, n_left, right_counts[N_BVH_BINS];
+    Real          cost, best_cost, area, right_areas[N_BVH_BINS];
+    range_struct  sweep;
+    BOOLEAN       found;
+
+    area = get_range_area( &bounds->limits );
+    if( area <= 0.0 )
+        area = 1.0;
+    found = FALSE;
+    *axis = -1;
+    best_cost = 0.0;
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        if( scale[c] == 0.0 )
+            continue;
+
+        /*--- sweep from the right, then from the left evaluating the cost */
+
+        empty_range( &sweep );
+        n_left = 0;
+        for( b = N_BVH_BINS - 1;  b > 0;  --b )
+        {
+            add_to_range( &sweep, &bins->ranges[c][b] );
+            n_left += bins->counts[c][b];
+            right_counts[b] = n_left;
+            right_areas[b] = get_range_area( &sweep );
+        }
+
+        empty_range( &sweep );
+        n_left = 0;
+        for_less( b, 0, N_BVH_BINS - 1 )
+        {
+            add_to_range( &sweep, &bins->ranges[c][b] );
+            n_left += bins->counts[c][b];
+
+            if( n_left == 0 || right_counts[b+1] == 0 )
+                continue;
+
+            cost = BVH_NODE_VISIT_COST +
+                   (get_range_area( &sweep ) * (Real) n_left +
+                    right_areas[b+1] * (Real) right_counts[b+1]) / area;
+
+            if( !found || cost < best_cost )
+            {
+                found = TRUE;
+                best_cost = cost;
+                *axis = c;
+                *split_bin = b;
+            }
+        }
+    }
+
+    return( found && (best_cost < (Real) n_objects ||
+                      n_objects > MAX_BVH_LEAF_OBJECTS) );
+}
+
+static  void  get_bvh_bounds_chunk(
+    void   *data,
+    int    chunk,
+    int    thread )
+{
+    bvh_chunks_struct  *chunks;
+
+    chunks = (bvh_chunks_struct *) data;
+
+    get_bvh_bounds( chunks->build,
+                    chunks->start + (int) ((long) chunks->n_objects * chunk /
+                                           chunks->n_chunks),
+                    chunks->start + (int) ((long) chunks->n_objects *
+                                           (chunk+1) / chunks->n_chunks),
+                    &chunks->bounds[chunk+1] );
+}
+
+static  void  get_bvh_bins_chunk(
+    void   *data,
+    int    chunk,
+    int    thread )
+{
+    bvh_chunks_struct  *chunks;
+
+    chunks = (bvh_chunks_struct *) data;
+
+    get_bvh_bins( chunks->build,
+                  chunks->start + (int) ((long) chunks->n_objects * chunk /
+                                         chunks->n_chunks),
+                  chunks->start + (int) ((long) chunks->n_objects *
+                                         (chunk+1) / chunks->n_chunks),
+                  &chunks->bounds[0], chunks->scale, &chunks->bins[chunk+1] );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : split_bvh_objects
+@INPUT      : build
+              start         - first object in build->object_list
+              n_objects
+              max_nodes     - number of nodes this subtree may use
+              depth
+              n_threads     - threads used to bin the objects
+@OUTPUT     : limits        - range of the objects
+              axis
+              bottom        - first object of the right child
+@RETURNS    : TRUE if the node is to be split
+@DESCRIPTION: Decides whether to split a node, and if so, reorders its
+              objects so those of the left child come first.  When more
+              than one thread is given, the objects are binned in chunks
+              in parallel; the result is the same as for one thread.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  BOOLEAN  split_bvh_objects(
+    bvh_build_struct  *build,
+    int               start,
+    int               n_objects,
+    int               max_nodes,
+    int               depth,
+    int               n_threads,
+    range_struct      *limits,
+    int               *axis,
+    int               *bottom )
+{
+    int                chunk, split_bin, top, tmp;
+    Real               scale[N_DIMENSIONS];
+    bvh_bounds_struct  bounds;
+    bvh_bins_struct    bins;
+    bvh_chunks_struct  chunks;
+    BOOLEAN            split;
+
+    if( n_threads > 1 )
+    {
+        chunks.build = build;
+        chunks.start = start;
+        chunks.n_objects = n_objects;
+        chunks.n_chunks = n_threads;
+        chunks.scale = scale;
+        ALLOC( chunks.bounds, n_threads + 1 );
+        ALLOC( chunks.bins, n_threads + 1 );
+
+        do_parallel_jobs( n_threads, n_threads, get_bvh_bounds_chunk,
+                          (void *) &chunks );
+
+        chunks.bounds[0] = chunks.bounds[1];
+        for_less( chunk, 1, n_threads )
+            merge_bvh_bounds( &chunks.bounds[0], &chunks.bounds[chunk+1] );
+        bounds = chunks.bounds[0];
+    }
+    else
+        get_bvh_bounds( build, start, start + n_objects, &bounds );
+
+    *limits = bounds.limits;
+    *axis = -1;
+
+    if( n_objects <= 1 || max_nodes < 3 || depth >= MAX_BVH_DEPTH )
+        split = FALSE;
+    else
+    {
+        get_bvh_bin_scales( &bounds, scale );
+
+        if( n_threads > 1 )
+        {
+            do_parallel_jobs( n_threads, n_threads, get_bvh_bins_chunk,
+                              (void *) &chunks );
+
+            bins = chunks.bins[1];
+            for_less( chunk, 1, n_threads )
+                merge_bvh_bins( &bins, &chunks.bins[chunk+1] );
+        }
+        else
+            get_bvh_bins( build, start, start + n_objects, &bounds, scale,
+                          &bins );
+
+        split = choose_bvh_split( &bounds, scale, &bins, n_objects,
+                                  axis, &split_bin );
+
+        if( !split && *axis < 0 && n_objects > MAX_BVH_LEAF_OBJECTS )
+        {
+            /*--- coincident centroids, so split the list in half */
+
+            split = TRUE;
+            *axis = 0;
+            *bottom = start + n_objects / 2;
+        }
+        else if( split )
+        {
+            *bottom = start;
+            top = start + n_objects - 1;
+
+            while( *bottom <= top )
+            {
+                if( get_bvh_bin( build, build->object_list[*bottom], *axis,
+                                 bounds.centroid_min[*axis], scale[*axis] ) <=
+                    split_bin )
+                    ++(*bottom);
+                else
+                {
+                    tmp = build->object_list[*bottom];
+                    build->object_list[*bottom] = build->object_list[top];
+                    build->object_list[top] = tmp;
+                    --top;
+                }
+            }
+        }
+    }
+
+    if( n_threads > 1 )
+    {
+        FREE( chunks.bounds );
+        FREE( chunks.bins );
+    }
+
+    return( split );
+}
+
+/*--- the node budget is divided between the children in proportion to
+      their numbers of objects, so the total never exceeds max_nodes */
+
+static  int  get_left_max_nodes(
+    int   max_nodes,
+    int   n_left,
+    int   n_objects )
+{
+    int   left_max_nodes;
+
+    left_max_nodes = (int) ((Real) (max_nodes - 1) * (Real) n_left /
+                            (Real) n_objects);
+    if( left_max_nodes < 1 )
+        left_max_nodes = 1;
+    else if( left_max_nodes > max_nodes - 2 )
+        left_max_nodes = max_nodes - 2;
+
+    return( left_max_nodes );
+}
+
+static  void  set_bvh_node(
+    bvh_node_struct  *node,
+    range_struct     *limits,
+    int              offset,
+    int              n_objects )
+{
+    node->limits[X][0] = limits->limits[X][0];
+    node->limits[X][1] = limits->limits[X][1];
+    node->limits[Y][0] = limits->limits[Y][0];
+    node->limits[Y][1] = limits->limits[Y][1];
+    node->limits[Z][0] = limits->limits[Z][0];
+    node->limits[Z][1] = limits->limits[Z][1];
+    node->offset = offset;
+    node->n_objects = n_objects;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : build_bvh_node
+@INPUT      : build
+              node_index
+              start         - first object in build->object_list
+              n_objects
+              max_nodes     - number of nodes this subtree may use
+              depth
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Fills in the node, and recursively creates its children,
+              reordering the object list so each leaf's objects are
+              contiguous.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  build_bvh_node(
+    bvh_build_struct  *build,
+    int               node_index,
+    int               start,
+    int               n_objects,
+    int               max_nodes,
+    int               depth )
+{
+    int              axis, bottom, left_max_nodes, left_index, right_index;
+    range_struct     limits;
+
+    if( split_bvh_objects( build, start, n_objects, max_nodes, depth, 1,
+                           &limits, &axis, &bottom ) )
+    {
+        left_max_nodes = get_left_max_nodes( max_nodes, bottom - start,
+                                             n_objects );
+
+        left_index = build->n_nodes;
+        ++build->n_nodes;
+        build_bvh_node( build, left_index, start, bottom - start,
+                        left_max_nodes, depth + 1 );
+
+        right_index = build->n_nodes;
+        ++build->n_nodes;
+        build_bvh_node( build, right_index, bottom,
+                        start + n_objects - bottom,
+                        max_nodes - 1 - left_max_nodes, depth + 1 );
+
+        set_bvh_node( &build->nodes[node_index], &limits, right_index,
+                      -1 - axis );
+    }
+    else
+        set_bvh_node( &build->nodes[node_index], &limits, start, n_objects );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : build_bvh_top
+@INPUT      : top_build
+              start
+              n_objects
+              max_nodes
+              depth
+@OUTPUT     :
+@RETURNS    : index of the top node
+@DESCRIPTION: Splits the top of the hierarchy serially, as build_bvh_node()
+              would, down to subtrees of at most top_build->task_objects
+              objects, which are recorded as tasks to be built in parallel.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  int  build_bvh_top(
+    bvh_top_build_struct  *top_build,
+    int                   start,
+    int                   n_objects,
+    int                   max_nodes,
+    int                   depth )
+{
+    int                  top_index, axis, bottom, left_max_nodes, n_threads;
+    bvh_top_node_struct  top_node;
+    bvh_task_struct      task;
+
+    top_index = top_build->n_top_nodes;
+    SET_ARRAY_SIZE( top_build->top_nodes, top_index, top_index + 1,
+                    DEFAULT_CHUNK_SIZE );
+    ++top_build->n_top_nodes;
+
+    if( n_objects >= MIN_PARALLEL_BVH_BIN_OBJECTS )
+        n_threads = top_build->n_threads;
+    else
+        n_threads = 1;
+
+    if( n_objects <= top_build->task_objects ||
+        !split_bvh_objects( top_build->build, start, n_objects, max_nodes,
+                            depth, n_threads, &top_node.limits, &axis,
+                            &bottom ) )
+    {
+        task.start = start;
+        task.n_objects = n_objects;
+        task.max_nodes = max_nodes;
+        task.depth = depth;
+        task.nodes = NULL;
+        task.n_nodes = 0;
+
+        top_node.axis = -1;
+        top_node.left = top_build->n_tasks;
+        top_node.right = -1;
+
+        ADD_ELEMENT_TO_ARRAY( top_build->tasks, top_build->n_tasks,
+                              task, DEFAULT_CHUNK_SIZE );
+    }
+    else
+    {
+        left_max_nodes = get_left_max_nodes( max_nodes, bottom - start,
+                                             n_objects );
+
+        top_node.axis = axis;
+        top_node.left = build_bvh_top( top_build, start, bottom - start,
+                                       left_max_nodes, depth + 1 );
+        top_node.right = build_bvh_top( top_build, bottom,
+                                        start + n_objects - bottom,
+                                        max_nodes - 1 - left_max_nodes,
+                                        depth + 1 );
+    }
+
+    top_build->top_nodes[top_index] = top_node;
+
+    return( top_index );
+}
+
+/*--- builds the subtree of one task in its own node array */
+
+static  void  build_bvh_task(
+    void   *data,
+    int    task_index,
+    int    thread )
+{
+    int                   max_alloc;
+    bvh_top_build_struct  *top_build;
+    bvh_task_struct       *task;
+    bvh_build_struct      build;
+
+    top_build = (bvh_top_build_struct *) data;
+    task = &top_build->tasks[task_index];
+
+    max_alloc = MAX( 1, MIN( task->max_nodes, 2 * task->n_objects - 1 ) );
+
+    build = *top_build->build;
+    ALLOC( build.nodes, max_alloc );
+    build.n_nodes = 1;
+
+    build_bvh_node( &build, 0, task->start, task->n_objects,
+                    task->max_nodes, task->depth );
+
+    task->nodes = build.nodes;
+    task->n_nodes = build.n_nodes;
+}
+
+/*--- copies the top nodes and the task subtrees depth first */
+
+static  void  copy_bvh_top_nodes(
+    bvh_top_build_struct  *top_build,
+    int                   top_index,
+    bvh_node_struct       nodes[],
+    int                   *n_nodes )
+{
+    int                  i, node_index, right_index;
+    bvh_top_node_struct  *top_node;
+    bvh_task_struct      *task;
+
+    top_node = &top_build->top_nodes[top_index];
+
+    if( top_node->axis < 0 )
+    {
+        task = &top_build->tasks[top_node->left];
+
+        for_less( i, 0, task->n_nodes )
+        {
+            nodes[*n_nodes+i] = task->nodes[i];
+            if( nodes[*n_nodes+i].n_objects < 0 )
+                nodes[*n_nodes+i].offset += *n_nodes;
+        }
+
+        *n_nodes += task->n_nodes;
+    }
+    else
+    {
+        node_index = *n_nodes;
+        ++(*n_nodes);
+        copy_bvh_top_nodes( top_build, top_node->left, nodes, n_nodes );
+        right_index = *n_nodes;
+        copy_bvh_top_nodes( top_build, top_node->right, nodes, n_nodes );
+
+        set_bvh_node( &nodes[node_index], &top_node->limits, right_index,
+                      -1 - top_node->axis );
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : create_object_bvh
+@INPUT      : n_objects
+              bound_vols
+              max_nodes
+@OUTPUT     : bintree
+@RETURNS    :
+@DESCRIPTION: Creates a bounding volume hierarchy of objects specified by
+              their bounding volumes, built top down with the surface area
+              heuristic, and stores it in the bintree, where it is used by
+              the bintree search functions in place of the node tree.  At
+              most max_nodes nodes are created, as for
+              create_object_bintree().  Large hierarchies are built with
+              the default number of threads (see set_default_n_threads());
+              the result does not depend on the number of threads.
+@METHOD     : The top nodes are split serially, binning their objects in
+              parallel, until there are several subtrees per thread, which
+              are then built in parallel and copied into place.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  create_object_bvh(
+    int                  n_objects,
+    range_struct         bound_vols[],
+    bintree_struct_ptr   bintree,
+    int                  max_nodes )
+{
+    int                   i, c, t, n_nodes;
+    Real                  size;
+    bvh_struct            *bvh;
+    bvh_build_struct      build;
+    bvh_top_build_struct  top_build;
+    size_t                address;
+
+    for_less( i, 0, n_objects )
+    {
+        for_less( c, 0, N_DIMENSIONS )
+        {
+            size = (Real) bound_vols[i].limits[c][1] -
+                   (Real) bound_vols[i].limits[c][0];
+            bound_vols[i].limits[c][0] -= (float) (size * FACTOR);
+            bound_vols[i].limits[c][1] += (float) (size * FACTOR);
+        }
+    }
+
+    if( max_nodes < 1 )
+        max_nodes = 1;
+
+    ALLOC( bvh, 1 );
+    bvh->n_objects = n_objects;
+    bvh->mapping = NULL;
+    bvh->mapping_size = 0;
+
+    build.bound_vols = bound_vols;
+
+    if( n_objects > 0 )
+    {
+        ALLOC( bvh->object_list, n_objects );
+        ALLOC( build.centroids, N_DIMENSIONS * n_objects );
+    }
+    else
+    {
+        bvh->object_list = NULL;
+        build.centroids = NULL;
+    }
+
+    for_less( i, 0, n_objects )
+    {
+        bvh->object_list[i] = i;
+        for_less( c, 0, N_DIMENSIONS )
+        {
+            build.centroids[N_DIMENSIONS*i+c] = (float)
+                             (((Real) bound_vols[i].limits[c][0] +
+                               (Real) bound_vols[i].limits[c][1]) / 2.0);
+        }
+    }
+
+    build.object_list = bvh->object_list;
+    build.nodes = NULL;
+    build.n_nodes = 0;
+
+    top_build.build = &build;
+    top_build.n_threads = get_n_threads_to_use( 0,
+                                         n_objects / MIN_BVH_TASK_OBJECTS );
+    if( top_build.n_threads > 1 )
+        top_build.task_objects = MAX( MIN_BVH_TASK_OBJECTS, n_objects /
+                              (BVH_TASKS_PER_THREAD * top_build.n_threads) );
+    else
+        top_build.task_objects = n_objects;
+    top_build.n_top_nodes = 0;
+    top_build.top_nodes = NULL;
+    top_build.n_tasks = 0;
+    top_build.tasks = NULL;
+
+    (void) build_bvh_top( &top_build, 0, n_objects, max_nodes, 0 );
+
+    do_parallel_jobs( top_build.n_threads, top_build.n_tasks,
+                      build_bvh_task, (void *) &top_build );
+
+    /*--- copy the nodes to cache line aligned memory */
+
+    n_nodes = top_build.n_top_nodes - top_build.n_tasks;
+    for_less( t, 0, top_build.n_tasks )
+        n_nodes += top_build.tasks[t].n_nodes;
+
+    ALLOC( bvh->nodes_alloc, (size_t) n_nodes * sizeof(bvh_node_struct) +
+                             BVH_NODE_ALIGNMENT );
+    address = (size_t) bvh->nodes_alloc;
+    address = (address + BVH_NODE_ALIGNMENT - 1) &
+              ~((size_t) BVH_NODE_ALIGNMENT - 1);
+    bvh->nodes = (bvh_node_struct *) (void *) address;
+
+    bvh->n_nodes = 0;
+    copy_bvh_top_nodes( &top_build, 0, bvh->nodes, &bvh->n_nodes );
+
+    for_less( t, 0, top_build.n_tasks )
+        FREE( top_build.tasks[t].nodes );
+    FREE( top_build.tasks );
+    FREE( top_build.top_nodes );
+
+    if( build.centroids != NULL )
+        FREE( build.centroids );
+
+    if( n_objects == 0 )
+    {
+        for_less( c, 0, N_DIMENSIONS )
+        {
+            bvh->nodes[0].limits[c][0] = 0.0f;
+            bvh->nodes[0].limits[c][1] = 0.0f;
+        }
+    }
+
+    initialize_bintree( (Real) bvh->nodes[0].limits[X][0],
+                        (Real) bvh->nodes[0].limits[X][1],
+                        (Real) bvh->nodes[0].limits[Y][0],
+                        (Real) bvh->nodes[0].limits[Y][1],
+                        (Real) bvh->nodes[0].limits[Z][0],
+                        (Real) bvh->nodes[0].limits[Z][1], bintree );
+
+    bintree->n_nodes = bvh->n_nodes;
+    bintree->bvh = bvh;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : refit_bvh
+@INPUT      : n_objects
+              bound_vols
+              bintree
+@OUTPUT     : 
+@RETURNS    :
+@DESCRIPTION: Recomputes the node limits of the bounding volume hierarchy
+              of a bintree from new bounding volumes of the same objects,
+              keeping the tree structure, so that it stays valid after the
+              objects move.  The bounding volumes are enlarged slightly,
+              as in create_object_bvh().
+@METHOD     : The children of a node follow it in the node array, so one
+              pass from the last node to the first sees every child before
+              its parent.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  refit_bvh(
+    int                  n_objects,
+    range_struct         bound_vols[],
+    bintree_struct_ptr   bintree )
+{
+    int               i, c, n;
+    Real              size;
+    range_struct      limits;
+    bvh_struct        *bvh;
+    bvh_node_struct   *node;
+
+    bvh = bintree->bvh;
+
+    if( n_objects != bvh->n_objects )
+    {
+        handle_internal_error( "refit_bvh: number of objects changed" );
+        return;
+    }
+
+    for_less( i, 0, n_objects )
+    {
+        for_less( c, 0, N_DIMENSIONS )
+        {
+            size = (Real) bound_vols[i].limits[c][1] -
+                   (Real) bound_vols[i].limits[c][0];
+            bound_vols[i].limits[c][0] -= (float) (size * FACTOR);
+            bound_vols[i].limits[c][1] += (float) (size * FACTOR);
+        }
+    }
+
+    if( n_objects == 0 )
+        return;
+
+    for( n = bvh->n_nodes - 1;  n >= 0;  --n )
+    {
+        node = &bvh->nodes[n];
+
+        empty_range( &limits );
+
+        if( node->n_objects >= 0 )
+        {
+            for_less( i, node->offset, node->offset + node->n_objects )
+                add_to_range( &limits, &bound_vols[bvh->object_list[i]] );
+        }
+        else
+        {
+            for_less( c, 0, N_DIMENSIONS )
+            {
+                limits.limits[c][0] = MIN( bvh->nodes[n+1].limits[c][0],
+                                      bvh->nodes[node->offset].limits[c][0] );
+                limits.limits[c][1] = MAX( bvh->nodes[n+1].limits[c][1],
+                                      bvh->nodes[node->offset].limits[c][1] );
+            }
+        }
+
+        for_less( c, 0, N_DIMENSIONS )
+        {
+            node->limits[c][0] = limits.limits[c][0];
+            node->limits[c][1] = limits.limits[c][1];
+        }
+    }
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        bintree->range.limits[c][0] = bvh->nodes[0].limits[c][0];
+        bintree->range.limits[c][1] = bvh->nodes[0].limits[c][1];
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : delete_bvh
+@INPUT      : bvh
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Deletes the bounding volume hierarchy and frees the structure.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  delete_bvh(
+    bvh_struct  *bvh )
+{
+    if( bvh->mapping != NULL )
+        unmap_bintree_cache_file( bvh->mapping, bvh->mapping_size );
+    else
+    {
+        FREE( bvh->nodes_alloc );
+
+        if( bvh->object_list != NULL )
+            FREE( bvh->object_list );
+    }
+
+    FREE( bvh );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : bvh_is_valid
+@INPUT      : bvh
+@OUTPUT     :
+@RETURNS    : TRUE if the hierarchy can be searched safely
+@DESCRIPTION: Checks the structure of a bounding volume hierarchy read from
+              a file: that every child follows its parent, leaves refer to
+              the object list, the objects are in range and the depth is
+              within the traversal stacks.  The node limits are not checked.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  bvh_is_valid(
+    bvh_struct  *bvh )
+{
+    int              n, i, *depths;
+    BOOLEAN          valid;
+    bvh_node_struct  *node;
+
+    if( bvh->n_nodes < 1 || bvh->n_objects < 0 )
+        return( FALSE );
+
+    for_less( i, 0, bvh->n_objects )
+    {
+        if( bvh->object_list[i] < 0 || bvh->object_list[i] >= bvh->n_objects )
+            return( FALSE );
+    }
+
+    /*--- every node but the root must have exactly one parent */
+
+    ALLOC( depths, bvh->n_nodes );
+    depths[0] = 0;
+    for_less( n, 1, bvh->n_nodes )
+        depths[n] = -1;
+
+    valid = TRUE;
+
+    for_less( n, 0, bvh->n_nodes )
+    {
+        node = &bvh->nodes[n];
+
+        if( depths[n] < 0 )
+            valid = FALSE;
+        else if( node->n_objects >= 0 )
+        {
+            if( node->offset < 0 || node->offset > bvh->n_objects ||
+                node->n_objects > bvh->n_objects - node->offset )
+                valid = FALSE;
+        }
+        else if( node->n_objects < -N_DIMENSIONS ||
+                 depths[n] >= MAX_BVH_DEPTH ||
+                 n + 1 >= bvh->n_nodes ||
+                 node->offset <= n + 1 || node->offset >= bvh->n_nodes ||
+                 depths[n+1] >= 0 || depths[node->offset] >= 0 )
+            valid = FALSE;
+        else
+        {
+            depths[n+1] = depths[n] + 1;
+            depths[node->offset] = depths[n] + 1;
+        }
+
+        if( !valid )
+            break;
+    }
+
+    FREE( depths );
+
+    return( valid );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : evaluate_bvh_efficiency
+@INPUT      : bvh
+@OUTPUT     : avg_nodes_visited
+              avg_objects_visited
+@RETURNS    :
+@DESCRIPTION: Estimates the average number of nodes and objects visited by
+              a random ray, in the same way as evaluate_bintree_efficiency().
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  evaluate_bvh_efficiency(
+    bvh_struct   *bvh,
+    Real         *avg_nodes_visited,
+    Real         *avg_objects_visited )
+{
+    int            n;
+    Real           area, root_area;
+    range_struct   limits;
+
+    *avg_nodes_visited = 0.0;
+    *avg_objects_visited = 0.0;
+    root_area = 0.0;
+
+    for_less( n, 0, bvh->n_nodes )
+    {
+        (void) memcpy( limits.limits, bvh->nodes[n].limits,
+                       sizeof(limits.limits) );
+        area = range_surface_area( &limits );
+
+        if( n == 0 )
+            root_area = area;
+
+        *avg_nodes_visited += area;
+        if( bvh->nodes[n].n_objects > 0 )
+            *avg_objects_visited += area * (Real) bvh->nodes[n].n_objects;
+    }
+
+    if( root_area > 0.0 )
+    {
+        *avg_nodes_visited /= root_area;
+        *avg_objects_visited /= root_area;
+    }
+}
+
+/*--- squared distance from a point to a node box */
+
+static  Real  get_point_node_dist_sq(
+    Point            *point,
+    bvh_node_struct  *node )
+{
+    int      c;
+    Real     pos, dist, sum;
+
+    sum = 0.0;
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        pos = (Real) Point_coord( *point, c );
+
+        if( pos < (Real) node->limits[c][0] )
+            dist = (Real) node->limits[c][0] - pos;
+        else if( pos > (Real) node->limits[c][1] )
+            dist = pos - (Real) node->limits[c][1];
+        else
+            dist = 0.0;
+
+        sum += dist * dist;
+    }
+
+    return( sum );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : find_closest_point_in_bvh
+@INPUT      : point
+              bvh
+              object
+@OUTPUT     : obj_index
+              point_on_object
+@RETURNS    : distance
+@DESCRIPTION: Finds the closest point on the objects of a bounding volume
+              hierarchy, visiting the nearer child of each node first and
+              skipping nodes farther than the closest point found so far.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Real  find_closest_point_in_bvh(
+    Point               *point,
+    bvh_struct          *bvh,
+    object_struct       *object,
+    int                 *obj_index,
+    Point               *point_on_object )
+{
+    Real   closest_dist;
+
+    closest_dist = 1.0e60;
+
+    if( obj_index != (int *) NULL )
+        *obj_index = -1;
+
+    search_closest_point_in_bvh( point, bvh, object, &closest_dist,
+                                 obj_index, point_on_object );
+
+    return( sqrt( closest_dist ) );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : search_closest_point_in_bvh
+@INPUT      : point
+              bvh
+              object
+              closest_dist
+              obj_index
+              point_on_object
+@OUTPUT     : closest_dist
+              obj_index
+              point_on_object
+@RETURNS    : 
+@DESCRIPTION: Continues a closest point search from a known candidate, whose
+              squared distance is passed in closest_dist.  Only objects
+              strictly closer than the candidate replace it, so a good
+              candidate, such as the answer to a nearby query, prunes most
+              of the hierarchy.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  search_closest_point_in_bvh(
+    Point               *point,
+    bvh_struct          *bvh,
+    object_struct       *object,
+    Real                *closest_dist,
+    int                 *obj_index,
+    Point               *point_on_object )
+{
+    int               n_stack, node_index, near, far, i, obj;
+    Real              dist, near_dist, far_dist;
+    Point             object_point;
+    bvh_node_struct   *node;
+    bvh_stack_entry   stack[MAX_BVH_DEPTH+1];
+
+    n_stack = 0;
+    node_index = 0;
+    dist = 0.0;
+
+    for( ;; )
+    {
+        node = &bvh->nodes[node_index];
+
+        if( dist <= *closest_dist )
+        {
+            if( node->n_objects >= 0 )
+            {
+                for_less( i, node->offset, node->offset + node->n_objects )
+                {
+                    obj = bvh->object_list[i];
+                    dist = get_point_object_distance_sq( point, object, obj,
+                                                         &object_point );
+
+                    if( dist < *closest_dist )
+                    {
+                        *closest_dist = dist;
+                        *point_on_object = object_point;
+                        *obj_index = obj;
+                    }
+                }
+            }
+            else
+            {
+                near = node_index + 1;
+                far = node->offset;
+                near_dist = get_point_node_dist_sq( point, &bvh->nodes[near] );
+                far_dist = get_point_node_dist_sq( point, &bvh->nodes[far] );
+
+                if( far_dist < near_dist )
+                {
+                    near = node->offset;
+                    far = node_index + 1;
+                    dist = near_dist;
+                    near_dist = far_dist;
+                    far_dist = dist;
+                }
+
+                if( far_dist <= *closest_dist )
+                {
+                    stack[n_stack].node = far;
+                    stack[n_stack].dist = far_dist;
+                    ++n_stack;
+                }
+
+                node_index = near;
+                dist = near_dist;
+                continue;
+            }
+        }
+
+        if( n_stack == 0 )
+            break;
+
+        --n_stack;
+        node_index = stack[n_stack].node;
+        dist = stack[n_stack].dist;
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : find_closest_vertex_in_bvh
+@INPUT      : point
+              bvh
+              object
+@OUTPUT     : vertex_on_object
+@RETURNS    : distance
+@DESCRIPTION: Finds the closest vertex of the objects of a bounding volume
+              hierarchy.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Real  find_closest_vertex_in_bvh(
+    Point               *point,
+    bvh_struct          *bvh,
+    object_struct       *object,
+    int                 *vertex_on_object )
+{
+    int               n_stack, node_index, near, far, i, object_vertex;
+    Real              closest_dist, dist, near_dist, far_dist;
+    bvh_node_struct   *node;
+    bvh_stack_entry   stack[MAX_BVH_DEPTH+1];
+
+    closest_dist = 1.0e30;
+
+    n_stack = 0;
+    node_index = 0;
+    dist = 0.0;
+
+    for( ;; )
+    {
+        node = &bvh->nodes[node_index];
+
+        if( dist <= closest_dist * closest_dist )
+        {
+            if( node->n_objects >= 0 )
+            {
+                for_less( i, node->offset, node->offset + node->n_objects )
+                {
+                    dist = get_point_object_vertex_distance( point, object,
+                                    bvh->object_list[i], &object_vertex );
+
+                    if( dist < closest_dist )
+                    {
+                        closest_dist = dist;
+                        *vertex_on_object = object_vertex;
+                    }
+                }
+            }
+            else
+            {
+                near = node_index + 1;
+                far = node->offset;
+                near_dist = get_point_node_dist_sq( point, &bvh->nodes[near] );
+                far_dist = get_point_node_dist_sq( point, &bvh->nodes[far] );
+
+                if( far_dist < near_dist )
+                {
+                    near = node->offset;
+                    far = node_index + 1;
+                    dist = near_dist;
+                    near_dist = far_dist;
+                    far_dist = dist;
+                }
+
+                if( far_dist <= closest_dist * closest_dist )
+                {
+                    stack[n_stack].node = far;
+                    stack[n_stack].dist = far_dist;
+                    ++n_stack;
+                }
+
+                node_index = near;
+                dist = near_dist;
+                continue;
+            }
+        }
+
+        if( n_stack == 0 )
+            break;
+
+        --n_stack;
+        node_index = stack[n_stack].node;
+        dist = stack[n_stack].dist;
+    }
+
+    return( closest_dist );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : ray_intersects_node
+@INPUT      : origin
+              direction
+              inv_direction  - reciprocals of the nonzero direction components
+              node
+@OUTPUT     : t_min
+@RETURNS    : TRUE if the ray, for positive distances, intersects the box
+@DESCRIPTION: Slab test of a ray against a node box.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  BOOLEAN  ray_intersects_node(
+    Real             origin[],
+    Real             direction[],
+    Real             inv_direction[],
+    bvh_node_struct  *node,
+    Real             *t_min )
+{
+    int    c;
+    Real   t_near, t_far, t0, t1;
+
+    t_near = 0.0;
+    t_far = 1.0e30;
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        if( direction[c] == 0.0 )
+        {
+            if( origin[c] < (Real) node->limits[c][0] ||
+                origin[c] > (Real) node->limits[c][1] )
+                return( FALSE );
+        }
+        else
+        {
+            t0 = ((Real) node->limits[c][0] - origin[c]) * inv_direction[c];
+            t1 = ((Real) node->limits[c][1] - origin[c]) * inv_direction[c];
+
+            if( t0 > t1 )
+            {
+                if( t1 > t_near )
+                    t_near = t1;
+                if( t0 < t_far )
+                    t_far = t0;
+            }
+            else
+            {
+                if( t0 > t_near )
+                    t_near = t0;
+                if( t1 < t_far )
+                    t_far = t1;
+            }
+
+            if( t_near > t_far )
+                return( FALSE );
+        }
+    }
+
+    *t_min = t_near;
+
+    return( TRUE );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : intersect_ray_with_bvh_subtree
+@INPUT      : origin
+              direction
+              o, d, inv_d   - the ray as arrays, as for ray_intersects_node()
+              bvh
+              root          - node at which to start
+              object
+              obj_index
+              dist
+              n_intersections
+              distances
+@OUTPUT     : obj_index
+              dist
+              n_intersections
+              distances
+@RETURNS    :
+@DESCRIPTION: Adds the intersections of the ray with the objects below the
+              given node to those already found.  When only the closest
+              intersection is wanted, nearer children are visited first
+              and nodes beyond the closest intersection are skipped.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  intersect_ray_with_bvh_subtree(
+    Point               *origin,
+    Vector              *direction,
+    Real                o[],
+    Real                d[],
+    Real                inv_d[],
+    bvh_struct          *bvh,
+    int                 root,
+    object_struct       *object,
+    int                 *obj_index,
+    Real                *dist,
+    int                 *n_intersections,
+    Real                *distances[] )
+{
+    int               n_stack, node_index, near, far, i;
+    Real              t, near_t, far_t;
+    BOOLEAN           closest_only, near_hit, far_hit;
+    bvh_node_struct   *node;
+    bvh_stack_entry   stack[MAX_BVH_DEPTH+1];
+
+    closest_only = (distances == NULL && obj_index != NULL);
+
+    if( !ray_intersects_node( o, d, inv_d, &bvh->nodes[root], &t ) )
+        return;
+
+    n_stack = 0;
+    node_index = root;
+
+    for( ;; )
+    {
+        node = &bvh->nodes[node_index];
+
+        if( !closest_only || *obj_index < 0 || t <= *dist )
+        {
+            if( node->n_objects >= 0 )
+            {
+                for_less( i, node->offset, node->offset + node->n_objects )
+                {
+                    intersect_ray_object( origin, direction, object,
+                                          bvh->object_list[i], obj_index,
+                                          dist, n_intersections, distances );
+                }
+            }
+            else
+            {
+                near = node_index + 1;
+                far = node->offset;
+                near_hit = ray_intersects_node( o, d, inv_d, &bvh->nodes[near],
+                                                &near_t );
+                far_hit = ray_intersects_node( o, d, inv_d, &bvh->nodes[far],
+                                               &far_t );
+
+                if( near_hit && far_hit && far_t < near_t )
+                {
+                    near = node->offset;
+                    far = node_index + 1;
+                    t = near_t;
+                    near_t = far_t;
+                    far_t = t;
+                }
+                else if( !near_hit && far_hit )
+                {
+                    near = far;
+                    near_t = far_t;
+                    near_hit = TRUE;
+                    far_hit = FALSE;
+                }
+
+                if( far_hit )
+                {
+                    stack[n_stack].node = far;
+                    stack[n_stack].dist = far_t;
+                    ++n_stack;
+                }
+
+                if( near_hit )
+                {
+                    node_index = near;
+                    t = near_t;
+                    continue;
+                }
+            }
+        }
+
+        if( n_stack == 0 )
+            break;
+
+        --n_stack;
+        node_index = stack[n_stack].node;
+        t = stack[n_stack].dist;
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : intersect_ray_with_bvh
+@INPUT      : origin
+              direction
+              bvh
+              object
+@OUTPUT     : obj_index
+              dist
+              distances
+@RETURNS    : number of intersections
+@DESCRIPTION: Tests if the ray intersects the objects in the bounding volume
+              hierarchy, as intersect_ray_with_bintree().
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  int  intersect_ray_with_bvh(
+    Point               *origin,
+    Vector              *direction,
+    bvh_struct          *bvh,
+    object_struct       *object,
+    int                 *obj_index,
+    Real                *dist,
+    Real                *distances[] )
+{
+    int               n_intersections, c;
+    Real              o[N_DIMENSIONS], d[N_DIMENSIONS], inv_d[N_DIMENSIONS];
+
+    n_intersections = 0;
+    if( obj_index != (int *) NULL )
+        *obj_index = -1;
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        o[c] = (Real) Point_coord( *origin, c );
+        d[c] = (Real) Vector_coord( *direction, c );
+        if( d[c] != 0.0 )
+            inv_d[c] = 1.0 / d[c];
+        else
+            inv_d[c] = 0.0;
+    }
+
+    intersect_ray_with_bvh_subtree( origin, direction, o, d, inv_d, bvh, 0,
+                                    object, obj_index, dist,
+                                    &n_intersections, distances );
+
+    return( n_intersections );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : ray_packet_intersects_node
+@INPUT      : packet
+              active        - rays to test
+              closest_only
+              obj_indices
+              dists
+              node
+@OUTPUT     : hits
+              t_near        - distance at which each ray enters the box
+@RETURNS    : number of rays hitting the box
+@DESCRIPTION: Slab test of the rays of a packet against a node box, in one
+              branch-free loop over the whole packet.  When only the
+              closest intersections are wanted, a ray is not counted if it
+              has already found an intersection nearer than the box.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  int  ray_packet_intersects_node(
+    ray_packet_struct  *packet,
+    int                active[],
+    BOOLEAN            closest_only,
+    int                obj_indices[],
+    Real               dists[],
+    bvh_node_struct    *node,
+    int                hits[],
+    Real               t_near[] )
+{
+    int    r, n_hits;
+    Real   x_low, x_high, y_low, y_high, z_low, z_high;
+    Real   t0, t1, near, far;
+
+    x_low = (Real) node->limits[X][0];
+    x_high = (Real) node->limits[X][1];
+    y_low = (Real) node->limits[Y][0];
+    y_high = (Real) node->limits[Y][1];
+    z_low = (Real) node->limits[Z][0];
+    z_high = (Real) node->limits[Z][1];
+
+    for_less( r, 0, RAY_PACKET_SIZE )
+    {
+        t0 = (x_low - packet->origin[X][r]) * packet->inv_direction[X][r];
+        t1 = (x_high - packet->origin[X][r]) * packet->inv_direction[X][r];
+        near = MIN( t0, t1 );
+        far = MAX( t0, t1 );
+
+        t0 = (y_low - packet->origin[Y][r]) * packet->inv_direction[Y][r];
+        t1 = (y_high - packet->origin[Y][r]) * packet->inv_direction[Y][r];
+        near = MAX( near, MIN( t0, t1 ) );
+        far = MIN( far, MAX( t0, t1 ) );
+
+        t0 = (z_low - packet->origin[Z][r]) * packet->inv_direction[Z][r];
+        t1 = (z_high - packet->origin[Z][r]) * packet->inv_direction[Z][r];
+        near = MAX( near, MIN( t0, t1 ) );
+        far = MIN( far, MAX( t0, t1 ) );
+
+        near = MAX( near, 0.0 );
+        t_near[r] = near;
+        hits[r] = active[r] & (near <= far);
+    }
+
+    if( closest_only )
+    {
+        for_less( r, 0, RAY_PACKET_SIZE )
+            hits[r] &= (obj_indices[r] < 0) | (t_near[r] <= dists[r]);
+    }
+
+    n_hits = 0;
+    for_less( r, 0, RAY_PACKET_SIZE )
+        n_hits += hits[r];
+
+    return( n_hits );
+}
+
+/*--- traces one ray of a packet through a subtree */
+
+static  void  intersect_packet_ray_with_bvh_subtree(
+    ray_packet_struct   *packet,
+    int                 r,
+    bvh_struct          *bvh,
+    int                 root,
+    object_struct       *object,
+    int                 obj_indices[],
+    Real                dists[],
+    int                 n_intersections[],
+    Real                *distances[] )
+{
+    int    c;
+    Real   o[N_DIMENSIONS], d[N_DIMENSIONS], inv_d[N_DIMENSIONS];
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        o[c] = packet->origin[c][r];
+        d[c] = packet->direction[c][r];
+        inv_d[c] = packet->inv_direction[c][r];
+    }
+
+    intersect_ray_with_bvh_subtree( &packet->origins[r],
+                                    &packet->directions[r], o, d, inv_d,
+                                    bvh, root, object,
+                                    (obj_indices == NULL) ? NULL :
+                                                        &obj_indices[r],
+                                    &dists[r], &n_intersections[r],
+                                    (distances == NULL) ? NULL :
+                                                        &distances[r] );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : intersect_ray_packet_with_bvh
+@INPUT      : packet
+              bvh
+              object
+@OUTPUT     : obj_indices
+              dists
+              n_intersections
+              distances
+@RETURNS    :
+@DESCRIPTION: Traces a packet of rays through the bounding volume
+              hierarchy together, giving for each ray the results of
+              intersect_ray_with_bvh().  The output arrays must have
+              RAY_PACKET_SIZE entries; obj_indices may be NULL, and
+              distances is NULL or holds an array pointer for each ray of
+              the packet.
+@METHOD     : The children of a node are tested against the rays which hit
+              the node, and the child entered first by any ray is visited
+              first.  Below a node hit by fewer than MIN_BVH_PACKET_RAYS
+              rays, the rays are traced one at a time.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  intersect_ray_packet_with_bvh(
+    ray_packet_struct   *packet,
+    bvh_struct          *bvh,
+    object_struct       *object,
+    int                 obj_indices[],
+    Real                dists[],
+    int                 n_intersections[],
+    Real                *distances[] )
+{
+    int               r, i, c, n_stack, node_index, near, n_active;
+    int               children[2], n_hits[2];
+    int               active[RAY_PACKET_SIZE];
+    int               hits[2][RAY_PACKET_SIZE];
+    int               stack_nodes[MAX_BVH_DEPTH+2];
+    int               stack_hits[MAX_BVH_DEPTH+2][RAY_PACKET_SIZE];
+    Real              t_near[2][RAY_PACKET_SIZE], min_t[2];
+    Real              stack_t[MAX_BVH_DEPTH+2][RAY_PACKET_SIZE];
+    BOOLEAN           closest_only;
+    bvh_node_struct   *node;
+
+    closest_only = (distances == NULL && obj_indices != NULL);
+
+    for_less( r, 0, RAY_PACKET_SIZE )
+    {
+        n_intersections[r] = 0;
+        dists[r] = 0.0;
+        if( obj_indices != NULL )
+            obj_indices[r] = -1;
+        active[r] = (r < packet->n_rays);
+    }
+
+    if( ray_packet_intersects_node( packet, active, closest_only,
+                                    obj_indices, dists, &bvh->nodes[0],
+                                    stack_hits[0], stack_t[0] ) == 0 )
+        return;
+
+    stack_nodes[0] = 0;
+    n_stack = 1;
+
+    while( n_stack > 0 )
+    {
+        --n_stack;
+        node_index = stack_nodes[n_stack];
+        node = &bvh->nodes[node_index];
+
+        /*--- drop the rays which have found a nearer intersection since
+              the node was pushed */
+
+        n_active = 0;
+        for_less( r, 0, RAY_PACKET_SIZE )
+        {
+            active[r] = stack_hits[n_stack][r];
+            if( closest_only )
+                active[r] &= (obj_indices[r] < 0) |
+                             (stack_t[n_stack][r] <= dists[r]);
+            n_active += active[r];
+        }
+
+        if( n_active == 0 )
+            continue;
+
+        /*--- once the rays have diverged, trace the rest one at a time */
+
+        if( n_active < MIN_BVH_PACKET_RAYS )
+        {
+            for_less( r, 0, packet->n_rays )
+            {
+                if( active[r] )
+                    intersect_packet_ray_with_bvh_subtree( packet, r, bvh,
+                                   node_index, object, obj_indices, dists,
+                                   n_intersections, distances );
+            }
+            continue;
+        }
+
+        if( node->n_objects >= 0 )
+        {
+            for_less( i, node->offset, node->offset + node->n_objects )
+            {
+                intersect_ray_packet_object( packet, active, object,
+                                             bvh->object_list[i], obj_indices,
+                                             dists, n_intersections,
+                                             distances );
+            }
+            continue;
+        }
+
+        children[0] = node_index + 1;
+        children[1] = node->offset;
+
+        for_less( c, 0, 2 )
+        {
+            n_hits[c] = ray_packet_intersects_node( packet, active,
+                                 closest_only, obj_indices, dists,
+                                 &bvh->nodes[children[c]], hits[c],
+                                 t_near[c] );
+
+            min_t[c] = 1.0e30;
+            for_less( r, 0, RAY_PACKET_SIZE )
+            {
+                if( hits[c][r] && t_near[c][r] < min_t[c] )
+                    min_t[c] = t_near[c][r];
+            }
+        }
+
+        /*--- push the farther child first, so the nearer is visited first */
+
+        near = (min_t[1] < min_t[0]) ? 1 : 0;
+
+        for_less( c, 0, 2 )
+        {
+            i = (c == 0) ? 1 - near : near;
+
+            if( n_hits[i] > 0 )
+            {
+                stack_nodes[n_stack] = children[i];
+                (void) memcpy( stack_hits[n_stack], hits[i],
+                               sizeof(stack_hits[n_stack]) );
+                (void) memcpy( stack_t[n_stack], t_near[i],
+                               sizeof(stack_t[n_stack]) );
+                ++n_stack;
+            }
+        }
+    }
+}
@@ -89,9 +89,50 @@ BICAPI  bintree_struct_ptr allocate_bintree( void )
 
     ALLOC( bintree, 1 );
 
+    bintree->n_nodes = 0;
+    bintree->root = (bintree_node_struct *) NULL;
+    bintree->bvh = (bvh_struct *) NULL;
+
     return( bintree );
 }
 
+static  BOOLEAN  polygons_bvh = TRUE;
+static  BOOLEAN  polygons_bvh_initialized = FALSE;
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : set_polygons_bvh_flag
+@INPUT      : value
+@OUTPUT     : 
+@RETURNS    : 
+@DESCRIPTION: Sets whether create_polygons_bintree() builds a bounding
+              volume hierarchy, rather than the original bintree.  The
+              default is TRUE, unless the environment variable
+              NO_POLYGONS_BVH is set.
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  void  set_polygons_bvh_flag(
+    BOOLEAN  value )
+{
+    polygons_bvh = value;
+    polygons_bvh_initialized = TRUE;
+}
+
+BICAPI  BOOLEAN  get_polygons_bvh_flag( void )
+{
+    if( !polygons_bvh_initialized )
+    {
+        polygons_bvh_initialized = TRUE;
+        polygons_bvh = getenv( "NO_POLYGONS_BVH" ) == NULL;
+    }
+
+    return( polygons_bvh );
+}
+
 /* ----------------------------- MNI Header -----------------------------------
 @NAME       : create_lines_bintree
 @INPUT      : lines
@@ -163,6 +204,69 @@ BICAPI  void  create_lines_bintree(
     FREE( bound_vols );
 }
 
+/*--- the ranges of the polygons, from which their bintree is built */
+
+static  void  get_polygons_bound_vols(
+    polygons_struct   *polygons,
+    range_struct      bound_vols[] )
+{
+    int              poly, size;
+    Point            min_range, max_range;
+    Point            points[MAX_POINTS_PER_POLYGON];
+
+    for_less( poly, 0, polygons->n_items )
+    {
+        size = get_polygon_points( polygons, poly, points );
+
+        get_range_points( size, points, &min_range, &max_range );
+        bound_vols[poly].limits[X][0] = Point_x(min_range);
+        bound_vols[poly].limits[Y][0] = Point_y(min_range);
+        bound_vols[poly].limits[Z][0] = Point_z(min_range);
+        bound_vols[poly].limits[X][1] = Point_x(max_range);
+        bound_vols[poly].limits[Y][1] = Point_y(max_range);
+        bound_vols[poly].limits[Z][1] = Point_z(max_range);
+    }
+}
+
+/*--- builds the bintree of the polygons, going through the bintree cache
+      only if use_cache is TRUE */
+
+static  void  build_polygons_bintree(
+    polygons_struct   *polygons,
+    int               max_nodes,
+    BOOLEAN           use_cache )
+{
+    range_struct     *bound_vols;
+
+    check_install_bintree_delete_function();
+
+    polygons->bintree = allocate_bintree();
+
+    if( use_cache && get_polygons_bvh_flag() &&
+        input_polygons_bintree_cache( polygons, max_nodes,
+                                      polygons->bintree ) )
+        return;
+
+    ALLOC( bound_vols, polygons->n_items );
+
+    get_polygons_bound_vols( polygons, bound_vols );
+
+    if( get_polygons_bvh_flag() )
+    {
+        create_object_bvh( polygons->n_items, bound_vols,
+                           polygons->bintree, max_nodes );
+
+        if( use_cache && get_bintree_cache_directory() != NULL )
+            (void) output_polygons_bintree_cache( polygons, max_nodes,
+                                                  polygons->bintree );
+    }
+    else
+        create_object_bintree( polygons->n_items, bound_vols,
+                               polygons->bintree, max_nodes );
+
+    FREE( bound_vols );
+}
+
 /* ----------------------------- MNI Header -----------------------------------
 @NAME       : create_polygons_bintree
 @INPUT      : polygons
@@ -170,7 +274,12 @@ BICAPI  void  create_lines_bintree(
 @OUTPUT     : 
 @RETURNS    : 
 @DESCRIPTION: Creates a bintree for the polygons, storing it in
-              polygons->bintree.
+              polygons->bintree.  Unless turned off with
+              set_polygons_bvh_flag(), the bintree holds a bounding volume
+              hierarchy, which is searched faster.  If a bintree cache
+              directory is set, the hierarchy is read from the cache when
+              it has been built before for the same polygons, and saved in
+              the cache otherwise.
 @METHOD     : 
 @GLOBALS    : 
 @CALLS      : 
@@ -182,36 +291,88 @@ BICAPI  void  create_polygons_bintree(
     polygons_struct   *polygons,
     int               max_nodes )
 {
-    int              poly, size;
-    range_struct     *bound_vols;
-    Point            min_range, max_range;
-    Point            points[MAX_POINTS_PER_POLYGON];
+    build_polygons_bintree( polygons, max_nodes, TRUE );
+}
 
-    check_install_bintree_delete_function();
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : refit_polygons_bintree
+@INPUT      : polygons
+@OUTPUT     : 
+@RETURNS    : 
+@DESCRIPTION: Updates the bintree of the polygons after their points have
+              moved, without changing the tree structure.  The topology of
+              the polygons must be the one the bintree was built for.
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
 
-    polygons->bintree = allocate_bintree();
+BICAPI  void  refit_polygons_bintree(
+    polygons_struct   *polygons )
+{
+    range_struct     *bound_vols;
 
-    ALLOC( bound_vols, polygons->n_items );
+    if( polygons->bintree == NULL || polygons->n_items == 0 )
+        return;
 
-    for_less( poly, 0, polygons->n_items )
-    {
-        size = get_polygon_points( polygons, poly, points );
+    ALLOC( bound_vols, polygons->n_items );
 
-        get_range_points( size, points, &min_range, &max_range );
-        bound_vols[poly].limits[X][0] = Point_x(min_range);
-        bound_vols[poly].limits[Y][0] = Point_y(min_range);
-        bound_vols[poly].limits[Z][0] = Point_z(min_range);
-        bound_vols[poly].limits[X][1] = Point_x(max_range);
-        bound_vols[poly].limits[Y][1] = Point_y(max_range);
-        bound_vols[poly].limits[Z][1] = Point_z(max_range);
-    }
+    get_polygons_bound_vols( polygons, bound_vols );
 
-    create_object_bintree( polygons->n_items, bound_vols,
-                           polygons->bintree, max_nodes );
+    refit_object_bintree( polygons->n_items, bound_vols, polygons->bintree );
 
     FREE( bound_vols );
 }
 
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : update_polygons_bintree
+@INPUT      : polygons
+              quality
+@OUTPUT     : quality
+@RETURNS    : TRUE if the bintree was rebuilt
+@DESCRIPTION: Brings the bintree of deforming polygons up to date, refitting
+              it, and rebuilding it only when bintree_needs_rebuild() finds
+              that refitting has made it too inefficient.  The quality must
+              have been initialized with initialize_bintree_quality() when
+              the bintree was created.  Rebuilds do not use the bintree
+              cache.
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  update_polygons_bintree(
+    polygons_struct          *polygons,
+    bintree_quality_struct   *quality )
+{
+    if( polygons->bintree == NULL )
+        return( FALSE );
+
+    refit_polygons_bintree( polygons );
+    ++quality->n_refits;
+
+    if( !bintree_needs_rebuild( quality, polygons->bintree ) )
+        return( FALSE );
+
+    /*--- the points keep moving, so the rebuilt bintree is not worth
+          caching */
+
+    delete_the_bintree( &polygons->bintree );
+    build_polygons_bintree( polygons, quality->max_nodes, FALSE );
+
+    /*--- the rebuilt bintree is the new reference */
+
+    (void) bintree_needs_rebuild( quality, polygons->bintree );
+    quality->initial_cost = quality->cost;
+    ++quality->n_rebuilds;
+
+    return( TRUE );
+}
+
 /* ----------------------------- MNI Header -----------------------------------
 @NAME       : create_quadmesh_bintree
 @INPUT      : quadmesh
@@ -56,6 +56,10 @@ BICAPI  Real  find_closest_point_in_bintree(
 {
     Real      dist;
 
+    if( bintree->bvh != NULL )
+        return( find_closest_point_in_bvh( point, bintree->bvh, object,
+                                           obj_index, point_on_object ) );
+
     dist = 1.0e60;
 
     if( obj_index != (int *) NULL )
@@ -246,6 +250,10 @@ BICAPI  Real  find_closest_vertex_in_bintree(
 {
     Real      dist;
 
+    if( bintree->bvh != NULL )
+        return( find_closest_vertex_in_bvh( point, bintree->bvh, object,
+                                            vertex_on_object ) );
+
     dist = 1.0e30;
 
     recursive_find_closest_vertex( point, bintree->root, &bintree->range,
@@ -357,3 +365,234 @@ static  void  recursive_find_closest_vertex(
         }
     }
 }
+
+/*--- queries are answered in blocks of consecutive queries along the
+      space filling curve, each block being one parallel job, so the
+      results do not depend on the number of threads */
+
+#define  CLOSEST_POINTS_BLOCK_SIZE   256
+
+#define  MORTON_BITS                 10
+
+typedef  struct
+{
+    unsigned int  key;
+    int           index;
+} query_order_struct;
+
+typedef  struct
+{
+    Point               *points;
+    bintree_struct_ptr  bintree;
+    object_struct       *object;
+    query_order_struct  *order;
+    int                 n_points;
+    int                 *obj_indices;
+    Point               *points_on_object;
+    Real                *dists;
+} closest_points_struct;
+
+/*--- interleaves the lower MORTON_BITS bits of x with two zero bits */
+
+static  unsigned int  spread_morton_bits(
+    unsigned int  x )
+{
+    x &= 0x3ff;
+    x = (x | (x << 16)) & 0x030000ff;
+    x = (x | (x << 8)) & 0x0300f00f;
+    x = (x | (x << 4)) & 0x030c30c3;
+    x = (x | (x << 2)) & 0x09249249;
+
+    return( x );
+}
+
+/*--- position of a point along the Morton curve through the bintree range,
+      points outside the range being clamped to it */
+
+static  unsigned int  get_point_morton_key(
+    Point         *point,
+    range_struct  *range )
+{
+    int            c, max_cell;
+    Real           pos, width;
+    unsigned int   key, cell;
+
+    max_cell = (1 << MORTON_BITS) - 1;
+    key = 0;
+
+    for_less( c, 0, N_DIMENSIONS )
+    {
+        width = (Real) range->limits[c][1] - (Real) range->limits[c][0];
+
+        if( width <= 0.0 )
+            cell = 0;
+        else
+        {
+            pos = ((Real) Point_coord(*point,c) - (Real) range->limits[c][0]) /
+                  width * (Real) (max_cell + 1);
+
+            if( pos <= 0.0 )
+                cell = 0;
+            else if( pos >= (Real) max_cell )
+                cell = (unsigned int) max_cell;
+            else
+                cell = (unsigned int) pos;
+        }
+
+        key |= spread_morton_bits( cell ) << c;
+    }
+
+    return( key );
+}
+
+static  int  compare_query_order(
+    const void  *ptr1,
+    const void  *ptr2 )
+{
+    const query_order_struct  *q1, *q2;
+
+    q1 = (const query_order_struct *) ptr1;
+    q2 = (const query_order_struct *) ptr2;
+
+    if( q1->key < q2->key )
+        return( -1 );
+    else if( q1->key > q2->key )
+        return( 1 );
+    else if( q1->index < q2->index )
+        return( -1 );
+    else if( q1->index > q2->index )
+        return( 1 );
+    else
+        return( 0 );
+}
+
+/*--- answers one block of sorted queries, starting each search from the
+      object found by the previous query of the block */
+
+static  void  find_closest_points_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    closest_points_struct  *queries;
+    int                    q, end, p, prev_obj, obj_index;
+    Real                   dist;
+    Point                  *point, point_on_object;
+
+    queries = (closest_points_struct *) data;
+
+    end = MIN( queries->n_points, (block + 1) * CLOSEST_POINTS_BLOCK_SIZE );
+    prev_obj = -1;
+
+    for_less( q, block * CLOSEST_POINTS_BLOCK_SIZE, end )
+    {
+        p = queries->order[q].index;
+        point = &queries->points[p];
+
+        if( prev_obj >= 0 )
+        {
+            obj_index = prev_obj;
+            dist = get_point_object_distance_sq( point, queries->object,
+                                                 obj_index, &point_on_object );
+        }
+        else
+        {
+            obj_index = -1;
+            dist = 1.0e60;
+        }
+
+        if( queries->bintree->bvh != NULL )
+        {
+            search_closest_point_in_bvh( point, queries->bintree->bvh,
+                                         queries->object, &dist,
+                                         &obj_index, &point_on_object );
+        }
+        else
+        {
+            recursive_find_closest_point( point, queries->bintree->root,
+                                          &queries->bintree->range,
+                                          queries->object, &obj_index,
+                                          &dist, &point_on_object );
+        }
+
+        queries->obj_indices[p] = obj_index;
+        queries->points_on_object[p] = point_on_object;
+
+        if( queries->dists != NULL )
+            queries->dists[p] = sqrt( dist );
+
+        prev_obj = obj_index;
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : find_closest_points_in_bintree
+@INPUT      : n_points
+              points
+              bintree
+              object
+              n_threads     - 0 for the default number of threads
+@OUTPUT     : obj_indices
+              points_on_object
+              dists         - may be NULL
+@RETURNS    : 
+@DESCRIPTION: Finds the closest point in a set of objects with an associated
+              bintree for each of an array of points, giving the same
+              distances as calling find_closest_point_in_bintree() on each.
+              Where two objects are equally close, the index returned may
+              differ from the single query.
+@METHOD     : The queries are sorted along a Morton curve through the
+              bintree range, so consecutive queries visit the same nodes,
+              and are answered in blocks on several threads.  Within a
+              block, the distance to the object found by the previous
+              query bounds the search of the next one.
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  void  find_closest_points_in_bintree(
+    int                 n_points,
+    Point               points[],
+    bintree_struct_ptr  bintree,
+    object_struct       *object,
+    int                 n_threads,
+    int                 obj_indices[],
+    Point               points_on_object[],
+    Real                dists[] )
+{
+    int                    p, n_blocks;
+    closest_points_struct  queries;
+
+    if( n_points <= 0 )
+        return;
+
+    ALLOC( queries.order, n_points );
+
+    for_less( p, 0, n_points )
+    {
+        queries.order[p].key = get_point_morton_key( &points[p],
+                                                     &bintree->range );
+        queries.order[p].index = p;
+    }
+
+    qsort( (void *) queries.order, (size_t) n_points,
+           sizeof( queries.order[0] ), compare_query_order );
+
+    queries.points = points;
+    queries.bintree = bintree;
+    queries.object = object;
+    queries.n_points = n_points;
+    queries.obj_indices = obj_indices;
+    queries.points_on_object = points_on_object;
+    queries.dists = dists;
+
+    n_blocks = (n_points + CLOSEST_POINTS_BLOCK_SIZE - 1) /
+               CLOSEST_POINTS_BLOCK_SIZE;
+
+    do_parallel_jobs( n_threads, n_blocks, find_closest_points_block,
+                      (void *) &queries );
+
+    FREE( queries.order );
+}
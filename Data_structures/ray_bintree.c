@@ -83,6 +83,10 @@ BICAPI  int  intersect_ray_with_bintree(
     int       n_intersections;
     Real      t_min, t_max;
 
+    if( bintree->bvh != NULL )
+        return( intersect_ray_with_bvh( origin, direction, bintree->bvh,
+                                        object, obj_index, dist, distances ) );
+
     n_intersections = 0;
     if( obj_index != (int *) NULL )
         *obj_index = -1;
@@ -98,6 +102,115 @@ BICAPI  int  intersect_ray_with_bintree(
     return( n_intersections );
 }
 
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : intersect_rays_with_bintree
+@INPUT      : n_rays
+              origins
+              directions
+              bintree
+              object
+@OUTPUT     : obj_indices
+              dists
+              n_intersections
+              distances
+@RETURNS    : 
+@DESCRIPTION: Tests many rays against the objects in the bintree, giving for
+              each ray the results of intersect_ray_with_bintree(): the
+              number of intersections, and, if obj_indices is not NULL, the
+              closest object index (-1 if none) and distance (0 if none).
+              If distances is not NULL, it holds one array pointer per ray,
+              which receives all the intersection distances of that ray.
+              Rays which are close together and nearly parallel, such as
+              rays along the normals of neighbouring vertices, should be
+              passed consecutively.
+@METHOD     : For bounding volume hierarchies, the rays are traced in
+              packets of RAY_PACKET_SIZE, sharing the node visits and
+              testing each triangle against the whole packet at once.
+              Otherwise the rays are traced one at a time.
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  void  intersect_rays_with_bintree(
+    int                 n_rays,
+    Point               origins[],
+    Vector              directions[],
+    bintree_struct_ptr  bintree,
+    object_struct       *object,
+    int                 obj_indices[],
+    Real                dists[],
+    int                 n_intersections[],
+    Real                *distances[] )
+{
+    int                first, r, c, src;
+    int                packet_obj_indices[RAY_PACKET_SIZE];
+    int                packet_n_intersections[RAY_PACKET_SIZE];
+    Real               packet_dists[RAY_PACKET_SIZE];
+    ray_packet_struct  packet;
+
+    for( first = 0;  first < n_rays;  first += RAY_PACKET_SIZE )
+    {
+        packet.n_rays = MIN( RAY_PACKET_SIZE, n_rays - first );
+
+        if( bintree->bvh == NULL )
+        {
+            for_less( r, first, first + packet.n_rays )
+            {
+                if( dists != NULL )
+                    dists[r] = 0.0;
+
+                n_intersections[r] = intersect_ray_with_bintree(
+                          &origins[r], &directions[r], bintree, object,
+                          (obj_indices == NULL) ? NULL : &obj_indices[r],
+                          (dists == NULL) ? NULL : &dists[r],
+                          (distances == NULL) ? NULL : &distances[r] );
+            }
+            continue;
+        }
+
+        packet.origins = &origins[first];
+        packet.directions = &directions[first];
+
+        /*--- the unused rays of a packet repeat the first ray */
+
+        for_less( r, 0, RAY_PACKET_SIZE )
+        {
+            src = (r < packet.n_rays) ? first + r : first;
+
+            for_less( c, 0, N_DIMENSIONS )
+            {
+                packet.origin[c][r] = (Real) Point_coord( origins[src], c );
+                packet.direction[c][r] =
+                                 (Real) Vector_coord( directions[src], c );
+                if( packet.direction[c][r] != 0.0 )
+                    packet.inv_direction[c][r] = 1.0 / packet.direction[c][r];
+                else
+                    packet.inv_direction[c][r] = RAY_PACKET_INFINITY;
+            }
+        }
+
+        intersect_ray_packet_with_bvh( &packet, bintree->bvh, object,
+                          (obj_indices == NULL) ? NULL : packet_obj_indices,
+                          packet_dists, packet_n_intersections,
+                          (distances == NULL) ? NULL : &distances[first] );
+
+        for_less( r, 0, packet.n_rays )
+        {
+            n_intersections[first+r] = packet_n_intersections[r];
+
+            if( obj_indices != NULL )
+                obj_indices[first+r] = packet_obj_indices[r];
+
+            /*--- rays which miss get a distance of 0 */
+
+            if( dists != NULL )
+                dists[first+r] = packet_dists[r];
+        }
+    }
+}
+
 /* ----------------------------- MNI Header -----------------------------------
 @NAME       : recursive_intersect_ray
 @INPUT      : origin
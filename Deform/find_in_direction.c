@@ -2,6 +2,7 @@
 #include "bicpl/deform.h"
 
 static  BOOLEAN  voxel_might_contain_boundary(
+    voxel_coef_struct           *lookup,
     Volume                      volume,
     bitlist_3d_struct           *done_bits,
     bitlist_3d_struct           *surface_bits,
@@ -255,6 +256,136 @@ static  void  set_up_to_search_ray(
     }
 }
 
+/*--- if the pyramid shows that the current voxel lies in a block of voxels
+      none of which can contain the boundary, advances the ray to the last
+      crossing before it leaves the voxels whose neighbourhoods lie in the
+      block, and returns TRUE.  The crossings are advanced by the same
+      additions as single steps, so the ray is left exactly as stepping
+      would leave it, but without testing the voxels in between.  As with
+      the test of single voxels, this is only done when done_bits is
+      given. */
+
+static  BOOLEAN  skip_empty_pyramid_block(
+    voxel_coef_struct           *lookup,
+    bitlist_3d_struct           *done_bits,
+    int                         degrees_continuity,
+    boundary_definition_struct  *boundary_def,
+    int                         voxel_index[N_DIMENSIONS],
+    int                         delta_voxel[N_DIMENSIONS],
+    Real                        next_distance[N_DIMENSIONS],
+    Real                        delta_distance[N_DIMENSIONS],
+    Real                        *next_closest )
+{
+    minmax_pyramid_struct  *pyramid;
+    int                    dim, level, block_voxels, n_steps, step;
+    int                    b[N_DIMENSIONS], low[N_DIMENSIONS];
+    int                    high[N_DIMENSIONS];
+    size_t                 block;
+    BOOLEAN                found_exit;
+    Real                   exit_distance, dist;
+
+    if( lookup == NULL || lookup->minmax_pyramid == NULL ||
+        done_bits == NULL || degrees_continuity < 0 ||
+        (lookup->spline_coefs != NULL && degrees_continuity == 2) )
+        return( FALSE );
+
+    pyramid = lookup->minmax_pyramid;
+
+    /*--- find the coarsest block containing the voxels read for the
+          current voxel whose range misses the boundary.  Block edges of a
+          level are also block edges of the finer levels, so once the
+          voxels straddle an edge, no finer block can contain them. */
+
+    for( level = pyramid->n_levels - 1;  level >= 0;  --level )
+    {
+        block_voxels = pyramid->block_size << level;
+
+        for_less( dim, 0, N_DIMENSIONS )
+        {
+            if( voxel_index[dim] < 0 )
+                return( FALSE );
+
+            b[dim] = voxel_index[dim] / block_voxels;
+
+            if( b[dim] >= pyramid->n_blocks[level][dim] ||
+                voxel_index[dim] + degrees_continuity + 1 >
+                (b[dim] + 1) * block_voxels )
+                return( FALSE );
+        }
+
+        block = ((size_t) b[X] * (size_t) pyramid->n_blocks[level][Y] +
+                 (size_t) b[Y]) * (size_t) pyramid->n_blocks[level][Z] +
+                (size_t) b[Z];
+
+        if( pyramid->max_values[level][block] < boundary_def->min_isovalue ||
+            pyramid->min_values[level][block] > boundary_def->max_isovalue )
+            break;
+    }
+
+    if( level < 0 )
+        return( FALSE );
+
+    /*--- the voxels whose neighbourhoods lie in the block */
+
+    for_less( dim, 0, N_DIMENSIONS )
+    {
+        low[dim] = b[dim] * block_voxels;
+        high[dim] = (b[dim] + 1) * block_voxels - degrees_continuity - 1;
+    }
+
+    /*--- find the distance of the crossing that leaves them */
+
+    found_exit = FALSE;
+    exit_distance = 0.0;
+
+    for_less( dim, 0, N_DIMENSIONS )
+    {
+        if( delta_distance[dim] == 0.0 )
+            continue;
+
+        if( delta_voxel[dim] > 0 )
+            n_steps = high[dim] - voxel_index[dim] + 1;
+        else
+            n_steps = voxel_index[dim] - low[dim] + 1;
+
+        dist = next_distance[dim];
+        for_less( step, 1, n_steps )
+            dist += delta_distance[dim];
+
+        if( !found_exit || dist < exit_distance )
+        {
+            exit_distance = dist;
+            found_exit = TRUE;
+        }
+    }
+
+    if( !found_exit )
+        return( FALSE );
+
+    /*--- advance the crossings before it, leaving the ray at the last voxel
+          in the block, about to step to the exit distance */
+
+    for_less( dim, 0, N_DIMENSIONS )
+    {
+        if( delta_distance[dim] == 0.0 )
+            continue;
+
+        while( next_distance[dim] < exit_distance )
+        {
+            voxel_index[dim] += delta_voxel[dim];
+            next_distance[dim] += delta_distance[dim];
+        }
+    }
+
+    *next_closest = next_distance[X];
+    if( next_distance[Y] < *next_closest )
+        *next_closest = next_distance[Y];
+    if( next_distance[Z] < *next_closest )
+        *next_closest = next_distance[Z];
+
+    return( TRUE );
+}
+
 #ifdef DEBUGGING
 static  int  count = 0;
 #endif
@@ -390,7 +521,8 @@ BICAPI  BOOLEAN  find_boundary_in_direction(
         fill_Vector( world_direction, vx, vy, vz );
         NORMALIZE_VECTOR( world_direction, world_direction );
         GET_RAY_POINT( point, origin0, direction0, current_distance0 );
-        inside_surface0 = is_point_inside_surface( volume, label_volume,
+        inside_surface0 = is_point_inside_surface_with_lookup( lookup,
+                                                   volume, label_volume,
                                                    degrees_continuity,
                                                    point, &world_direction,
                                                    boundary_def );
@@ -403,7 +535,8 @@ BICAPI  BOOLEAN  find_boundary_in_direction(
 
         GET_RAY_POINT( point, origin1, direction1, current_distance1 );
 
-        inside_surface1 = is_point_inside_surface( volume, label_volume,
+        inside_surface1 = is_point_inside_surface_with_lookup( lookup,
+                                                   volume, label_volume,
                                                    degrees_continuity,
                                                    point, &world_direction,
                                                    boundary_def );
@@ -425,7 +558,13 @@ BICAPI  BOOLEAN  find_boundary_in_direction(
             if( stop_distance0 < max_dist )
                 max_dist = stop_distance0;
 
-            if( voxel_might_contain_boundary( volume, done_bits, surface_bits,
+            if( !skip_empty_pyramid_block( lookup, done_bits,
+                                           degrees_continuity, boundary_def,
+                                           voxel_index0, delta_voxel0,
+                                           next_distance0, delta_distance0,
+                                           &next_closest0 ) &&
+                voxel_might_contain_boundary( lookup, volume, done_bits,
+                                              surface_bits,
                                               degrees_continuity, voxel_index0,
                                               boundary_def ) &&
                 (isovalue &&
@@ -507,7 +646,13 @@ BICAPI  BOOLEAN  find_boundary_in_direction(
             if( stop_distance1 < max_dist )
                 max_dist = stop_distance1;
 
-            if( voxel_might_contain_boundary( volume, done_bits, surface_bits,
+            if( !skip_empty_pyramid_block( lookup, done_bits,
+                                           degrees_continuity, boundary_def,
+                                           voxel_index1, delta_voxel1,
+                                           next_distance1, delta_distance1,
+                                           &next_closest1 ) &&
+                voxel_might_contain_boundary( lookup, volume, done_bits,
+                                              surface_bits,
                                               degrees_continuity, voxel_index1,
                                               boundary_def ) &&
                 (isovalue &&
@@ -665,10 +810,10 @@ static  BOOLEAN  check_voxel_for_isovalue(
     BOOLEAN         found;
     int             i;
     Real            value, dot_prod, voxel[N_DIMENSIONS];
-    Real            first_deriv[N_DIMENSIONS], *first_deriv_ptr[1];
+    Real            first_deriv[N_DIMENSIONS];
     BOOLEAN         active, deriv_dir_correct;
     int             n_boundaries;
-    Real            boundary_positions[3];
+    Real            boundary_positions[(MAX_DERIVS+1) * N_DIMENSIONS];
     Real            coefs[(2+MAX_DERIVS)*(2+MAX_DERIVS)*(2+MAX_DERIVS)];
 
     found = FALSE;
@@ -709,11 +854,9 @@ static  BOOLEAN  check_voxel_for_isovalue(
                 }
                 else
                 {
-                    first_deriv_ptr[0] = first_deriv;
-                    (void) evaluate_volume( volume, voxel, NULL,
-                                            degrees_continuity, FALSE,
-                                            get_volume_real_min(volume), &value,
-                                            first_deriv_ptr, NULL );
+                    evaluate_volume_with_lookup( lookup, volume,
+                                                 degrees_continuity, voxel,
+                                                 &value, first_deriv );
                 }
 
                 deriv_dir_correct = TRUE;
@@ -747,18 +890,42 @@ static  BOOLEAN  check_voxel_for_isovalue(
 }
 
 static  BOOLEAN  does_voxel_contain_value_range(
-    Volume          volume,
-    int             degrees_continuity,
-    int             voxel[],
-    Real            min_value,
-    Real            max_value )
+    voxel_coef_struct  *lookup,
+    Volume             volume,
+    int                degrees_continuity,
+    int                voxel[],
+    Real               min_value,
+    Real               max_value )
 {
     int      dim, i, n_values, start, end, sizes[MAX_DIMENSIONS];
-    BOOLEAN  greater, less;
-    Real     values[4*4*4];
+    int      low[N_DIMENSIONS], high[N_DIMENSIONS];
+    BOOLEAN  greater, less, use_spline_coefs;
+    Real     values[4*4*4], box_min, box_max;
 
     get_volume_sizes( volume, sizes );
 
+    use_spline_coefs = lookup != NULL && lookup->spline_coefs != NULL &&
+                       degrees_continuity == 2;
+
+    /*--- the pyramid bounds the voxel values, so if the voxels read below
+          are entirely on one side of the range, there is no need to read
+          them */
+
+    if( lookup != NULL && lookup->minmax_pyramid != NULL &&
+        !use_spline_coefs && degrees_continuity >= 0 )
+    {
+        for_less( dim, 0, N_DIMENSIONS )
+        {
+            low[dim] = voxel[dim];
+            high[dim] = voxel[dim] + degrees_continuity + 1;
+        }
+
+        if( get_minmax_pyramid_box_range( lookup->minmax_pyramid, low, high,
+                                          &box_min, &box_max ) &&
+            (box_max < min_value || box_min > max_value) )
+            return( FALSE );
+    }
+
     /*--- special case, to be done fast */
 
     if( degrees_continuity == 0 )
@@ -799,16 +966,32 @@ static  BOOLEAN  does_voxel_contain_value_range(
     start = -(degrees_continuity + 1) / 2;
     end = start + degrees_continuity + 2;
 
+    /*--- the voxel values are read from voxel to voxel+degrees+1, which
+          must also lie within the volume */
+
     for_less( dim, 0, N_DIMENSIONS )
     {
-        if( voxel[dim] + start < 0 || voxel[dim] + end > sizes[dim] )
+        if( voxel[dim] + start < 0 || voxel[dim] + end > sizes[dim] ||
+            (!use_spline_coefs &&
+             voxel[dim] + degrees_continuity + 2 > sizes[dim]) )
             return( FALSE );
     }
 
-    get_volume_value_hyperslab_3d( volume, voxel[X], voxel[Y], voxel[Z],
-                                   degrees_continuity + 2,
-                                   degrees_continuity + 2,
-                                   degrees_continuity + 2, values );
+    /*--- the B-spline lies within the range of its coefficients, so this
+          test is exact rather than a heuristic */
+
+    if( use_spline_coefs )
+    {
+        get_spline_coef_volume_coefs( lookup->spline_coefs,
+                                      voxel[X], voxel[Y], voxel[Z], values );
+    }
+    else
+    {
+        get_volume_value_hyperslab_3d( volume, voxel[X], voxel[Y], voxel[Z],
+                                       degrees_continuity + 2,
+                                       degrees_continuity + 2,
+                                       degrees_continuity + 2, values );
+    }
 
     n_values = (degrees_continuity + 2) *
                (degrees_continuity + 2) *
@@ -839,6 +1022,7 @@ static  BOOLEAN  does_voxel_contain_value_range(
 }
 
 static  BOOLEAN  voxel_might_contain_boundary(
+    voxel_coef_struct           *lookup,
     Volume                      volume,
     bitlist_3d_struct           *done_bits,
     bitlist_3d_struct           *surface_bits,
@@ -856,7 +1040,7 @@ static  BOOLEAN  voxel_might_contain_boundary(
                                  voxel_indices[Z] ) )
         {
             contains = does_voxel_contain_value_range(
-                           volume, degrees_continuity,
+                           lookup, volume, degrees_continuity,
                            voxel_indices,
                            boundary_def->min_isovalue,
                            boundary_def->max_isovalue );
@@ -957,8 +1141,8 @@ static  BOOLEAN  check_voxel_for_boundary(
         GET_RAY_POINT( surface, line_origin, line_direction,
                           (min_line_t + max_line_t) / 2.0 );
 
-        inside = is_point_inside_surface( volume, label_volume,
-                                          degrees_continuity,
+        inside = is_point_inside_surface_with_lookup( lookup, volume,
+                                          label_volume, degrees_continuity,
                                           surface, &direction,
                                           boundary_def );
 
@@ -1001,8 +1185,8 @@ static  BOOLEAN  check_voxel_for_boundary(
         else if( value > boundary_def->max_isovalue )
             inside = TRUE;
         else
-            inside = is_point_inside_surface( volume, label_volume,
-                                              degrees_continuity,
+            inside = is_point_inside_surface_with_lookup( lookup, volume,
+                                              label_volume, degrees_continuity,
                                               surface, &direction,
                                               boundary_def );
 
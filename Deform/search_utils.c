@@ -8,10 +8,69 @@ BICAPI  BOOLEAN  is_point_inside_surface(
     Real                        voxel[],
     Vector                      *direction,
     boundary_definition_struct  *boundary_def )
+{
+    return( is_point_inside_surface_with_lookup( NULL, volume, label_volume,
+                                                 continuity, voxel, direction,
+                                                 boundary_def ) );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : evaluate_volume_with_lookup
+@INPUT      : lookup             - or NULL
+              volume
+              degrees_continuity
+              voxel
+@OUTPUT     : value
+              derivs             - first derivatives in voxel coordinates
+@RETURNS    :
+@DESCRIPTION: Evaluates the volume as evaluate_volume() does, except that
+              cubic interpolation uses the spline coefficient volume of the
+              lookup, if one was set with set_lookup_spline_coef_volume().
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  evaluate_volume_with_lookup(
+    voxel_coef_struct           *lookup,
+    Volume                      volume,
+    int                         degrees_continuity,
+    Real                        voxel[],
+    Real                        *value,
+    Real                        derivs[] )
+{
+    Real    *deriv_ptr[1];
+
+    if( lookup != NULL && lookup->spline_coefs != NULL &&
+        degrees_continuity == 2 )
+    {
+        (void) evaluate_spline_coef_volume( lookup->spline_coefs, voxel,
+                                            get_volume_real_min(volume),
+                                            value, derivs, NULL );
+        return;
+    }
+
+    deriv_ptr[0] = derivs;
+
+    evaluate_volume( volume, voxel, NULL, degrees_continuity, FALSE,
+                     get_volume_real_min(volume),
+                     value, deriv_ptr, NULL );
+}
+
+BICAPI  BOOLEAN  is_point_inside_surface_with_lookup(
+    voxel_coef_struct           *lookup,
+    Volume                      volume,
+    Volume                      label_volume,
+    int                         continuity,
+    Real                        voxel[],
+    Vector                      *direction,
+    boundary_definition_struct  *boundary_def )
 {
     BOOLEAN active;
     Real    value, mag, dx, dy, dz, dot_product;
-    Real    derivs[MAX_DIMENSIONS], *deriv_ptr[1];
+    Real    derivs[MAX_DIMENSIONS];
     Real    min_dot, max_dot;
 
     active = get_volume_voxel_activity( label_volume, voxel, FALSE );
@@ -19,11 +78,8 @@ BICAPI  BOOLEAN  is_point_inside_surface(
     if( !active )
         return( FALSE );
 
-    deriv_ptr[0] = derivs;
-
-    evaluate_volume( volume, voxel, NULL, continuity, FALSE,
-                     get_volume_real_min(volume),
-                     &value, deriv_ptr, NULL );
+    evaluate_volume_with_lookup( lookup, volume, continuity, voxel,
+                                 &value, derivs );
 
     if( value < boundary_def->min_isovalue )
         return( FALSE );
@@ -320,6 +376,62 @@ BICAPI  void  initialize_lookup_volume_coeficients(
     voxel_coef_struct  *lookup )
 {
     lookup->n_in_hash = 0;
+    lookup->head = NULL;
+    lookup->tail = NULL;
+    lookup->spline_coefs = NULL;
+    lookup->minmax_pyramid = NULL;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : set_lookup_spline_coef_volume
+@INPUT      : lookup
+              spline_coefs  - created from the volume being searched, or NULL
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Makes searches through the lookup with degrees_continuity 2,
+              such as find_boundary_in_direction(), use the prefiltered
+              cubic B-spline instead of the Catmull-Rom interpolation of the
+              voxels.  The spline coefficients are owned by the caller and
+              can be shared by any number of lookups.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  set_lookup_spline_coef_volume(
+    voxel_coef_struct          *lookup,
+    spline_coef_volume_struct  *spline_coefs )
+{
+    lookup->spline_coefs = spline_coefs;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : set_lookup_minmax_pyramid
+@INPUT      : lookup
+              pyramid   - created from the volume being searched, or NULL
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Lets searches through the lookup, such as
+              find_boundary_in_direction(), reject voxels whose
+              neighbourhood lies entirely on one side of the isovalue range
+              from the pyramid, without reading the voxels.  Where a whole
+              block of the pyramid misses the range, the search steps over
+              the block in one go.  Searches only use the pyramid when
+              given done bits.  The pyramid is owned by the caller.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  set_lookup_minmax_pyramid(
+    voxel_coef_struct      *lookup,
+    minmax_pyramid_struct  *pyramid )
+{
+    lookup->minmax_pyramid = pyramid;
 }
 
 BICAPI  void  lookup_volume_coeficients(
@@ -347,6 +459,13 @@ BICAPI  void  lookup_volume_coeficients(
         return;
     }
 
+    if( lookup != NULL && lookup->spline_coefs != NULL &&
+        degrees_continuity == 2 )
+    {
+        get_spline_coef_volume_samples( lookup->spline_coefs, x, y, z, c );
+        return;
+    }
+
     if( lookup == NULL || degrees_continuity != 0 )
     {
         get_volume_value_hyperslab_3d( volume, x+offset, y+offset, z+offset,
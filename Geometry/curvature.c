@@ -18,57 +18,151 @@
 static char rcsid[] = "$Header: /private-cvsroot/libraries/bicpl/Geometry/curvature.c,v 1.22 2005-08-17 22:30:25 bert Exp $";
 #endif
 
+/*--- number of points given to each parallel job */
+
+#define  CURVATURE_BLOCK_SIZE   256
+
+typedef  struct
+{
+    polygons_struct            *polygons;
+    int                        *n_neighbours;
+    int                        **neighbours;
+    int                        *point_polys;
+    int                        *point_vertices;
+    int                        n_distances;
+    Real                       *smoothing_distances;
+    Real                       low_threshold;
+    int                        n_smooth;
+    Real                       *smooth_distances;
+    int                        *smooth_indices;
+    geodesic_workspace_struct  *workspaces;
+    Real                       **curvatures;
+} curvatures_struct;
+
+/*--- computes the curvatures of one block of points, the geodesic searches
+      using the workspace of the thread */
+
+static  void  get_curvatures_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    curvatures_struct  *job;
+    polygons_struct    *polygons;
+    int                point_index, end, d, s;
+    Real               curvature, base_length, *smooth_curvatures;
+    Point              centroid;
+    Vector             normal;
+
+    job = (curvatures_struct *) data;
+    polygons = job->polygons;
+
+    ALLOC( smooth_curvatures, MAX( 1, job->n_smooth ) );
+
+    end = MIN( polygons->n_points, (block+1) * CURVATURE_BLOCK_SIZE );
+
+    for_less( point_index, block * CURVATURE_BLOCK_SIZE, end )
+    {
+        if( job->point_polys[point_index] < 0 )
+            continue;
+
+        if( job->n_smooth > 0 )
+        {
+            get_smooth_surface_curvatures_in_workspace(
+                                     &job->workspaces[thread],
+                                     job->point_polys[point_index],
+                                     job->point_vertices[point_index],
+                                     job->n_smooth, job->smooth_distances,
+                                     smooth_curvatures );
+        }
+
+        s = 0;
+        for_less( d, 0, job->n_distances )
+        {
+            if( job->smoothing_distances[d] <= 0.0 )
+            {
+                compute_points_centroid_and_normal( polygons, point_index,
+                                    job->n_neighbours[point_index],
+                                    job->neighbours[point_index],
+                                    &centroid, &normal, &base_length,
+                                    &curvature );
+            }
+            else
+            {
+                curvature = smooth_curvatures[s];
+                ++s;
+            }
+
+            if( FABS( curvature ) < job->low_threshold )
+                curvature = 0.0;
+
+            job->curvatures[d][point_index] = curvature;
+        }
+    }
+
+    FREE( smooth_curvatures );
+}
+
 /* ----------------------------- MNI Header -----------------------------------
-@NAME       : get_polygon_vertex_curvatures
+@NAME       : get_polygon_vertex_curvatures_at_distances
 @INPUT      : polygons
-              smoothing_distance
+              n_neighbours
+              neighbours
+              n_distances
+              smoothing_distances
               low_threshold
-@OUTPUT     : curvatures
+              n_threads   - number of threads, or <= 0 for the default
+@OUTPUT     : curvatures  - curvatures[d][point] for each smoothing distance
 @RETURNS    : 
-@DESCRIPTION: Computes the curvatures at each vertex of the polygon, using
-              1 of two methods.  If smoothing distance is zero, computes
-              instantaneous curvature in terms of a fractional relative
-              curvature.  If non-zero, returns +/- angle in degrees of the
-              smoothed curvature.
+@DESCRIPTION: Computes the curvatures at each vertex of the polygons for
+              several smoothing distances, as get_polygon_vertex_curvatures()
+              does for one.  The smoothed curvatures of a vertex for all
+              the positive distances come from one geodesic search to the
+              largest of them.  The vertices are handled in parallel, each
+              thread with its own geodesic workspace, each vertex being
+              seeded from the first polygon containing it, so the results
+              do not depend on the number of threads.
 @METHOD     : 
 @GLOBALS    : 
 @CALLS      : 
-@CREATED    :         1994    David MacDonald
+@CREATED    : Oct. 2026
 @MODIFIED   : 
 ---------------------------------------------------------------------------- */
 
-BICAPI  void  get_polygon_vertex_curvatures(
+BICAPI  void  get_polygon_vertex_curvatures_at_distances(
     polygons_struct   *polygons,
     int               n_neighbours[],
     int               *neighbours[],
-    Real              smoothing_distance,
+    int               n_distances,
+    Real              smoothing_distances[],
     Real              low_threshold,
-    Real              curvatures[] )
+    int               n_threads,
+    Real              *curvatures[] )
 {
-    int              size, point_index, vertex_index, poly;
-    Real             curvature, base_length;
-    Smallest_int     *point_done;
-    Point            centroid;
-    Vector           normal;
-    float            *distances;
-    BOOLEAN          initialized;
-    progress_struct  progress;
+    curvatures_struct  job;
+    int                point_index, poly, vertex_index, size, d, thread;
+    int                n_blocks;
+
+    if( polygons->n_points <= 0 || n_distances <= 0 )
+        return;
 
     compute_polygon_normals( polygons );
 
-    ALLOC( point_done, polygons->n_points );
+    job.polygons = polygons;
+    job.n_neighbours = n_neighbours;
+    job.neighbours = neighbours;
+    job.n_distances = n_distances;
+    job.smoothing_distances = smoothing_distances;
+    job.low_threshold = low_threshold;
+    job.curvatures = curvatures;
 
-    for_less( point_index, 0, polygons->n_points )
-        point_done[point_index] = FALSE;
+    /*--- each point is seeded from the first polygon containing it */
 
-    if( smoothing_distance > 0.0 )
-    {
-        ALLOC( distances, polygons->n_points );
-        initialized = FALSE;
-    }
+    ALLOC( job.point_polys, polygons->n_points );
+    ALLOC( job.point_vertices, polygons->n_points );
 
-    initialize_progress_report( &progress, FALSE, polygons->n_items,
-                                "Computing Curvatures" );
+    for_less( point_index, 0, polygons->n_points )
+        job.point_polys[point_index] = -1;
 
     for_less( poly, 0, polygons->n_items )
     {
@@ -79,45 +173,86 @@ BICAPI  void  get_polygon_vertex_curvatures(
             point_index = polygons->indices[
                 POINT_INDEX(polygons->end_indices,poly,vertex_index)];
 
-            if( !point_done[point_index] )
+            if( job.point_polys[point_index] < 0 )
             {
-                point_done[point_index] = TRUE;
-
-                if( smoothing_distance <= 0.0 )
-                {
-                    compute_points_centroid_and_normal( polygons, point_index,
-                                        n_neighbours[point_index],
-                                        neighbours[point_index],
-                                        &centroid, &normal, &base_length,
-                                        &curvature );
-
-                }
-                else
-                {
-		    /* There is some state being carried around in
-		       the "distances" list.  Negative numbers are being
-		       used as markers in some manner.
-		    */
-                    curvature = get_smooth_surface_curvature( polygons,
-                                  n_neighbours, neighbours,
-                                  poly, vertex_index,
-                                  initialized, distances, smoothing_distance );
-
-                    initialized = TRUE;
-                }
-
-                if( FABS( curvature ) < low_threshold )
-                    curvature = 0.0;
-
-                curvatures[point_index] = curvature;
+                job.point_polys[point_index] = poly;
+                job.point_vertices[point_index] = vertex_index;
             }
         }
+    }
+
+    job.n_smooth = 0;
+    ALLOC( job.smooth_distances, n_distances );
 
-        update_progress_report( &progress, poly + 1 );
+    for_less( d, 0, n_distances )
+    {
+        if( smoothing_distances[d] > 0.0 )
+        {
+            job.smooth_distances[job.n_smooth] = smoothing_distances[d];
+            ++job.n_smooth;
+        }
     }
 
-    terminate_progress_report( &progress );
+    n_blocks = (polygons->n_points + CURVATURE_BLOCK_SIZE - 1) /
+               CURVATURE_BLOCK_SIZE;
+    n_threads = get_n_threads_to_use( n_threads, n_blocks );
+
+    if( job.n_smooth > 0 )
+    {
+        ALLOC( job.workspaces, n_threads );
+        for_less( thread, 0, n_threads )
+        {
+            initialize_geodesic_workspace( &job.workspaces[thread], polygons,
+                                           n_neighbours, neighbours );
+        }
+    }
+
+    do_parallel_jobs( n_threads, n_blocks, get_curvatures_block,
+                      (void *) &job );
+
+    if( job.n_smooth > 0 )
+    {
+        for_less( thread, 0, n_threads )
+            delete_geodesic_workspace( &job.workspaces[thread] );
+        FREE( job.workspaces );
+    }
+
+    FREE( job.smooth_distances );
+    FREE( job.point_polys );
+    FREE( job.point_vertices );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_polygon_vertex_curvatures
+@INPUT      : polygons
+              smoothing_distance
+              low_threshold
+@OUTPUT     : curvatures
+@RETURNS    : 
+@DESCRIPTION: Computes the curvatures at each vertex of the polygon, using
+              1 of two methods.  If smoothing distance is zero, computes
+              instantaneous curvature in terms of a fractional relative
+              curvature.  If non-zero, returns +/- angle in degrees of the
+              smoothed curvature.  The vertices are handled in parallel with
+              the default number of threads.
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    :         1994    David MacDonald
+@MODIFIED   : Oct. 2026
+---------------------------------------------------------------------------- */
 
-    if( smoothing_distance > 0.0 )
-        FREE( distances );
+BICAPI  void  get_polygon_vertex_curvatures(
+    polygons_struct   *polygons,
+    int               n_neighbours[],
+    int               *neighbours[],
+    Real              smoothing_distance,
+    Real              low_threshold,
+    Real              curvatures[] )
+{
+    get_polygon_vertex_curvatures_at_distances( polygons,
+                                                n_neighbours, neighbours,
+                                                1, &smoothing_distance,
+                                                low_threshold, 0,
+                                                &curvatures );
 }
@@ -0,0 +1,260 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#include "bicpl_internal.h"
+
+typedef  PRIORITY_QUEUE_STRUCT( int )   point_queue_struct;
+
+/*--- distance of point c from a front crossing the triangle a, b, c, given
+      the distances of a and b.  The triangle is unfolded in the plane with
+      a at the origin and b on the x axis, and the virtual source, at
+      distance dist_a from a and dist_b from b, is placed on the other side
+      of ab from c.  Returns FALSE if the straight path from the virtual
+      source to c does not cross the edge ab, in which case the distance
+      comes from the edges alone. */
+
+static  BOOLEAN  get_triangle_update(
+    Point   *a,
+    Point   *b,
+    Point   *c,
+    Real    dist_a,
+    Real    dist_b,
+    Real    *dist_c )
+{
+    Real   len_ab, len_ac, len_bc, sx, sy, cx, cy, t, x;
+
+    len_ab = distance_between_points( a, b );
+    len_ac = distance_between_points( a, c );
+    len_bc = distance_between_points( b, c );
+
+    if( len_ab <= 0.0 )
+        return( FALSE );
+
+    sx = (dist_a * dist_a - dist_b * dist_b + len_ab * len_ab) /
+         (2.0 * len_ab);
+    sy = dist_a * dist_a - sx * sx;
+
+    cx = (len_ac * len_ac - len_bc * len_bc + len_ab * len_ab) /
+         (2.0 * len_ab);
+    cy = len_ac * len_ac - cx * cx;
+
+    if( sy < 0.0 || cy <= 0.0 )
+        return( FALSE );
+
+    sy = -sqrt( sy );
+    cy = sqrt( cy );
+
+    t = -sy / (cy - sy);
+    x = sx + t * (cx - sx);
+
+    if( x < 0.0 || x > len_ab )
+        return( FALSE );
+
+    *dist_c = sqrt( (cx - sx) * (cx - sx) + (cy - sy) * (cy - sy) );
+
+    return( TRUE );
+}
+
+/*--- the front only moves outwards, so a point reached with a distance no
+      greater than that of the point being accepted can no longer change */
+
+#define  IS_FINAL_DISTANCE( distances, x, a ) \
+             ((distances)[x] >= 0.0f && (distances)[x] <= (distances)[a])
+
+/*--- lowers the distance of point c, not yet final, from the accepted
+      point a and, if b is final, from the front across the triangle
+      a, b, c */
+
+static  void  update_fast_marching_point(
+    polygons_struct     *polygons,
+    int                 a,
+    int                 b,
+    int                 c,
+    Real                max_distance,
+    float               distances[],
+    int                 *n_found,
+    int                 *list[],
+    point_queue_struct  *queue )
+{
+    Real    dist, tri_dist;
+    float   prev_dist;
+
+    if( IS_FINAL_DISTANCE( distances, c, a ) )
+        return;
+
+    dist = (Real) distances[a] +
+           distance_between_points( &polygons->points[a],
+                                    &polygons->points[c] );
+
+    if( b >= 0 && IS_FINAL_DISTANCE( distances, b, a ) &&
+        get_triangle_update( &polygons->points[a], &polygons->points[b],
+                             &polygons->points[c], (Real) distances[a],
+                             (Real) distances[b], &tri_dist ) &&
+        tri_dist < dist )
+    {
+        dist = MAX( tri_dist, (Real) MAX( distances[a], distances[b] ) );
+    }
+
+    prev_dist = distances[c];
+
+    if( (max_distance < 0.0 || dist <= max_distance) &&
+        (prev_dist < 0.0f || (float) dist < prev_dist) )
+    {
+        if( prev_dist < 0.0f )
+        {
+            if( list != NULL )
+            {
+                ADD_ELEMENT_TO_ARRAY( *list, *n_found, c, DEFAULT_CHUNK_SIZE );
+            }
+            else
+                ++(*n_found);
+        }
+
+        distances[c] = (float) dist;
+        INSERT_IN_PRIORITY_QUEUE( *queue, c, -dist );
+    }
+}
+
+/*! \brief Compute distance in mesh by fast marching.
+ *
+ * Computes geodesic distances over the surface from \a point in polygon
+ * \a poly, with the same arguments and results as
+ * compute_distances_from_point(), but propagating a front across the
+ * triangles rather than following the edges, which removes most of the
+ * overestimation of graph distances.  The front is advanced with the
+ * unfolding update of Kimmel and Sethian; where the straight path to a
+ * point does not cross the opposite edge, as behind an obtuse angle, the
+ * distance along the edges is used.  Polygons other than triangles are
+ * only followed along their edges.
+ *
+ * Unlike compute_distances_from_point(), no point neighbours are needed:
+ * the polygons around each point are found through the half-edge index,
+ * which is created if necessary.  Points are marked as accepted through
+ * their distances rather than with a separate array, so when
+ * \a distances_initialized is TRUE the cost of a call depends only on the
+ * points reached, not on the size of the surface.
+ */
+BICAPI  int  compute_fast_marching_distances_from_point(
+    polygons_struct   *polygons,
+    Point             *point,
+    int               poly,
+    Real              max_distance,
+    BOOLEAN           distances_initialized,
+    float             distances[],
+    int               *list[] )
+{
+    int                      i, p, size, point_index, n_found, c, h, start;
+    int                      next, prev;
+    Real                     dist;
+    polygon_topology_struct  *topology;
+    point_queue_struct       queue;
+
+    if( poly == -1 )
+    {
+        if( !lookup_polygon_vertex( polygons, point, &point_index ) ||
+            !find_polygon_with_vertex( polygons, point_index, &poly, &p ) )
+        {
+            print_error( "compute_fast_marching_distances_from_point "
+                         "incorrect arguments.\n" );
+            return( 0 );
+        }
+    }
+
+    check_polygons_topology_computed( polygons );
+    topology = polygons->topology;
+
+    n_found = 0;
+
+    if( !distances_initialized )
+    {
+        for_less( i, 0, polygons->n_points )
+            distances[i] = -1.0f;
+    }
+
+    INITIALIZE_PRIORITY_QUEUE( queue );
+
+    size = GET_OBJECT_SIZE( *polygons, poly );
+
+    for_less( p, 0, size )
+    {
+        point_index = polygons->indices[
+                            POINT_INDEX( polygons->end_indices, poly, p )];
+
+        dist = distance_between_points(
+                            &polygons->points[point_index], point );
+
+        if( max_distance <= 0.0 || dist < max_distance )
+        {
+            if( list != NULL )
+            {
+                ADD_ELEMENT_TO_ARRAY( *list, n_found, point_index,
+                                      DEFAULT_CHUNK_SIZE );
+            }
+            else
+                ++n_found;
+
+            distances[point_index] = (float) dist;
+            INSERT_IN_PRIORITY_QUEUE( queue, point_index, -dist );
+        }
+    }
+
+    while( !IS_PRIORITY_QUEUE_EMPTY( queue ) )
+    {
+        REMOVE_FROM_PRIORITY_QUEUE( queue, point_index, dist );
+
+        /*--- skip entries superseded by a lower distance; the priorities
+              are floats, as are the distances, so the comparison is
+              exact */
+
+        if( (float) -dist != distances[point_index] )
+            continue;
+
+        for_less( c, topology->offsets[point_index],
+                     topology->offsets[point_index+1] )
+        {
+            h = topology->corners[c];
+            p = topology->polys[h];
+            start = START_INDEX( polygons->end_indices, p );
+            size = polygons->end_indices[p] - start;
+
+            next = polygons->indices[start + (h - start + 1) % size];
+            prev = polygons->indices[start + (h - start + size - 1) % size];
+
+            if( size != 3 )
+            {
+                update_fast_marching_point( polygons, point_index,
+                                            -1, next, max_distance, distances,
+                                            &n_found, list, &queue );
+                update_fast_marching_point( polygons, point_index,
+                                            -1, prev, max_distance, distances,
+                                            &n_found, list, &queue );
+            }
+            else
+            {
+                update_fast_marching_point( polygons, point_index,
+                                            prev, next, max_distance,
+                                            distances, &n_found, list,
+                                            &queue );
+                update_fast_marching_point( polygons, point_index,
+                                            next, prev, max_distance,
+                                            distances, &n_found, list,
+                                            &queue );
+            }
+        }
+    }
+
+    DELETE_PRIORITY_QUEUE( queue );
+
+    return( n_found );
+}
@@ -149,3 +149,386 @@ BICAPI  int  compute_distances_from_point(
 
     return( n_found );
 }
+
+/*--- the width of a bucket as a fraction of the average edge length, and
+      the largest number of buckets, beyond which the buckets are widened */
+
+#define  GEODESIC_BUCKET_FRACTION   0.5
+#define  MAX_GEODESIC_BUCKETS       65536
+
+/*--- number of sources given to each parallel job */
+
+#define  GEODESIC_SOURCES_BLOCK_SIZE   16
+
+/*! \brief Create a workspace for geodesic distance computations.
+ *
+ * The bucket width is derived from the lengths of the edges in the
+ * neighbour lists, and the number of buckets from the longest edge,
+ * so that the points waiting in the queue never span more than the
+ * circular array of buckets.
+ */
+BICAPI  void  initialize_geodesic_workspace(
+    geodesic_workspace_struct  *workspace,
+    polygons_struct            *polygons,
+    int                        n_neighbours[],
+    int                        *neighbours[] )
+{
+    int    point, neigh, n_edges;
+    Real   len, sum_len, max_len;
+
+    workspace->polygons = polygons;
+    workspace->n_neighbours = n_neighbours;
+    workspace->neighbours = neighbours;
+
+    n_edges = 0;
+    sum_len = 0.0;
+    max_len = 0.0;
+
+    for_less( point, 0, polygons->n_points )
+    {
+        for_less( neigh, 0, n_neighbours[point] )
+        {
+            len = distance_between_points( &polygons->points[point],
+                              &polygons->points[neighbours[point][neigh]] );
+            sum_len += len;
+            max_len = MAX( max_len, len );
+            ++n_edges;
+        }
+    }
+
+    if( n_edges > 0 && sum_len > 0.0 )
+        workspace->bucket_width = GEODESIC_BUCKET_FRACTION * sum_len /
+                                  (Real) n_edges;
+    else
+        workspace->bucket_width = 1.0;
+
+    if( max_len / workspace->bucket_width > (Real) (MAX_GEODESIC_BUCKETS-2) )
+        workspace->bucket_width = max_len / (Real) (MAX_GEODESIC_BUCKETS-2);
+
+    workspace->n_buckets = (int) (max_len / workspace->bucket_width) + 2;
+
+    ALLOC( workspace->buckets, workspace->n_buckets );
+    for_less( neigh, 0, workspace->n_buckets )
+        workspace->buckets[neigh] = -1;
+
+    ALLOC( workspace->distances, MAX( 1, polygons->n_points ) );
+    ALLOC( workspace->list, MAX( 1, polygons->n_points ) );
+    ALLOC( workspace->point_buckets, MAX( 1, polygons->n_points ) );
+    ALLOC( workspace->bucket_next, MAX( 1, polygons->n_points ) );
+    ALLOC( workspace->bucket_prev, MAX( 1, polygons->n_points ) );
+
+    for_less( point, 0, polygons->n_points )
+    {
+        workspace->distances[point] = -1.0f;
+        workspace->point_buckets[point] = -1;
+    }
+
+    workspace->n_found = 0;
+}
+
+/*! \brief Delete a workspace created by initialize_geodesic_workspace().
+ */
+BICAPI  void  delete_geodesic_workspace(
+    geodesic_workspace_struct  *workspace )
+{
+    FREE( workspace->buckets );
+    FREE( workspace->distances );
+    FREE( workspace->list );
+    FREE( workspace->point_buckets );
+    FREE( workspace->bucket_next );
+    FREE( workspace->bucket_prev );
+}
+
+/*--- puts a point in the bucket of its distance, moving it if it is
+      already queued.  current is the bucket being visited, counted from
+      distance zero; a distance too far ahead of it for the circular array
+      is put in the last bucket, to be relaxed again if it improves */
+
+static  void  queue_geodesic_point(
+    geodesic_workspace_struct  *workspace,
+    int                        point,
+    int                        current,
+    int                        *n_queued )
+{
+    int   bucket, next, prev;
+    Real  ahead;
+
+    ahead = (Real) workspace->distances[point] / workspace->bucket_width -
+            (Real) current;
+
+    if( ahead < 1.0 )
+        bucket = current;
+    else if( ahead >= (Real) (workspace->n_buckets - 1) )
+        bucket = current + workspace->n_buckets - 1;
+    else
+        bucket = current + (int) ahead;
+
+    bucket %= workspace->n_buckets;
+
+    if( workspace->point_buckets[point] == bucket )
+        return;
+
+    if( workspace->point_buckets[point] >= 0 )
+    {
+        next = workspace->bucket_next[point];
+        prev = workspace->bucket_prev[point];
+
+        if( prev >= 0 )
+            workspace->bucket_next[prev] = next;
+        else
+            workspace->buckets[workspace->point_buckets[point]] = next;
+
+        if( next >= 0 )
+            workspace->bucket_prev[next] = prev;
+    }
+    else
+        ++(*n_queued);
+
+    next = workspace->buckets[bucket];
+    workspace->bucket_next[point] = next;
+    workspace->bucket_prev[point] = -1;
+    if( next >= 0 )
+        workspace->bucket_prev[next] = point;
+
+    workspace->buckets[bucket] = point;
+    workspace->point_buckets[point] = bucket;
+}
+
+/*--- sets the distance of a point, adding it to the list if it is reached
+      for the first time */
+
+static  void  set_geodesic_distance(
+    geodesic_workspace_struct  *workspace,
+    int                        point,
+    float                      dist,
+    int                        current,
+    int                        *n_queued )
+{
+    if( workspace->distances[point] < 0.0f )
+    {
+        workspace->list[workspace->n_found] = point;
+        ++workspace->n_found;
+    }
+
+    workspace->distances[point] = dist;
+    queue_geodesic_point( workspace, point, current, n_queued );
+}
+
+/*! \brief Compute distances in the mesh from a point, using a workspace.
+ *
+ * Computes the same single-source shortest path distances as
+ * compute_distances_from_point(), from \a point lying in polygon \a poly,
+ * or from a vertex of the polygons if \a poly is -1.  If \a max_distance
+ * is not negative, only the points within this distance are reached.
+ *
+ * The distances of the previous computation are reset first, only for the
+ * points it reached.  The points are visited in buckets of distance, all
+ * points of a bucket being relaxed until none of them improves before
+ * moving to the next bucket, so the distances are exact whatever the
+ * bucket width.
+ *
+ * Returns the number of points reached, which are listed in
+ * workspace->list with their distances in workspace->distances.
+ */
+BICAPI  int  compute_geodesic_distances(
+    geodesic_workspace_struct  *workspace,
+    Point                      *point,
+    int                        poly,
+    Real                       max_distance )
+{
+    polygons_struct  *polygons;
+    int              i, p, size, point_index, next_point_index, neigh;
+    int              n_queued, current, bucket;
+    Real             dist;
+    float            next_dist;
+
+    polygons = workspace->polygons;
+
+    for_less( i, 0, workspace->n_found )
+        workspace->distances[workspace->list[i]] = -1.0f;
+
+    workspace->n_found = 0;
+
+    if( poly == -1 )
+    {
+        if( !lookup_polygon_vertex( polygons, point, &point_index ) ||
+            !find_polygon_with_vertex( polygons, point_index, &poly, &p ) )
+        {
+            print_error( "compute_geodesic_distances incorrect arguments.\n");
+            return( 0 );
+        }
+    }
+
+    n_queued = 0;
+
+    size = GET_OBJECT_SIZE( *polygons, poly );
+
+    for_less( p, 0, size )
+    {
+        point_index = polygons->indices[
+                            POINT_INDEX( polygons->end_indices, poly, p )];
+
+        dist = distance_between_points(
+                            &polygons->points[point_index], point );
+
+        if( max_distance <= 0.0 || dist < max_distance )
+            set_geodesic_distance( workspace, point_index, (float) dist,
+                                   0, &n_queued );
+    }
+
+    current = 0;
+
+    while( n_queued > 0 )
+    {
+        while( workspace->buckets[current % workspace->n_buckets] < 0 )
+            ++current;
+
+        bucket = current % workspace->n_buckets;
+
+        /*--- relaxing a point may queue another in the same bucket, which
+              is then taken before leaving the bucket */
+
+        while( workspace->buckets[bucket] >= 0 )
+        {
+            point_index = workspace->buckets[bucket];
+
+            workspace->buckets[bucket] = workspace->bucket_next[point_index];
+            if( workspace->buckets[bucket] >= 0 )
+                workspace->bucket_prev[workspace->buckets[bucket]] = -1;
+            workspace->point_buckets[point_index] = -1;
+            --n_queued;
+
+            for_less( neigh, 0, workspace->n_neighbours[point_index] )
+            {
+                next_point_index = workspace->neighbours[point_index][neigh];
+                next_dist = workspace->distances[next_point_index];
+
+                if( next_dist >= 0.0f &&
+                    next_dist <= workspace->distances[point_index] )
+                    continue;
+
+                dist = (Real) workspace->distances[point_index] +
+                       distance_between_points(
+                                      &polygons->points[point_index],
+                                      &polygons->points[next_point_index] );
+
+                if( (max_distance < 0.0 || dist <= max_distance) &&
+                    (next_dist < 0.0f || (float) dist < next_dist) )
+                {
+                    set_geodesic_distance( workspace, next_point_index,
+                                           (float) dist, current, &n_queued );
+                }
+            }
+        }
+    }
+
+    return( workspace->n_found );
+}
+
+typedef  struct
+{
+    geodesic_workspace_struct  *workspaces;
+    int                        n_sources;
+    int                        *source_points;
+    int                        *source_polys;
+    Real                       max_distance;
+    void                       (*func)( void *, int, int,
+                                        geodesic_workspace_struct * );
+    void                       *func_data;
+} geodesic_sources_struct;
+
+static  void  compute_geodesic_sources_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    geodesic_sources_struct    *sources;
+    geodesic_workspace_struct  *workspace;
+    polygons_struct            *polygons;
+    int                        source, end, point_index, poly, vertex;
+
+    sources = (geodesic_sources_struct *) data;
+    workspace = &sources->workspaces[thread];
+    polygons = workspace->polygons;
+
+    end = MIN( sources->n_sources, (block+1) * GEODESIC_SOURCES_BLOCK_SIZE );
+
+    for_less( source, block * GEODESIC_SOURCES_BLOCK_SIZE, end )
+    {
+        point_index = sources->source_points[source];
+
+        if( sources->source_polys != NULL )
+            poly = sources->source_polys[source];
+        else if( !find_polygon_with_vertex( polygons, point_index,
+                                            &poly, &vertex ) )
+            continue;
+
+        (void) compute_geodesic_distances( workspace,
+                                           &polygons->points[point_index],
+                                           poly, sources->max_distance );
+
+        (*sources->func)( sources->func_data, source, thread, workspace );
+    }
+}
+
+/*! \brief Compute distances in the mesh from many vertices in parallel.
+ *
+ * For each of the \a n_sources vertices \a source_points, computes the
+ * distances as compute_geodesic_distances() and passes the result to
+ * \a func, with the index of the source, the index of the thread and the
+ * workspace holding the distances.  The sources are handled in parallel,
+ * one workspace per thread, so \a func is called concurrently for
+ * different sources, and must not modify the workspace.
+ *
+ * \a source_polys gives a polygon containing each source, or is NULL,
+ * in which case the half-edge index of the polygons is created to find
+ * them.  Sources which are in no polygon are skipped.
+ */
+BICAPI  void  compute_geodesic_distances_from_points(
+    polygons_struct   *polygons,
+    int               n_neighbours[],
+    int               *neighbours[],
+    int               n_sources,
+    int               source_points[],
+    int               source_polys[],
+    Real              max_distance,
+    int               n_threads,
+    void              (*func)( void *data, int source, int thread,
+                               geodesic_workspace_struct *workspace ),
+    void              *func_data )
+{
+    geodesic_sources_struct  sources;
+    int                      n_blocks, thread;
+
+    if( n_sources <= 0 )
+        return;
+
+    if( source_polys == NULL )
+        check_polygons_topology_computed( polygons );
+
+    n_blocks = (n_sources + GEODESIC_SOURCES_BLOCK_SIZE - 1) /
+               GEODESIC_SOURCES_BLOCK_SIZE;
+    n_threads = get_n_threads_to_use( n_threads, n_blocks );
+
+    ALLOC( sources.workspaces, n_threads );
+    for_less( thread, 0, n_threads )
+    {
+        initialize_geodesic_workspace( &sources.workspaces[thread], polygons,
+                                       n_neighbours, neighbours );
+    }
+
+    sources.n_sources = n_sources;
+    sources.source_points = source_points;
+    sources.source_polys = source_polys;
+    sources.max_distance = max_distance;
+    sources.func = func;
+    sources.func_data = func_data;
+
+    do_parallel_jobs( n_threads, n_blocks, compute_geodesic_sources_block,
+                      (void *) &sources );
+
+    for_less( thread, 0, n_threads )
+        delete_geodesic_workspace( &sources.workspaces[thread] );
+
+    FREE( sources.workspaces );
+}
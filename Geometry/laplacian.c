@@ -0,0 +1,873 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#include "bicpl_internal.h"
+
+/*--- the rows of the operator are processed in blocks of this size, each
+      block being one parallel job */
+
+#define  LAPLACIAN_BLOCK_SIZE   4096
+
+typedef  struct
+{
+    polygons_struct           *polygons;
+    polygon_laplacian_struct  *laplacian;
+} laplacian_assembly_struct;
+
+typedef  struct
+{
+    polygon_laplacian_struct  *laplacian;
+    int                       n_components;
+    Real                      lambda;
+    Real                      *values;
+    Real                      *result;
+
+    /*--- the conjugate gradient vectors, and the partial sums of each
+          block, n_components per block */
+
+    Real                      *residual;
+    Real                      *preconditioned;
+    Real                      *direction;
+    Real                      *product;
+    Real                      *alpha;
+    Real                      *beta;
+    Real                      *block_sums1;
+    Real                      *block_sums2;
+} laplacian_job_struct;
+
+static  int  get_n_laplacian_blocks(
+    polygon_laplacian_struct  *laplacian )
+{
+    return( (laplacian->n_points + LAPLACIAN_BLOCK_SIZE - 1) /
+            LAPLACIAN_BLOCK_SIZE );
+}
+
+/*--- cotangent of the angle at c in the triangle a, b, c, or 0 if the
+      triangle is degenerate */
+
+static  Real  get_cotangent_at(
+    Point   *a,
+    Point   *b,
+    Point   *c )
+{
+    Vector   u, v, cross;
+    Real     sin_len;
+
+    SUB_POINTS( u, *a, *c );
+    SUB_POINTS( v, *b, *c );
+    CROSS_VECTORS( cross, u, v );
+
+    sin_len = MAGNITUDE( cross );
+
+    if( sin_len <= 0.0 )
+        return( 0.0 );
+
+    return( DOT_VECTORS( u, v ) / sin_len );
+}
+
+/*--- adds weight to the entry of the row of point to the given neighbour */
+
+static  void  add_laplacian_weight(
+    polygon_laplacian_struct  *laplacian,
+    int                       point,
+    int                       neighbour,
+    Real                      weight )
+{
+    int   i;
+
+    for_less( i, laplacian->offsets[point], laplacian->offsets[point+1] )
+    {
+        if( laplacian->columns[i] == neighbour )
+        {
+            laplacian->weights[i] += weight;
+            return;
+        }
+    }
+}
+
+/*--- computes the cotangent weights of the rows of a block from the
+      triangles around each point, each row only writing its own entries */
+
+static  void  assemble_cotangent_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    laplacian_assembly_struct  *job;
+    polygons_struct            *polygons;
+    polygon_laplacian_struct   *laplacian;
+    polygon_topology_struct    *topology;
+    int                        point, end_point, c, h, poly, start, size;
+    int                        i, next, prev;
+
+    job = (laplacian_assembly_struct *) data;
+    polygons = job->polygons;
+    laplacian = job->laplacian;
+    topology = polygons->topology;
+
+    end_point = MIN( laplacian->n_points, (block+1) * LAPLACIAN_BLOCK_SIZE );
+
+    for_less( point, block * LAPLACIAN_BLOCK_SIZE, end_point )
+    {
+        for_less( i, laplacian->offsets[point], laplacian->offsets[point+1] )
+            laplacian->weights[i] = 0.0;
+
+        for_less( c, topology->offsets[point], topology->offsets[point+1] )
+        {
+            h = topology->corners[c];
+            poly = topology->polys[h];
+            start = START_INDEX( polygons->end_indices, poly );
+            size = polygons->end_indices[poly] - start;
+
+            if( size != 3 )
+                continue;
+
+            next = polygons->indices[start + (h - start + 1) % 3];
+            prev = polygons->indices[start + (h - start + 2) % 3];
+
+            add_laplacian_weight( laplacian, point, next, 0.5 *
+                        get_cotangent_at( &polygons->points[point],
+                                          &polygons->points[next],
+                                          &polygons->points[prev] ) );
+            add_laplacian_weight( laplacian, point, prev, 0.5 *
+                        get_cotangent_at( &polygons->points[point],
+                                          &polygons->points[prev],
+                                          &polygons->points[next] ) );
+        }
+
+        laplacian->diagonal[point] = 0.0;
+
+        for_less( i, laplacian->offsets[point], laplacian->offsets[point+1] )
+        {
+            if( laplacian->weights[i] < 0.0 )
+                laplacian->weights[i] = 0.0;
+
+            laplacian->diagonal[point] += laplacian->weights[i];
+        }
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : create_polygons_laplacian
+@INPUT      : polygons
+              type        - UNIFORM_LAPLACIAN or COTANGENT_LAPLACIAN
+              n_threads   - number of threads, or <= 0 for the default
+@OUTPUT     : laplacian
+@RETURNS    :
+@DESCRIPTION: Assembles the Laplacian of the polygons, L = D - W, in
+              compressed sparse row form.  W holds a weight for each edge
+              from a point to a neighbour and D is the diagonal of the row
+              sums of W.  Uniform weights are 1.  Cotangent weights are half
+              the sum of the cotangents of the angles opposite the edge in
+              its triangles, clamped to be non-negative so that smoothing is
+              stable; polygons other than triangles give no cotangent
+              weights.  The operator depends on the point positions at the
+              time it is created.
+@METHOD     : The rows are those of create_polygon_point_neighbour_graph().
+              Cotangent rows are filled in parallel from the triangles
+              around each point, found through the half-edge index.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  create_polygons_laplacian(
+    polygons_struct           *polygons,
+    Laplacian_types           type,
+    int                       n_threads,
+    polygon_laplacian_struct  *laplacian )
+{
+    int                        point, i, n_blocks;
+    point_neighbours_struct    graph;
+    laplacian_assembly_struct  job;
+
+    create_polygon_point_neighbour_graph( polygons, FALSE, FALSE, &graph );
+
+    laplacian->type = type;
+    laplacian->n_points = polygons->n_points;
+    laplacian->offsets = graph.offsets;
+    laplacian->columns = graph.neighbours;
+    FREE( graph.interior_flags );
+
+    ALLOC( laplacian->weights,
+           MAX( 1, laplacian->offsets[polygons->n_points] ) );
+    ALLOC( laplacian->diagonal, MAX( 1, polygons->n_points ) );
+
+    if( type == COTANGENT_LAPLACIAN )
+    {
+        check_polygons_topology_computed( polygons );
+
+        job.polygons = polygons;
+        job.laplacian = laplacian;
+
+        n_blocks = get_n_laplacian_blocks( laplacian );
+
+        if( n_blocks > 0 )
+        {
+            do_parallel_jobs( get_n_threads_to_use( n_threads, n_blocks ),
+                              n_blocks, assemble_cotangent_block,
+                              (void *) &job );
+        }
+    }
+    else
+    {
+        for_less( point, 0, polygons->n_points )
+        {
+            for_less( i, laplacian->offsets[point],
+                         laplacian->offsets[point+1] )
+                laplacian->weights[i] = 1.0;
+
+            laplacian->diagonal[point] = (Real)
+                   (laplacian->offsets[point+1] - laplacian->offsets[point]);
+        }
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : delete_polygons_laplacian
+@INPUT      : laplacian
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Deletes the Laplacian created by create_polygons_laplacian().
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  delete_polygons_laplacian(
+    polygon_laplacian_struct  *laplacian )
+{
+    FREE( laplacian->offsets );
+    FREE( laplacian->columns );
+    FREE( laplacian->weights );
+    FREE( laplacian->diagonal );
+}
+
+/*--- result = L values for the rows of a block */
+
+static  void  multiply_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    laplacian_job_struct      *job;
+    polygon_laplacian_struct  *laplacian;
+    int                       point, end_point, i, c, nc;
+    Real                      *values, *result, *row_result;
+
+    job = (laplacian_job_struct *) data;
+    laplacian = job->laplacian;
+    nc = job->n_components;
+    values = job->values;
+    result = job->result;
+
+    end_point = MIN( laplacian->n_points, (block+1) * LAPLACIAN_BLOCK_SIZE );
+
+    for_less( point, block * LAPLACIAN_BLOCK_SIZE, end_point )
+    {
+        row_result = &result[point * nc];
+
+        for_less( c, 0, nc )
+            row_result[c] = laplacian->diagonal[point] * values[point*nc+c];
+
+        for_less( i, laplacian->offsets[point], laplacian->offsets[point+1] )
+        {
+            for_less( c, 0, nc )
+            {
+                row_result[c] -= laplacian->weights[i] *
+                                 values[laplacian->columns[i] * nc + c];
+            }
+        }
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : multiply_by_laplacian
+@INPUT      : laplacian
+              n_components  - number of values per point
+              values        - n_points * n_components values, point by point
+              n_threads     - number of threads, or <= 0 for the default
+@OUTPUT     : result        - L times values, which must not be values
+@RETURNS    :
+@DESCRIPTION: Multiplies values on the points by the Laplacian, each
+              component independently, in parallel blocks of rows.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  multiply_by_laplacian(
+    polygon_laplacian_struct  *laplacian,
+    int                       n_components,
+    Real                      values[],
+    Real                      result[],
+    int                       n_threads )
+{
+    int                   n_blocks;
+    laplacian_job_struct  job;
+
+    n_blocks = get_n_laplacian_blocks( laplacian );
+    if( n_blocks == 0 )
+        return;
+
+    job.laplacian = laplacian;
+    job.n_components = n_components;
+    job.values = values;
+    job.result = result;
+
+    do_parallel_jobs( get_n_threads_to_use( n_threads, n_blocks ), n_blocks,
+                      multiply_block, (void *) &job );
+}
+
+/*--- one explicit smoothing step of the rows of a block, from values to
+      result, moving each value the fraction lambda of the way to the
+      weighted average of its neighbours */
+
+static  void  explicit_smoothing_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    laplacian_job_struct      *job;
+    polygon_laplacian_struct  *laplacian;
+    int                       point, end_point, i, c, nc;
+    Real                      *values, *row_result, lambda, scale;
+
+    job = (laplacian_job_struct *) data;
+    laplacian = job->laplacian;
+    nc = job->n_components;
+    values = job->values;
+    lambda = job->lambda;
+
+    end_point = MIN( laplacian->n_points, (block+1) * LAPLACIAN_BLOCK_SIZE );
+
+    for_less( point, block * LAPLACIAN_BLOCK_SIZE, end_point )
+    {
+        row_result = &job->result[point * nc];
+
+        if( laplacian->diagonal[point] <= 0.0 )
+        {
+            for_less( c, 0, nc )
+                row_result[c] = values[point*nc+c];
+            continue;
+        }
+
+        for_less( c, 0, nc )
+            row_result[c] = 0.0;
+
+        for_less( i, laplacian->offsets[point], laplacian->offsets[point+1] )
+        {
+            for_less( c, 0, nc )
+            {
+                row_result[c] += laplacian->weights[i] *
+                                 values[laplacian->columns[i] * nc + c];
+            }
+        }
+
+        scale = lambda / laplacian->diagonal[point];
+
+        for_less( c, 0, nc )
+        {
+            row_result[c] = (1.0 - lambda) * values[point*nc+c] +
+                            scale * row_result[c];
+        }
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : smooth_with_laplacian
+@INPUT      : laplacian
+              n_components  - number of values per point
+              values        - n_points * n_components values, point by point
+              lambda        - fraction to move, from 0 to 1
+              n_iterations
+              n_threads     - number of threads, or <= 0 for the default
+@OUTPUT     : values
+@RETURNS    :
+@DESCRIPTION: Smooths values on the points by n_iterations explicit steps,
+              each moving every value the fraction lambda of the way to the
+              weighted average of its neighbours, that is values -= lambda
+              D^-1 L values.  Points without neighbours are unchanged.
+@METHOD     : Each step is one parallel pass over the rows, alternating
+              between values and a second buffer.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  smooth_with_laplacian(
+    polygon_laplacian_struct  *laplacian,
+    int                       n_components,
+    Real                      values[],
+    Real                      lambda,
+    int                       n_iterations,
+    int                       n_threads )
+{
+    int                   i, n_blocks, n_values;
+    Real                  *buffer, *tmp;
+    laplacian_job_struct  job;
+
+    n_blocks = get_n_laplacian_blocks( laplacian );
+    if( n_blocks == 0 || n_iterations <= 0 )
+        return;
+
+    n_threads = get_n_threads_to_use( n_threads, n_blocks );
+    n_values = laplacian->n_points * n_components;
+
+    ALLOC( buffer, n_values );
+
+    job.laplacian = laplacian;
+    job.n_components = n_components;
+    job.lambda = lambda;
+    job.values = values;
+    job.result = buffer;
+
+    for_less( i, 0, n_iterations )
+    {
+        do_parallel_jobs( n_threads, n_blocks, explicit_smoothing_block,
+                          (void *) &job );
+
+        tmp = job.values;
+        job.values = job.result;
+        job.result = tmp;
+    }
+
+    if( job.values != values )
+    {
+        for_less( i, 0, n_values )
+            values[i] = job.values[i];
+    }
+
+    FREE( buffer );
+}
+
+/*--- the diagonal of the implicit system D + lambda L, or 1 for points
+      without neighbours, which are left unchanged */
+
+static  Real  get_implicit_diagonal(
+    polygon_laplacian_struct  *laplacian,
+    Real                      lambda,
+    int                       point )
+{
+    if( laplacian->diagonal[point] <= 0.0 )
+        return( 1.0 );
+    else
+        return( (1.0 + lambda) * laplacian->diagonal[point] );
+}
+
+/*--- product = (D + lambda L) direction for the rows of a block, and the
+      block's sums of direction . product */
+
+static  void  implicit_product_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    laplacian_job_struct      *job;
+    polygon_laplacian_struct  *laplacian;
+    int                       point, end_point, i, c, nc;
+    Real                      *direction, *row_product, *sums, lambda, diag;
+
+    job = (laplacian_job_struct *) data;
+    laplacian = job->laplacian;
+    nc = job->n_components;
+    direction = job->direction;
+    lambda = job->lambda;
+    sums = &job->block_sums1[block * nc];
+
+    for_less( c, 0, nc )
+        sums[c] = 0.0;
+
+    end_point = MIN( laplacian->n_points, (block+1) * LAPLACIAN_BLOCK_SIZE );
+
+    for_less( point, block * LAPLACIAN_BLOCK_SIZE, end_point )
+    {
+        row_product = &job->product[point * nc];
+        diag = get_implicit_diagonal( laplacian, lambda, point );
+
+        for_less( c, 0, nc )
+            row_product[c] = diag * direction[point*nc+c];
+
+        if( laplacian->diagonal[point] > 0.0 )
+        {
+            for_less( i, laplacian->offsets[point],
+                         laplacian->offsets[point+1] )
+            {
+                for_less( c, 0, nc )
+                {
+                    row_product[c] -= lambda * laplacian->weights[i] *
+                                    direction[laplacian->columns[i] * nc + c];
+                }
+            }
+        }
+
+        for_less( c, 0, nc )
+            sums[c] += direction[point*nc+c] * row_product[c];
+    }
+}
+
+/*--- moves the solution and residual of the rows of a block by alpha,
+      preconditions the residual, and finds the block's sums of
+      residual . preconditioned and residual . residual */
+
+static  void  implicit_update_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    laplacian_job_struct      *job;
+    polygon_laplacian_struct  *laplacian;
+    int                       point, end_point, c, nc, index;
+    Real                      *sums1, *sums2, r, diag;
+
+    job = (laplacian_job_struct *) data;
+    laplacian = job->laplacian;
+    nc = job->n_components;
+    sums1 = &job->block_sums1[block * nc];
+    sums2 = &job->block_sums2[block * nc];
+
+    for_less( c, 0, nc )
+    {
+        sums1[c] = 0.0;
+        sums2[c] = 0.0;
+    }
+
+    end_point = MIN( laplacian->n_points, (block+1) * LAPLACIAN_BLOCK_SIZE );
+
+    for_less( point, block * LAPLACIAN_BLOCK_SIZE, end_point )
+    {
+        diag = get_implicit_diagonal( laplacian, job->lambda, point );
+
+        for_less( c, 0, nc )
+        {
+            index = point * nc + c;
+
+            job->values[index] += job->alpha[c] * job->direction[index];
+            job->residual[index] -= job->alpha[c] * job->product[index];
+
+            r = job->residual[index];
+            job->preconditioned[index] = r / diag;
+
+            sums1[c] += r * job->preconditioned[index];
+            sums2[c] += r * r;
+        }
+    }
+}
+
+/*--- direction = preconditioned + beta direction for the rows of a block */
+
+static  void  implicit_direction_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    laplacian_job_struct  *job;
+    int                   point, end_point, c, nc, index;
+
+    job = (laplacian_job_struct *) data;
+    nc = job->n_components;
+
+    end_point = MIN( job->laplacian->n_points,
+                     (block+1) * LAPLACIAN_BLOCK_SIZE );
+
+    for_less( point, block * LAPLACIAN_BLOCK_SIZE, end_point )
+    {
+        for_less( c, 0, nc )
+        {
+            index = point * nc + c;
+            job->direction[index] = job->preconditioned[index] +
+                                    job->beta[c] * job->direction[index];
+        }
+    }
+}
+
+/*--- adds up the partial sums of the blocks in order, so that the results
+      do not depend on the number of threads */
+
+static  void  add_block_sums(
+    int    n_blocks,
+    int    n_components,
+    Real   block_sums[],
+    Real   sums[] )
+{
+    int   block, c;
+
+    for_less( c, 0, n_components )
+        sums[c] = 0.0;
+
+    for_less( block, 0, n_blocks )
+    {
+        for_less( c, 0, n_components )
+            sums[c] += block_sums[block * n_components + c];
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : implicit_smooth_with_laplacian
+@INPUT      : laplacian
+              n_components    - number of values per point
+              values          - n_points * n_components values, point by
+                                point
+              lambda          - amount of smoothing, > 0
+              tolerance       - relative residual at which to stop
+              max_iterations
+              n_threads       - number of threads, or <= 0 for the default
+@OUTPUT     : values
+@RETURNS    : number of iterations done
+@DESCRIPTION: Smooths values on the points by one implicit step, solving
+              (D + lambda L) new_values = D values, the backward Euler
+              counterpart of smooth_with_laplacian(), which is stable for
+              any lambda.  One implicit step with a large lambda replaces
+              many explicit steps.  Each component is solved independently
+              until its residual is less than tolerance times the norm of
+              its right hand side.  Points without neighbours are unchanged.
+@METHOD     : Conjugate gradients preconditioned by the diagonal, each
+              iteration making three parallel passes over the rows, with
+              all components updated in the same passes.  The sums of the
+              blocks are added in order, so the results do not depend on
+              the number of threads.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  int  implicit_smooth_with_laplacian(
+    polygon_laplacian_struct  *laplacian,
+    int                       n_components,
+    Real                      values[],
+    Real                      lambda,
+    Real                      tolerance,
+    int                       max_iterations,
+    int                       n_threads )
+{
+    int                   point, c, nc, n_blocks, n_values, iteration;
+    int                   n_done, index;
+    Real                  *rz, *new_rz, *rr, *limit, *sums, diag;
+    BOOLEAN               *done;
+    laplacian_job_struct  job;
+
+    n_blocks = get_n_laplacian_blocks( laplacian );
+    if( n_blocks == 0 )
+        return( 0 );
+
+    n_threads = get_n_threads_to_use( n_threads, n_blocks );
+    nc = n_components;
+    n_values = laplacian->n_points * nc;
+
+    job.laplacian = laplacian;
+    job.n_components = nc;
+    job.lambda = lambda;
+    job.values = values;
+
+    ALLOC( job.residual, n_values );
+    ALLOC( job.preconditioned, n_values );
+    ALLOC( job.direction, n_values );
+    ALLOC( job.product, n_values );
+    ALLOC( job.alpha, nc );
+    ALLOC( job.beta, nc );
+    ALLOC( job.block_sums1, n_blocks * nc );
+    ALLOC( job.block_sums2, n_blocks * nc );
+    ALLOC( rz, nc );
+    ALLOC( new_rz, nc );
+    ALLOC( rr, nc );
+    ALLOC( limit, nc );
+    ALLOC( sums, nc );
+    ALLOC( done, nc );
+
+    /*--- starting from the unsmoothed values, the residual is
+          D values - (D + lambda L) values = -lambda L values */
+
+    for_less( c, 0, nc )
+    {
+        limit[c] = 0.0;
+        rz[c] = 0.0;
+    }
+
+    job.result = job.residual;
+    do_parallel_jobs( n_threads, n_blocks, multiply_block, (void *) &job );
+
+    for_less( point, 0, laplacian->n_points )
+    {
+        diag = get_implicit_diagonal( laplacian, lambda, point );
+
+        for_less( c, 0, nc )
+        {
+            index = point * nc + c;
+
+            if( laplacian->diagonal[point] > 0.0 )
+            {
+                limit[c] += laplacian->diagonal[point] * values[index] *
+                            laplacian->diagonal[point] * values[index];
+                job.residual[index] *= -lambda;
+            }
+            else
+            {
+                limit[c] += values[index] * values[index];
+                job.residual[index] = 0.0;
+            }
+
+            job.preconditioned[index] = job.residual[index] / diag;
+            job.direction[index] = job.preconditioned[index];
+            rz[c] += job.residual[index] * job.preconditioned[index];
+        }
+    }
+
+    n_done = 0;
+    for_less( c, 0, nc )
+    {
+        limit[c] = tolerance * tolerance * limit[c];
+        done[c] = (rz[c] <= 0.0);
+        if( done[c] )
+            ++n_done;
+    }
+
+    iteration = 0;
+
+    while( n_done < nc && iteration < max_iterations )
+    {
+        do_parallel_jobs( n_threads, n_blocks, implicit_product_block,
+                          (void *) &job );
+        add_block_sums( n_blocks, nc, job.block_sums1, sums );
+
+        for_less( c, 0, nc )
+        {
+            if( done[c] || sums[c] <= 0.0 )
+                job.alpha[c] = 0.0;
+            else
+                job.alpha[c] = rz[c] / sums[c];
+        }
+
+        do_parallel_jobs( n_threads, n_blocks, implicit_update_block,
+                          (void *) &job );
+        add_block_sums( n_blocks, nc, job.block_sums1, new_rz );
+        add_block_sums( n_blocks, nc, job.block_sums2, rr );
+
+        ++iteration;
+
+        for_less( c, 0, nc )
+        {
+            if( !done[c] && (job.alpha[c] == 0.0 || rr[c] <= limit[c] ||
+                             new_rz[c] <= 0.0) )
+            {
+                done[c] = TRUE;
+                ++n_done;
+            }
+
+            if( done[c] )
+                job.beta[c] = 0.0;
+            else
+                job.beta[c] = new_rz[c] / rz[c];
+
+            rz[c] = new_rz[c];
+        }
+
+        if( n_done < nc )
+        {
+            do_parallel_jobs( n_threads, n_blocks, implicit_direction_block,
+                              (void *) &job );
+        }
+    }
+
+    FREE( job.residual );
+    FREE( job.preconditioned );
+    FREE( job.direction );
+    FREE( job.product );
+    FREE( job.alpha );
+    FREE( job.beta );
+    FREE( job.block_sums1 );
+    FREE( job.block_sums2 );
+    FREE( rz );
+    FREE( new_rz );
+    FREE( rr );
+    FREE( limit );
+    FREE( sums );
+    FREE( done );
+
+    return( iteration );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : smooth_polygons_with_laplacian
+@INPUT      : polygons
+              laplacian       - created from the polygons
+              implicit_flag   - TRUE for one implicit step, FALSE for
+                                n_iterations explicit steps
+              lambda
+              n_iterations    - explicit steps, or maximum conjugate gradient
+                                iterations
+              tolerance       - relative residual for the implicit step
+              n_threads       - number of threads, or <= 0 for the default
+@OUTPUT     : polygons
+@RETURNS    :
+@DESCRIPTION: Smooths the points of the polygons with
+              smooth_with_laplacian() or implicit_smooth_with_laplacian().
+              The operator is not updated as the points move, so it can be
+              reused for further smoothing.  The normals are not updated.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  smooth_polygons_with_laplacian(
+    polygons_struct           *polygons,
+    polygon_laplacian_struct  *laplacian,
+    BOOLEAN                   implicit_flag,
+    Real                      lambda,
+    int                       n_iterations,
+    Real                      tolerance,
+    int                       n_threads )
+{
+    int    point, c;
+    Real   *values;
+
+    if( polygons->n_points <= 0 )
+        return;
+
+    ALLOC( values, 3 * polygons->n_points );
+
+    for_less( point, 0, polygons->n_points )
+    {
+        for_less( c, 0, N_DIMENSIONS )
+            values[3*point+c] = (Real) Point_coord( polygons->points[point],c);
+    }
+
+    if( implicit_flag )
+    {
+        (void) implicit_smooth_with_laplacian( laplacian, 3, values, lambda,
+                                               tolerance, n_iterations,
+                                               n_threads );
+    }
+    else
+    {
+        smooth_with_laplacian( laplacian, 3, values, lambda, n_iterations,
+                               n_threads );
+    }
+
+    for_less( point, 0, polygons->n_points )
+    {
+        fill_Point( polygons->points[point], values[3*point+0],
+                    values[3*point+1], values[3*point+2] );
+    }
+
+    FREE( values );
+}
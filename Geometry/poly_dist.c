@@ -18,6 +18,8 @@
 static char rcsid[] = "$Header: /private-cvsroot/libraries/bicpl/Geometry/poly_dist.c,v 1.10 2005-08-17 22:30:25 bert Exp $";
 #endif
 
+#define  TEMPORARY_BINTREE_FACTOR  0.3
+
 /* ----------------------------- MNI Header -----------------------------------
 @NAME       : sq_distance_between_points
 @INPUT      : p1
@@ -225,3 +227,57 @@ BICAPI  int  find_closest_polygon_point(
 
     return( closest_poly );
 }
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : find_closest_polygon_points
+@INPUT      : n_points
+              points
+              polygons
+              n_threads      - 0 for the default number of threads
+@OUTPUT     : closest_points
+              closest_polys
+@RETURNS    : 
+@DESCRIPTION: Finds the closest point on a polygons struct for each of an
+              array of points, as find_closest_polygon_point() does for one.
+              If the polygons have no bintree, a temporary one is built for
+              the queries.
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : find_closest_points_in_bintree
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  void  find_closest_polygon_points(
+    int                n_points,
+    Point              points[],
+    polygons_struct    *polygons,
+    int                n_threads,
+    Point              closest_points[],
+    int                closest_polys[] )
+{
+    BOOLEAN        temporary_bintree;
+    object_struct  object;
+
+    if( n_points <= 0 || polygons->n_items == 0 )
+        return;
+
+    temporary_bintree = (polygons->bintree == NULL);
+
+    if( temporary_bintree )
+    {
+        create_polygons_bintree( polygons,
+                                 ROUND( (Real) polygons->n_items *
+                                        TEMPORARY_BINTREE_FACTOR ) );
+    }
+
+    object.object_type = POLYGONS;
+    object.specific.polygons = *polygons;
+
+    find_closest_points_in_bintree( n_points, points, polygons->bintree,
+                                    &object, n_threads, closest_polys,
+                                    closest_points, NULL );
+
+    if( temporary_bintree )
+        delete_the_bintree( &polygons->bintree );
+}
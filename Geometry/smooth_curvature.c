@@ -25,6 +25,7 @@ static  int  get_smoothing_points(
     int               n_found,
     int               list[],
     Real              smoothing_distance,
+    BOOLEAN           limit_flag,
     float             distances[],
     Point             *smoothing_points[] );
 
@@ -115,7 +116,7 @@ BICAPI  Real  get_smooth_surface_curvature(
     n_smoothing_points = get_smoothing_points( polygons,
                                                n_neighbours, neighbours,
                                                n_found, list,
-                                               smoothing_distance,
+                                               smoothing_distance, FALSE,
                                                distances, &smoothing_points );
 
     if( alloced_distances )
@@ -147,10 +148,85 @@ BICAPI  Real  get_smooth_surface_curvature(
     return( curvature );
 }
 
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_smooth_surface_curvatures_in_workspace
+@INPUT      : workspace
+              poly
+              vertex
+              n_distances
+              smoothing_distances
+@OUTPUT     : curvatures
+@RETURNS    : 
+@DESCRIPTION: Computes the smooth surface curvature of a vertex for several
+              smoothing distances, as get_smooth_surface_curvature(), with
+              one geodesic search to the largest distance, using a geodesic
+              workspace rather than a distances array shared between calls,
+              so that calls with different workspaces may run in parallel.
+              For the largest distance, the result is the one of
+              get_smooth_surface_curvature(), up to the order in which the
+              smoothing points are summed.
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  void  get_smooth_surface_curvatures_in_workspace(
+    geodesic_workspace_struct  *workspace,
+    int                        poly,
+    int                        vertex,
+    int                        n_distances,
+    Real                       smoothing_distances[],
+    Real                       curvatures[] )
+{
+    polygons_struct  *polygons;
+    int              d, n_smoothing_points, point_index, n_found;
+    Real             max_distance;
+    Point            *smoothing_points;
+
+    polygons = workspace->polygons;
+
+    point_index = polygons->indices[
+                  POINT_INDEX(polygons->end_indices,poly,vertex)];
+
+    max_distance = smoothing_distances[0];
+    for_less( d, 1, n_distances )
+        max_distance = MAX( max_distance, smoothing_distances[d] );
+
+    n_found = compute_geodesic_distances( workspace,
+                                          &polygons->points[point_index],
+                                          poly, max_distance );
+
+    for_less( d, 0, n_distances )
+    {
+        n_smoothing_points = get_smoothing_points( polygons,
+                                   workspace->n_neighbours,
+                                   workspace->neighbours,
+                                   n_found, workspace->list,
+                                   smoothing_distances[d],
+                                   smoothing_distances[d] < max_distance,
+                                   workspace->distances, &smoothing_points );
+
+        if( n_smoothing_points > 0 )
+        {
+            curvatures[d] = get_average_curvature(
+                                           &polygons->points[point_index],
+                                           &polygons->normals[point_index],
+                                           n_smoothing_points,
+                                           smoothing_points );
+            FREE( smoothing_points );
+        }
+        else
+            curvatures[d] = 0.0;
+    }
+}
+
 /* ----------------------------- MNI Header -----------------------------------
 @NAME       : get_smoothing_points
 @INPUT      : polygons
               smoothing_distance
+              limit_flag
 @OUTPUT     : distances
               smoothing_points
 @RETURNS    : 
@@ -159,7 +235,7 @@ BICAPI  Real  get_smooth_surface_curvature(
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1994    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 /*! \brief Return intersection of disc with mesh edges.
  *
@@ -168,6 +244,10 @@ BICAPI  Real  get_smooth_surface_curvature(
  * are approximately geodesic.  The array \a distances must be
  * filled in with distances from the start point, or -1 to indicate
  * that the vertex lies at distance greater than \a smoothing_distance.
+ *
+ * If \a limit_flag is true, the distances may have been computed to a
+ * larger distance, and vertices further than \a smoothing_distance are
+ * also treated as outside the disc.
  */
 static  int  get_smoothing_points(
     polygons_struct   *polygons,
@@ -176,6 +256,7 @@ static  int  get_smoothing_points(
     int               n_found,
     int               list[],
     Real              smoothing_distance,
+    BOOLEAN           limit_flag,
     float             distances[],
     Point             *smoothing_points[] )
 {
@@ -193,6 +274,9 @@ static  int  get_smoothing_points(
         if( distances[point_index] < 0.0f )
             handle_internal_error( "get_smoothing_points" );
 
+        if( limit_flag && (Real) distances[point_index] > smoothing_distance )
+            continue;
+
         for_less( neigh, 0, n_neighbours[point_index] )
         {
             prev_index = neighbours[point_index][neigh];
@@ -204,7 +288,9 @@ static  int  get_smoothing_points(
 	       i.e. it is further from the initial point than the maximum
 	       distance.
 	    */
-            if( distances[prev_index] < 0.0f )
+            if( distances[prev_index] < 0.0f ||
+                (limit_flag &&
+                 (Real) distances[prev_index] > smoothing_distance) )
             {
                 inside = point_index;
                 outside = prev_index;
@@ -20,20 +20,39 @@ static char rcsid[] = "$Header: /private-cvsroot/libraries/bicpl/Geometry/smooth
 
 #define  CHECK_INTERVAL     1.0
 
+/*--- the points are smoothed in blocks of this size, each block being one
+      parallel job */
+
+#define  SMOOTH_BLOCK_SIZE  1024
+
+typedef  struct
+{
+    polygons_struct  *polygons;
+    int              *point_polys;
+    int              *point_vertices;
+    Point            *current_points;
+    Point            *new_points;
+    Real             max_dist_from_original;
+    Real             fraction_to_move;
+    Real             normal_ratio;
+    BOOLEAN          range_flag;
+    volume_struct    *volume;
+    int              min_value;
+    int              max_value;
+    Real             *block_sum_moved;
+    Real             *block_max_moved;
+} smooth_job_struct;
+
+typedef  struct
+{
+    Real   next_check_time;
+} interrupt_check_struct;
+
 static  void  smooth_points(
-    polygons_struct  *polygons,
-    Point            current_points[],
-    Point            new_points[],
-    Smallest_int     point_done[],
-    Real             max_dist_from_original,
-    Real             fraction_to_move,
-    Real             normal_ratio,
-    BOOLEAN          range_flag,
-    volume_struct    *volume,
-    int              min_value,
-    int              max_value,
-    Real             *avg_moved,
-    Real             *max_moved );
+    smooth_job_struct  *job,
+    int                n_threads,
+    Real               *avg_moved,
+    Real               *max_moved );
 static  Real  update_point_position(
     polygons_struct  *polygons,
     int              poly,
@@ -54,6 +73,37 @@ static  BOOLEAN   point_inside_range(
     int            min_value,
     int            max_value );
 
+/*--- the monitor used by smooth_polygon(), printing the movement of each
+      iteration and stopping if a file called interrupt appears */
+
+static  BOOLEAN  print_and_check_interrupt(
+    void   *data,
+    int    iteration,
+    Real   avg_moved,
+    Real   max_moved )
+{
+    interrupt_check_struct  *check;
+
+    check = (interrupt_check_struct *) data;
+
+    print( "Iteration %d -- avg distance %g  max distance %g\n",
+           iteration, avg_moved, max_moved );
+
+    if( current_realtime_seconds() > check->next_check_time )
+    {
+        check->next_check_time = current_realtime_seconds() + CHECK_INTERVAL;
+
+        if( file_exists("interrupt") )
+        {
+            print( "Interrupting as requested\n" );
+            remove_file( "interrupt" );
+            return( FALSE );
+        }
+    }
+
+    return( TRUE );
+}
+
 /* ----------------------------- MNI Header -----------------------------------
 @NAME       : smooth_polygon
 @INPUT      : polygons
@@ -68,12 +118,14 @@ static  BOOLEAN   point_inside_range(
 @OUTPUT     : 
 @RETURNS    : 
 @DESCRIPTION: Smooths the polygons by moving vertices towards the centroid
-              of their neighbours.
+              of their neighbours, printing the movement of each iteration.
+              Creating a file called interrupt in the current directory
+              stops the smoothing early.
 @METHOD     : 
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1993    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 
 BICAPI  void  smooth_polygon(
@@ -86,152 +138,243 @@ BICAPI  void  smooth_polygon(
     volume_struct    *volume,
     int              min_value,
     int              max_value )
+{
+    interrupt_check_struct  check;
+
+    check.next_check_time = current_realtime_seconds() + CHECK_INTERVAL;
+
+    (void) smooth_polygon_with_monitor( polygons, max_dist_from_original,
+                                        fraction_to_move, stop_threshold,
+                                        normal_ratio, range_flag, volume,
+                                        min_value, max_value, 0,
+                                        print_and_check_interrupt,
+                                        (void *) &check );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : smooth_polygon_with_monitor
+@INPUT      : polygons
+              max_dist_from_original
+              fraction_to_move
+              stop_threshold
+              normal_ratio
+              range_flag
+              volume
+              min_value
+              max_value
+              n_threads      - number of threads, or <= 0 for the default
+              monitor        - called after each iteration, or NULL
+              monitor_data
+@OUTPUT     : 
+@RETURNS    : number of iterations done
+@DESCRIPTION: Smooths the polygons by moving vertices towards the centroid
+              of their neighbours, until no vertex moves more than
+              stop_threshold in an iteration.  After each iteration, the
+              monitor is passed the iteration number and the average and
+              maximum distance moved, and stops the smoothing by returning
+              FALSE.  Nothing is printed.
+@METHOD     : Each iteration computes the new positions from those of the
+              previous iteration only, so the points are updated in
+              parallel blocks.  The results do not depend on the number of
+              threads.  If the range is checked in a cached volume, a
+              single thread is used.
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  int  smooth_polygon_with_monitor(
+    polygons_struct             *polygons,
+    Real                        max_dist_from_original,
+    Real                        fraction_to_move,
+    Real                        stop_threshold,
+    Real                        normal_ratio,
+    BOOLEAN                     range_flag,
+    volume_struct               *volume,
+    int                         min_value,
+    int                         max_value,
+    int                         n_threads,
+    smooth_polygon_monitor_func monitor,
+    void                        *monitor_data )
 {
     Real               avg_moved, max_moved;
-    int                i, iteration;
-    Point              *new_points, *tmp, *current_points;
-    Smallest_int       *point_done;
-    Real               next_check_time;
+    int                i, iteration, poly, vertex, size, point_index;
+    int                n_blocks;
+    Point              *tmp;
+    smooth_job_struct  job;
 
     if( polygons->n_points <= 0 )
-        return;
-
-    ALLOC( new_points, polygons->n_points );
-    ALLOC( current_points, polygons->n_points );
-    ALLOC( point_done, polygons->n_points );
+        return( 0 );
 
     check_polygons_neighbours_computed( polygons );
 
+    job.polygons = polygons;
+    job.max_dist_from_original = max_dist_from_original;
+    job.fraction_to_move = fraction_to_move;
+    job.normal_ratio = normal_ratio;
+    job.range_flag = range_flag;
+    job.volume = volume;
+    job.min_value = min_value;
+    job.max_value = max_value;
+
+    /*--- each point is smoothed from the first polygon containing it */
+
+    ALLOC( job.point_polys, polygons->n_points );
+    ALLOC( job.point_vertices, polygons->n_points );
+
     for_less( i, 0, polygons->n_points )
+        job.point_polys[i] = -1;
+
+    for_less( poly, 0, polygons->n_items )
     {
-        current_points[i] = polygons->points[i];
+        size = GET_OBJECT_SIZE( *polygons, poly );
+
+        for_less( vertex, 0, size )
+        {
+            point_index = polygons->indices[
+                          POINT_INDEX(polygons->end_indices,poly,vertex)];
+
+            if( job.point_polys[point_index] < 0 )
+            {
+                job.point_polys[point_index] = poly;
+                job.point_vertices[point_index] = vertex;
+            }
+        }
     }
 
+    n_blocks = (polygons->n_points + SMOOTH_BLOCK_SIZE - 1) /
+               SMOOTH_BLOCK_SIZE;
+
+    /*--- cached volumes cannot be read from several threads at once */
+
+    if( range_flag && volume->is_cached_volume )
+        n_threads = 1;
+
+    n_threads = get_n_threads_to_use( n_threads, n_blocks );
+
+    ALLOC( job.new_points, polygons->n_points );
+    ALLOC( job.current_points, polygons->n_points );
+    ALLOC( job.block_sum_moved, n_blocks );
+    ALLOC( job.block_max_moved, n_blocks );
+
+    for_less( i, 0, polygons->n_points )
+        job.current_points[i] = polygons->points[i];
+
     iteration = 0;
-    next_check_time = current_realtime_seconds() + CHECK_INTERVAL;
     do
     {
-        smooth_points( polygons, current_points, new_points, point_done,
-                       max_dist_from_original, fraction_to_move,
-                       normal_ratio, range_flag,
-                       volume, min_value, max_value,
-                       &avg_moved, &max_moved );
+        smooth_points( &job, n_threads, &avg_moved, &max_moved );
 
-        tmp = current_points;
-        current_points = new_points;
-        new_points = tmp;
+        tmp = job.current_points;
+        job.current_points = job.new_points;
+        job.new_points = tmp;
 
         ++iteration;
 
-        print( "Iteration %d -- avg distance %g  max distance %g\n",
-               iteration, avg_moved, max_moved );
-        if( current_realtime_seconds() > next_check_time )
-        {
-            next_check_time = current_realtime_seconds() + CHECK_INTERVAL;
-
-            if( file_exists("interrupt") )
-            {
-                print( "Interrupting as requested\n" );
-                remove_file( "interrupt" );
-                break;
-            }
-        }
+        if( monitor != NULL &&
+            !(*monitor)( monitor_data, iteration, avg_moved, max_moved ) )
+            break;
     }
     while( max_moved > stop_threshold );
 
     for_less( i, 0, polygons->n_points )
-        polygons->points[i] = current_points[i];
+        polygons->points[i] = job.current_points[i];
 
-    FREE( new_points );
-    FREE( current_points );
-    FREE( point_done );
+    FREE( job.new_points );
+    FREE( job.current_points );
+    FREE( job.block_sum_moved );
+    FREE( job.block_max_moved );
+    FREE( job.point_polys );
+    FREE( job.point_vertices );
+
+    return( iteration );
+}
+
+/*--- smooths the points of one block, from current_points to new_points,
+      recording the total and maximum movement of the block */
+
+static  void  smooth_points_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    smooth_job_struct  *job;
+    int                p, end_point;
+    Real               moved, sum_moved, max_moved;
+
+    job = (smooth_job_struct *) data;
+
+    end_point = MIN( job->polygons->n_points, (block+1) * SMOOTH_BLOCK_SIZE );
+
+    sum_moved = 0.0;
+    max_moved = 0.0;
+
+    for_less( p, block * SMOOTH_BLOCK_SIZE, end_point )
+    {
+        job->new_points[p] = job->current_points[p];
+
+        if( job->point_polys[p] < 0 )
+            continue;
+
+        moved = update_point_position( job->polygons, job->point_polys[p],
+                        job->point_vertices[p], p, job->current_points,
+                        &job->new_points[p], job->max_dist_from_original,
+                        job->fraction_to_move, job->normal_ratio,
+                        job->range_flag, job->volume, job->min_value,
+                        job->max_value );
+
+        sum_moved += moved;
+        if( moved > max_moved )
+            max_moved = moved;
+    }
+
+    job->block_sum_moved[block] = sum_moved;
+    job->block_max_moved[block] = max_moved;
 }
 
 /* ----------------------------- MNI Header -----------------------------------
 @NAME       : smooth_points
-@INPUT      : polygons
-              current_points[]
-              new_points
-              point_done
-              max_dist_from_original
-              fraction_to_move
-              normal_ratio
-              range_flag
-              volume
-              min_value
-              max_value
+@INPUT      : job
+              n_threads
 @OUTPUT     : avg_moved
               max_moved
 @RETURNS    : 
-@DESCRIPTION: 
+@DESCRIPTION: Does one iteration of smoothing, from job->current_points to
+              job->new_points, in parallel blocks of points.  The movements
+              of the blocks are combined in order, so the results are the
+              same for any number of threads.
 @METHOD     : 
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1993    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 
 static  void  smooth_points(
-    polygons_struct  *polygons,
-    Point            current_points[],
-    Point            new_points[],
-    Smallest_int     point_done[],
-    Real             max_dist_from_original,
-    Real             fraction_to_move,
-    Real             normal_ratio,
-    BOOLEAN          range_flag,
-    volume_struct    *volume,
-    int              min_value,
-    int              max_value,
-    Real             *avg_moved,
-    Real             *max_moved )
+    smooth_job_struct  *job,
+    int                n_threads,
+    Real               *avg_moved,
+    Real               *max_moved )
 {
-    int              p, vertex_index, point_index, poly, size;
-    progress_struct  progress;
-    Real             moved;
+    int    block, n_blocks;
 
-    for_less( p, 0, polygons->n_points )
-    {
-        new_points[p] = current_points[p];
-        point_done[p] = FALSE;
-    }
+    n_blocks = (job->polygons->n_points + SMOOTH_BLOCK_SIZE - 1) /
+               SMOOTH_BLOCK_SIZE;
+
+    do_parallel_jobs( n_threads, n_blocks, smooth_points_block, (void *) job );
 
     *avg_moved = 0.0;
     *max_moved = 0.0;
 
-    initialize_progress_report( &progress, TRUE, polygons->n_items,
-                                "Averaging Points" );
-
-    for_less( poly, 0, polygons->n_items )
+    for_less( block, 0, n_blocks )
     {
-        size = GET_OBJECT_SIZE( *polygons, poly );
-
-        for_less( vertex_index, 0, size )
-        {
-            point_index = polygons->indices[
-                          POINT_INDEX(polygons->end_indices,poly,vertex_index)];
-
-            if( !point_done[point_index] )
-            {
-                point_done[point_index] = TRUE;
-
-                moved = update_point_position( polygons, poly, vertex_index,
-                        point_index, current_points, &new_points[point_index],
-                        max_dist_from_original, fraction_to_move, normal_ratio,
-                        range_flag, volume, min_value, max_value );
-
-                *avg_moved += moved;
-                if( moved > *max_moved )
-                    *max_moved = moved;
-            }
-        }
-
-        update_progress_report( &progress, poly+1 );
+        *avg_moved += job->block_sum_moved[block];
+        if( job->block_max_moved[block] > *max_moved )
+            *max_moved = job->block_max_moved[block];
     }
 
-    terminate_progress_report( &progress );
-
-    *avg_moved /= (Real) polygons->n_points;
+    *avg_moved /= (Real) job->polygons->n_points;
 }
 
 #define  MAX_NEIGHBOURS   100
@@ -68,13 +68,86 @@ typedef  struct
     float    limits[N_DIMENSIONS][2];
 } range_struct;
 
+/**
+ * A bounding volume hierarchy, used in place of the tree of
+ * bintree_node_struct when a bintree is built with create_object_bvh().
+ * The nodes are stored depth first in one array, aligned on cache lines,
+ * the left child of an internal node being the next node.
+ **/
+
+#define  BVH_NODE_ALIGNMENT      64
+
+typedef  struct
+{
+    float    limits[N_DIMENSIONS][2];
+    int      offset;       /* --- leaf: first object in the object list,
+                                  internal: index of the right child */
+    int      n_objects;    /* --- leaf: number of objects, >= 0,
+                                  internal: -1 - split axis */
+} bvh_node_struct;
+
+typedef  struct
+{
+    int              n_nodes;
+    bvh_node_struct  *nodes;
+    char             *nodes_alloc;
+    int              n_objects;
+    int              *object_list;  /* --- objects in the order of the leaves */
+    void             *mapping;      /* --- if not NULL, the nodes and object
+                                           list are in this mapping of a
+                                           bintree cache file */
+    size_t           mapping_size;
+} bvh_struct;
+
+/**
+ * A packet of rays traced together by intersect_rays_with_bintree().
+ * The coordinates are stored by axis, so the same test is applied to
+ * every ray of the packet in one loop, which the compiler can vectorize.
+ * RAY_PACKET_SIZE may be defined as 8 or 16 when building the library.
+ **/
+
+#ifndef  RAY_PACKET_SIZE
+#define  RAY_PACKET_SIZE         4
+#endif
+
+#define  RAY_PACKET_INFINITY     1.0e300
+
+typedef  struct
+{
+    int      n_rays;
+    Point    *origins;       /* --- the rays of the packet, as given */
+    Vector   *directions;
+    Real     origin[N_DIMENSIONS][RAY_PACKET_SIZE];
+    Real     direction[N_DIMENSIONS][RAY_PACKET_SIZE];
+    Real     inv_direction[N_DIMENSIONS][RAY_PACKET_SIZE];
+                             /* --- RAY_PACKET_INFINITY where the
+                                    direction is zero */
+} ray_packet_struct;
+
 typedef  struct
 {
     range_struct         range;
     int                  n_nodes;
     bintree_node_struct  *root;
+    bvh_struct           *bvh;
 } bintree_struct;
 
 typedef  bintree_struct  *bintree_struct_ptr;
 
+/**
+ * Tracks the efficiency of a bintree refitted as its objects move,
+ * so that it is rebuilt only when it has degraded enough.
+ **/
+
+typedef  struct
+{
+    int      max_nodes;      /* --- used when rebuilding */
+    Real     threshold;      /* --- rebuild when the cost exceeds
+                                    threshold * initial_cost */
+    Real     initial_cost;
+    Real     cost;
+    int      n_refits;
+    int      n_rebuilds;
+} bintree_quality_struct;
+
 #endif
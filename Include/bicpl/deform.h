@@ -86,10 +86,12 @@ voxel_lin_coef_struct;
 
 typedef struct
 {
-    hash_table_struct      hash;
-    int                    n_in_hash;
-    voxel_lin_coef_struct  *head;
-    voxel_lin_coef_struct  *tail;
+    hash_table_struct          hash;
+    int                        n_in_hash;
+    voxel_lin_coef_struct      *head;
+    voxel_lin_coef_struct      *tail;
+    spline_coef_volume_struct  *spline_coefs;
+    minmax_pyramid_struct      *minmax_pyramid;
 } voxel_coef_struct;
 
 #define  N_DEFORM_HISTOGRAM   7
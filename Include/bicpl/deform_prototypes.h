@@ -208,6 +208,23 @@ BICAPI  BOOLEAN  is_point_inside_surface(
     Vector                      *direction,
     boundary_definition_struct  *boundary_def );
 
+BICAPI  void  evaluate_volume_with_lookup(
+    voxel_coef_struct           *lookup,
+    Volume                      volume,
+    int                         degrees_continuity,
+    Real                        voxel[],
+    Real                        *value,
+    Real                        derivs[] );
+
+BICAPI  BOOLEAN  is_point_inside_surface_with_lookup(
+    voxel_coef_struct           *lookup,
+    Volume                      volume,
+    Volume                      label_volume,
+    int                         continuity,
+    Real                        voxel[],
+    Vector                      *direction,
+    boundary_definition_struct  *boundary_def );
+
 BICAPI  void   get_centre_of_cube(
     Point       *cube,
     int         sizes[3],
@@ -257,6 +274,14 @@ BICAPI  void  set_boundary_definition(
 BICAPI  void  initialize_lookup_volume_coeficients(
     voxel_coef_struct  *lookup );
 
+BICAPI  void  set_lookup_spline_coef_volume(
+    voxel_coef_struct          *lookup,
+    spline_coef_volume_struct  *spline_coefs );
+
+BICAPI  void  set_lookup_minmax_pyramid(
+    voxel_coef_struct      *lookup,
+    minmax_pyramid_struct  *pyramid );
+
 BICAPI  void  lookup_volume_coeficients(
     voxel_coef_struct  *lookup,
     Volume             volume,
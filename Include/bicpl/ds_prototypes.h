@@ -80,6 +80,25 @@ BICAPI  Status  io_bintree(
     File_formats         format,
     bintree_struct_ptr   bintree );
 
+BICAPI  void  set_bintree_cache_directory(
+    STRING  directory );
+
+BICAPI  STRING  get_bintree_cache_directory( void );
+
+BICAPI  BOOLEAN  input_polygons_bintree_cache(
+    polygons_struct      *polygons,
+    int                  max_nodes,
+    bintree_struct_ptr   bintree );
+
+BICAPI  Status  output_polygons_bintree_cache(
+    polygons_struct      *polygons,
+    int                  max_nodes,
+    bintree_struct_ptr   bintree );
+
+BICAPI  void  unmap_bintree_cache_file(
+    void     *mapping,
+    size_t   mapping_size );
+
 BICAPI  void  create_bitlist(
     int             n_bits,
     bitlist_struct  *bitlist );
@@ -152,6 +171,82 @@ BICAPI  void  evaluate_bintree_efficiency(
     Real                 *avg_nodes_visited,
     Real                 *avg_objects_visited );
 
+BICAPI  void  refit_object_bintree(
+    int                  n_objects,
+    range_struct         bound_vols[],
+    bintree_struct_ptr   bintree );
+
+BICAPI  void  initialize_bintree_quality(
+    bintree_quality_struct  *quality,
+    bintree_struct_ptr      bintree,
+    int                     max_nodes,
+    Real                    threshold );
+
+BICAPI  BOOLEAN  bintree_needs_rebuild(
+    bintree_quality_struct  *quality,
+    bintree_struct_ptr      bintree );
+
+BICAPI  void  create_object_bvh(
+    int                  n_objects,
+    range_struct         bound_vols[],
+    bintree_struct_ptr   bintree,
+    int                  max_nodes );
+
+BICAPI  void  refit_bvh(
+    int                  n_objects,
+    range_struct         bound_vols[],
+    bintree_struct_ptr   bintree );
+
+BICAPI  void  delete_bvh(
+    bvh_struct  *bvh );
+
+BICAPI  BOOLEAN  bvh_is_valid(
+    bvh_struct  *bvh );
+
+BICAPI  void  evaluate_bvh_efficiency(
+    bvh_struct   *bvh,
+    Real         *avg_nodes_visited,
+    Real         *avg_objects_visited );
+
+BICAPI  Real  find_closest_point_in_bvh(
+    Point               *point,
+    bvh_struct          *bvh,
+    object_struct       *object,
+    int                 *obj_index,
+    Point               *point_on_object );
+
+BICAPI  void  search_closest_point_in_bvh(
+    Point               *point,
+    bvh_struct          *bvh,
+    object_struct       *object,
+    Real                *closest_dist,
+    int                 *obj_index,
+    Point               *point_on_object );
+
+BICAPI  Real  find_closest_vertex_in_bvh(
+    Point               *point,
+    bvh_struct          *bvh,
+    object_struct       *object,
+    int                 *vertex_on_object );
+
+BICAPI  int  intersect_ray_with_bvh(
+    Point               *origin,
+    Vector              *direction,
+    bvh_struct          *bvh,
+    object_struct       *object,
+    int                 *obj_index,
+    Real                *dist,
+    Real                *distances[] );
+
+BICAPI  void  intersect_ray_packet_with_bvh(
+    ray_packet_struct   *packet,
+    bvh_struct          *bvh,
+    object_struct       *object,
+    int                 obj_indices[],
+    Real                dists[],
+    int                 n_intersections[],
+    Real                *distances[] );
+
 BICAPI   void  initialize_hash_table(
     hash_table_struct  *hash_table,
     int                size,
@@ -234,6 +329,11 @@ BICAPI  void  delete_the_bintree(
 
 BICAPI  bintree_struct_ptr allocate_bintree( void );
 
+BICAPI  void  set_polygons_bvh_flag(
+    BOOLEAN  value );
+
+BICAPI  BOOLEAN  get_polygons_bvh_flag( void );
+
 BICAPI  void  create_lines_bintree(
     lines_struct   *lines,
     int            max_nodes );
@@ -242,6 +342,13 @@ BICAPI  void  create_polygons_bintree(
     polygons_struct   *polygons,
     int               max_nodes );
 
+BICAPI  void  refit_polygons_bintree(
+    polygons_struct   *polygons );
+
+BICAPI  BOOLEAN  update_polygons_bintree(
+    polygons_struct          *polygons,
+    bintree_quality_struct   *quality );
+
 BICAPI  void  create_quadmesh_bintree(
     quadmesh_struct   *quadmesh,
     int               max_nodes );
@@ -259,6 +366,16 @@ BICAPI  Real  find_closest_vertex_in_bintree(
     object_struct       *object,
     int                 *vertex_on_object );
 
+BICAPI  void  find_closest_points_in_bintree(
+    int                 n_points,
+    Point               points[],
+    bintree_struct_ptr  bintree,
+    object_struct       *object,
+    int                 n_threads,
+    int                 obj_indices[],
+    Point               points_on_object[],
+    Real                dists[] );
+
 BICAPI  void  print_bintree_stats(
     int   n_objects );
 
@@ -271,6 +388,17 @@ BICAPI  int  intersect_ray_with_bintree(
     Real                *dist,
     Real                *distances[] );
 
+BICAPI  void  intersect_rays_with_bintree(
+    int                 n_rays,
+    Point               origins[],
+    Vector              directions[],
+    bintree_struct_ptr  bintree,
+    object_struct       *object,
+    int                 obj_indices[],
+    Real                dists[],
+    int                 n_intersections[],
+    Real                *distances[] );
+
 BICAPI  BOOLEAN  ray_intersects_range(
     range_struct  *range,
     Point         *origin,
@@ -19,6 +19,67 @@
 #include  <volume_io.h>
 #include  <bicpl/objects.h>
 
+/*! \brief Reusable storage for geodesic distance computations.
+ *
+ * Created by initialize_geodesic_workspace() for one set of polygons and
+ * its point neighbours, then passed to compute_geodesic_distances() for
+ * each source.  After a computation, list[0] to list[n_found-1] are the
+ * points reached and distances[] holds their distances, every other entry
+ * being -1.  Only the points reached are reset by the next computation.
+ *
+ * The points waiting to be visited are kept in a circular array of
+ * buckets of distance, each a doubly linked list threaded through
+ * bucket_next and bucket_prev.
+ */
+typedef  struct
+{
+    polygons_struct  *polygons;
+    int              *n_neighbours;
+    int              **neighbours;
+
+    float            *distances;
+    int              n_found;
+    int              *list;
+
+    Real             bucket_width;
+    int              n_buckets;
+    int              *buckets;          /* --- first point in each bucket */
+    int              *point_buckets;    /* --- bucket of each point, or -1 */
+    int              *bucket_next;
+    int              *bucket_prev;
+} geodesic_workspace_struct;
+
+/*! \brief Kinds of weights of polygon_laplacian_struct. */
+typedef  enum  { UNIFORM_LAPLACIAN, COTANGENT_LAPLACIAN }  Laplacian_types;
+
+/*! \brief The Laplacian of polygons, L = D - W, in compressed sparse row
+ * form.
+ *
+ * Created by create_polygons_laplacian().  The weights of the edges from
+ * point p are weights[offsets[p]] to weights[offsets[p+1]-1], to the
+ * points in the same positions of columns[].  diagonal[p] is the sum of
+ * the weights of point p.
+ */
+typedef  struct
+{
+    Laplacian_types  type;
+    int              n_points;
+    int              *offsets;          /* --- n_points + 1 */
+    int              *columns;
+    Real             *weights;
+    Real             *diagonal;
+} polygon_laplacian_struct;
+
+/*! \brief Monitor of smooth_polygon_with_monitor().
+ *
+ * Called after each iteration with the iteration number, counting from 1,
+ * and the average and maximum distance moved by the points.  Returning
+ * FALSE stops the smoothing.
+ */
+typedef  BOOLEAN  (*smooth_polygon_monitor_func)( void *data, int iteration,
+                                                  Real avg_moved,
+                                                  Real max_moved );
+
 #include  <bicpl/geom_prototypes.h>
 
 #endif
@@ -82,6 +82,16 @@ BICAPI  Real  find_closest_vertex_on_object(
     object_struct   *object,
     int             *vertex_on_object );
 
+BICAPI  void  get_polygon_vertex_curvatures_at_distances(
+    polygons_struct   *polygons,
+    int               n_neighbours[],
+    int               *neighbours[],
+    int               n_distances,
+    Real              smoothing_distances[],
+    Real              low_threshold,
+    int               n_threads,
+    Real              *curvatures[] );
+
 BICAPI  void  get_polygon_vertex_curvatures(
     polygons_struct   *polygons,
     int               n_neighbours[],
@@ -90,6 +100,15 @@ BICAPI  void  get_polygon_vertex_curvatures(
     Real              low_threshold,
     Real              curvatures[] );
 
+BICAPI  int  compute_fast_marching_distances_from_point(
+    polygons_struct   *polygons,
+    Point             *point,
+    int               poly,
+    Real              max_distance,
+    BOOLEAN           distances_initialized,
+    float             distances[],
+    int               *list[] );
+
 BICAPI  void  flatten_around_vertex(
     Point     *vertex,
     int       n_neighbours,
@@ -118,6 +137,34 @@ BICAPI  int  compute_distances_from_point(
     float             distances[],
     int               *list[] ) ;
 
+BICAPI  void  initialize_geodesic_workspace(
+    geodesic_workspace_struct  *workspace,
+    polygons_struct            *polygons,
+    int                        n_neighbours[],
+    int                        *neighbours[] );
+
+BICAPI  void  delete_geodesic_workspace(
+    geodesic_workspace_struct  *workspace );
+
+BICAPI  int  compute_geodesic_distances(
+    geodesic_workspace_struct  *workspace,
+    Point                      *point,
+    int                        poly,
+    Real                       max_distance );
+
+BICAPI  void  compute_geodesic_distances_from_points(
+    polygons_struct   *polygons,
+    int               n_neighbours[],
+    int               *neighbours[],
+    int               n_sources,
+    int               source_points[],
+    int               source_polys[],
+    Real              max_distance,
+    int               n_threads,
+    void              (*func)( void *data, int source, int thread,
+                               geodesic_workspace_struct *workspace ),
+    void              *func_data );
+
 BICAPI  void  find_polygon_normal_no_normalize(
     int      n_points,
     Point    points[],
@@ -172,6 +219,48 @@ BICAPI  BOOLEAN  clip_line_to_box(
     Real     *t_min,
     Real     *t_max );
 
+BICAPI  void  create_polygons_laplacian(
+    polygons_struct           *polygons,
+    Laplacian_types           type,
+    int                       n_threads,
+    polygon_laplacian_struct  *laplacian );
+
+BICAPI  void  delete_polygons_laplacian(
+    polygon_laplacian_struct  *laplacian );
+
+BICAPI  void  multiply_by_laplacian(
+    polygon_laplacian_struct  *laplacian,
+    int                       n_components,
+    Real                      values[],
+    Real                      result[],
+    int                       n_threads );
+
+BICAPI  void  smooth_with_laplacian(
+    polygon_laplacian_struct  *laplacian,
+    int                       n_components,
+    Real                      values[],
+    Real                      lambda,
+    int                       n_iterations,
+    int                       n_threads );
+
+BICAPI  int  implicit_smooth_with_laplacian(
+    polygon_laplacian_struct  *laplacian,
+    int                       n_components,
+    Real                      values[],
+    Real                      lambda,
+    Real                      tolerance,
+    int                       max_iterations,
+    int                       n_threads );
+
+BICAPI  void  smooth_polygons_with_laplacian(
+    polygons_struct           *polygons,
+    polygon_laplacian_struct  *laplacian,
+    BOOLEAN                   implicit_flag,
+    Real                      lambda,
+    int                       n_iterations,
+    Real                      tolerance,
+    int                       n_threads );
+
 BICAPI  void  create_line_circle(
     Point            *centre,
     int              plane_axis,
@@ -328,6 +417,14 @@ BICAPI  int  find_closest_polygon_point(
     polygons_struct    *polygons,
     Point              *closest_point );
 
+BICAPI  void  find_closest_polygon_points(
+    int                n_points,
+    Point              points[],
+    polygons_struct    *polygons,
+    int                n_threads,
+    Point              closest_points[],
+    int                closest_polys[] );
+
 BICAPI  void  create_polygons_sphere(
     Point            *centre,
     Real             x_size,
@@ -395,6 +492,16 @@ BICAPI  void  intersect_ray_object(
     int                   *n_intersections,
     Real                  *distances[] );
 
+BICAPI  void  intersect_ray_packet_object(
+    ray_packet_struct     *packet,
+    int                   active[],
+    object_struct         *object,
+    int                   obj_index,
+    int                   closest_obj_indices[],
+    Real                  closest_dists[],
+    int                   n_intersections[],
+    Real                  *distances[] );
+
 BICAPI  int  intersect_ray_with_object(
     Point           *origin,
     Vector          *direction,
@@ -417,6 +524,14 @@ BICAPI  Real  get_smooth_surface_curvature(
     float             distances[],
     Real              smoothing_distance );
 
+BICAPI  void  get_smooth_surface_curvatures_in_workspace(
+    geodesic_workspace_struct  *workspace,
+    int                        poly,
+    int                        vertex,
+    int                        n_distances,
+    Real                       smoothing_distances[],
+    Real                       curvatures[] );
+
 BICAPI  void  smooth_lines(
     lines_struct  *lines,
     Real          smooth_length );
@@ -437,6 +552,20 @@ BICAPI  void  smooth_polygon(
     int              min_value,
     int              max_value );
 
+BICAPI  int  smooth_polygon_with_monitor(
+    polygons_struct             *polygons,
+    Real                        max_dist_from_original,
+    Real                        fraction_to_move,
+    Real                        stop_threshold,
+    Real                        normal_ratio,
+    BOOLEAN                     range_flag,
+    volume_struct               *volume,
+    int                         min_value,
+    int                         max_value,
+    int                         n_threads,
+    smooth_polygon_monitor_func monitor,
+    void                        *monitor_data );
+
 BICAPI  BOOLEAN  get_interpolation_weights_2d(
     Real   x,
     Real   y,
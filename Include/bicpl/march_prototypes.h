@@ -5,6 +5,33 @@
 extern "C" {
 #endif
 
+BICAPI  BOOLEAN  extract_isosurface(
+    Volume                  volume,
+    Marching_cubes_methods  method,
+    BOOLEAN                 binary_flag,
+    Real                    min_value,
+    Real                    max_value,
+    polygons_struct         *polygons );
+
+BICAPI  BOOLEAN  extract_isosurface_in_parallel(
+    Volume                  volume,
+    Marching_cubes_methods  method,
+    BOOLEAN                 binary_flag,
+    Real                    min_value,
+    Real                    max_value,
+    int                     n_threads,
+    polygons_struct         *polygons );
+
+BICAPI  BOOLEAN  extract_isosurface_with_pyramid(
+    Volume                  volume,
+    minmax_pyramid_struct   *pyramid,
+    Marching_cubes_methods  method,
+    BOOLEAN                 binary_flag,
+    Real                    min_value,
+    Real                    max_value,
+    int                     n_threads,
+    polygons_struct         *polygons );
+
 BICAPI  int  compute_isosurface_in_voxel(
     Marching_cubes_methods  method,
     int                     x,
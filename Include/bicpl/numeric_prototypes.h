@@ -472,6 +472,37 @@ BICAPI  Real  get_cumulative_t_stat(
     t_stat_struct  *stat,
     Real           t );
 
+BICAPI  BOOLEAN  initialize_glm_design(
+    glm_design_struct  *design,
+    int                n_subjects,
+    int                n_regressors,
+    Real               **design_matrix );
+
+BICAPI  void  delete_glm_design(
+    glm_design_struct  *design );
+
+BICAPI  void  compute_glm_t_statistics(
+    glm_design_struct  *design,
+    Real               contrast[],
+    int                n_vertices,
+    nc_type            value_type,
+    void               *data,
+    int                n_threads,
+    Real               t_values[],
+    Real               p_values[] );
+
+BICAPI  void  compute_glm_permutation_probabilities(
+    glm_design_struct  *design,
+    Real               contrast[],
+    int                n_vertices,
+    nc_type            value_type,
+    void               *data,
+    int                n_permutations,
+    int                n_threads,
+    Real               t_values[],
+    Real               uncorrected_p[],
+    Real               corrected_p[] );
+
 #ifdef __cplusplus
 }
 #endif
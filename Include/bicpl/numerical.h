@@ -39,6 +39,20 @@ typedef struct
 
 } t_stat_struct;
 
+/* --- a general linear model design, factorized by initialize_glm_design()
+       for fitting at many vertices */
+
+typedef struct
+{
+    int   n_subjects;
+    int   n_regressors;
+    int   degrees_freedom;
+    Real  *design;            /* --- [n_subjects][n_regressors] */
+    Real  *pseudo_inverse;    /* --- (X^T X)^-1 X^T,
+                                     [n_regressors][n_subjects] */
+    Real  *covariance;        /* --- (X^T X)^-1 */
+} glm_design_struct;
+
 #include  <bicpl/numeric_prototypes.h>
 
 #endif
@@ -95,6 +95,28 @@ typedef  struct
 #define  MAX_POLYGON_NEIGHBOURS     2048
 
 
+/*! \brief Half-edge index of the topology of polygons.
+ * \ingroup grp_bicobj
+ * Half-edge h is the edge of polygon polys[h] from the point indices[h] to
+ * the next point of the polygon, so the half-edges of a polygon are numbered
+ * as its indices.  The half-edges starting at point p are corners[offsets[p]]
+ * to corners[offsets[p+1]-1], in increasing order.  Created by
+ * create_polygons_topology() and cached in polygons_struct.
+ */
+typedef  struct
+{
+    int            n_points;
+    int            n_indices;
+    int            *polys;            /* --- n_indices */
+    int            *opposite;         /* --- the half-edge of the neighbouring
+                                             polygon along the same edge, or
+                                             -1 on the boundary */
+    int            *offsets;          /* --- n_points + 1 */
+    int            *corners;
+    Smallest_int   *boundary_flags;   /* --- TRUE where the point is on a
+                                             boundary edge */
+} polygon_topology_struct;
+
 /*! \brief In-memory structure for polygons.
  * \ingroup grp_bicobj
  */
@@ -127,8 +149,68 @@ typedef  struct
     Smallest_int    *visibilities;
     int             *neighbours;
     bintree_struct_ptr  bintree;
+    polygon_topology_struct  *topology;   /* --- NULL, or cached by
+                                                check_polygons_topology_computed() */
 } polygons_struct;
 
+/*! \brief Polygons read from a memory mapped file.
+ * \ingroup grp_bicobj
+ * Arrays flagged as in the mapping point into the file contents, and are
+ * released by delete_mapped_polygons() rather than delete_polygons().
+ */
+typedef  struct
+{
+    polygons_struct  polygons;
+    void             *mapping;
+    size_t           mapping_size;
+    BOOLEAN          points_in_mapping;
+    BOOLEAN          normals_in_mapping;
+    BOOLEAN          end_indices_in_mapping;
+    BOOLEAN          indices_in_mapping;
+} mapped_polygons_struct;
+
+/*! \brief The neighbours of the points of polygons, in compressed sparse
+ * row form.
+ * \ingroup grp_bicobj
+ * The neighbours of point p, in order around it, are neighbours[offsets[p]]
+ * to neighbours[offsets[p+1]-1].  Created by
+ * create_polygon_point_neighbour_graph().
+ */
+typedef  struct
+{
+    int            n_points;
+    int            *offsets;          /* --- n_points + 1 */
+    int            *neighbours;
+    Smallest_int   *interior_flags;   /* --- TRUE where the fan is closed */
+    int            *point_polygons;   /* --- NULL, or for each neighbour the
+                                             polygon with the edge to it */
+} point_neighbours_struct;
+
+/*! \brief Encodings of the points of the subjects of a surface bundle.
+ * \ingroup grp_bicobj
+ */
+typedef enum { BUNDLE_FLOAT32, BUNDLE_FLOAT16, BUNDLE_DELTA_FLOAT16 }
+                                                     Bundle_encodings;
+
+/*! \brief An open surface bundle file, holding one topology and the points
+ * of many subjects.
+ * \ingroup grp_bicobj
+ *
+ * When reading, polygons holds the topology and the points of the last
+ * subject read, reused for each subject.
+ */
+typedef  struct
+{
+    FILE              *file;
+    IO_types          io_flag;
+    Bundle_encodings  encoding;
+    int               n_subjects;
+    polygons_struct   polygons;
+    Point             *reference;
+    unsigned short    *buffer;
+    long              data_start;
+} surface_bundle_struct;
+
 
 /*! \brief In-memory structure for a quadrilateral mesh.
  * \ingroup grp_bicobj
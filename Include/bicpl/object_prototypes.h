@@ -6,6 +6,30 @@
 extern "C" {
 #endif
 
+BICAPI  void  set_fast_ascii_object_io_flag(
+    BOOLEAN  value );
+
+BICAPI  BOOLEAN  get_fast_ascii_object_io_flag( void );
+
+BICAPI  BOOLEAN  can_use_fast_ascii_io(
+    FILE      *file,
+    IO_types  io_flag );
+
+BICAPI  Status  io_ascii_lines(
+    FILE                *file,
+    IO_types            io_flag,
+    lines_struct        *lines );
+
+BICAPI  Status  io_ascii_polygons(
+    FILE                *file,
+    IO_types            io_flag,
+    polygons_struct     *polygons );
+
+BICAPI  Status  io_ascii_quadmesh(
+    FILE                *file,
+    IO_types            io_flag,
+    quadmesh_struct     *quadmesh );
+
 BICAPI  void  coalesce_object_points(
     int      *n_points,
     Point    *points[],
@@ -162,6 +186,13 @@ BICAPI  void  get_lines_arc_point(
     Real          arc_length,
     Point         *point );
 
+BICAPI  Status  input_mapped_polygons(
+    STRING                  filename,
+    mapped_polygons_struct  *mapped );
+
+BICAPI  void  delete_mapped_polygons(
+    mapped_polygons_struct  *mapped );
+
 BICAPI  void   initialize_marker(
     marker_struct     *marker,
     Marker_types      type,
@@ -518,6 +549,21 @@ BICAPI  void  delete_polygon_point_neighbours(
     Smallest_int     interior_flags[],
     int              *point_polygons[] );
 
+BICAPI  void  create_polygon_point_neighbour_graph(
+    polygons_struct          *polygons,
+    BOOLEAN                  across_polygons_flag,
+    BOOLEAN                  point_polygons_flag,
+    point_neighbours_struct  *graph );
+
+BICAPI  void  delete_polygon_point_neighbour_graph(
+    point_neighbours_struct  *graph );
+
+BICAPI  void  get_point_neighbour_graph_arrays(
+    point_neighbours_struct  *graph,
+    int                      *n_point_neighbours[],
+    int                      **point_neighbours[],
+    int                      **point_polygons[] );
+
 BICAPI   void   create_polygon_point_neighbours(
     polygons_struct  *polygons,
     BOOLEAN          across_polygons_flag,
@@ -526,6 +572,34 @@ BICAPI   void   create_polygon_point_neighbours(
     Smallest_int     *interior_flags_ptr[],
     int              **point_polygons_ptr[] );
 
+BICAPI  void  create_polygons_topology(
+    polygons_struct   *polygons,
+    int               n_threads );
+
+BICAPI  void  check_polygons_topology_computed(
+    polygons_struct   *polygons );
+
+BICAPI  void  delete_polygons_topology(
+    polygons_struct   *polygons );
+
+BICAPI  BOOLEAN  get_polygon_across_edge(
+    polygons_struct   *polygons,
+    int               poly,
+    int               edge,
+    int               *neighbour_poly,
+    int               *neighbour_edge );
+
+BICAPI  BOOLEAN  point_is_on_polygons_boundary(
+    polygons_struct   *polygons,
+    int               point_index );
+
+BICAPI  BOOLEAN  get_polygons_topology_edge(
+    polygons_struct   *polygons,
+    int               point_index1,
+    int               point_index2,
+    int               *poly_containing_edge,
+    int               *edge_index );
+
 BICAPI  void  initialize_polygons(
     polygons_struct   *polygons,
     Colour            col,
@@ -751,6 +825,34 @@ BICAPI  Colour     *get_8bit_rgb_pixel_lookup( void );
 BICAPI  int  convert_rgb_pixel_to_8bit_lookup(
     Colour    colour );
 
+BICAPI  Status  create_surface_bundle(
+    STRING                 filename,
+    polygons_struct        *topology,
+    Bundle_encodings       encoding,
+    surface_bundle_struct  *bundle );
+
+BICAPI  Status  add_surface_bundle_subject(
+    surface_bundle_struct  *bundle,
+    Point                  points[] );
+
+BICAPI  Status  open_surface_bundle(
+    STRING                 filename,
+    surface_bundle_struct  *bundle );
+
+BICAPI  int  get_surface_bundle_n_subjects(
+    surface_bundle_struct  *bundle );
+
+BICAPI  Status  input_surface_bundle_subject(
+    surface_bundle_struct  *bundle,
+    int                    subject,
+    BOOLEAN                compute_normals );
+
+BICAPI  Status  close_surface_bundle(
+    surface_bundle_struct  *bundle );
+
+BICAPI  BOOLEAN  is_surface_bundle_file(
+    STRING   filename );
+
 BICAPI  Status   input_tag_objects_file(
     STRING         filename,
     Colour         marker_colour,
@@ -780,6 +882,21 @@ BICAPI  Status  input_texture_values(
     int            *n_values,
     Real           *values[] );
 
+BICAPI  Status  input_texture_values_to_buffer(
+    STRING         filename,
+    nc_type        value_type,
+    int            max_values,
+    void           *values,
+    int            *n_values );
+
+BICAPI  Status  input_texture_values_matrix(
+    int            n_files,
+    STRING         filenames[],
+    nc_type        value_type,
+    int            n_values,
+    void           *matrix,
+    int            n_threads );
+
 #ifdef __cplusplus
 }
 #endif
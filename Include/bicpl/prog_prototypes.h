@@ -60,6 +60,21 @@ BICAPI  int  get_random_int( int n );
 
 BICAPI  Real  get_random_0_to_1( void );
 
+BICAPI  void  set_default_n_threads(
+    int   n_threads );
+
+BICAPI  int  get_default_n_threads( void );
+
+BICAPI  int  get_n_threads_to_use(
+    int   n_threads,
+    int   n_jobs );
+
+BICAPI  void  do_parallel_jobs(
+    int                n_threads,
+    int                n_jobs,
+    parallel_job_func  job_func,
+    void               *data );
+
 BICAPI  void  start_timing( void );
 
 BICAPI  void  end_timing(
@@ -19,6 +19,13 @@
 #include  <volume_io.h>
 #include  <bicpl/global_lookup.h>
 
+/*! \brief Job function for do_parallel_jobs().
+ *
+ * Called once per job index; \a thread identifies the calling worker
+ * and lies in the range 0 .. n_threads-1.
+ */
+typedef  void  (*parallel_job_func)( void *data, int job, int thread );
+
 #include  <bicpl/prog_prototypes.h>
 
 #endif
@@ -182,6 +182,26 @@ BICAPI  int  dilate_voxels_3d(
     Neighbour_types connectivity,
     int             range_changed[2][N_DIMENSIONS] );
 
+BICAPI  void  initialize_volume_evaluator(
+    volume_evaluator_struct  *evaluator,
+    Volume                   volume,
+    int                      degrees_continuity,
+    Real                     outside_value );
+
+BICAPI  void  delete_volume_evaluator(
+    volume_evaluator_struct  *evaluator );
+
+BICAPI  void  evaluate_volume_at_points(
+    volume_evaluator_struct  *evaluator,
+    int                      n_points,
+    Real                     x[],
+    Real                     y[],
+    Real                     z[],
+    BOOLEAN                  world_coordinates,
+    Real                     values[],
+    Real                     *derivs[],
+    Real                     *second_derivs[] );
+
 BICAPI  int  get_slice_weights_for_filter(
     Volume         volume,
     Real           voxel_position[],
@@ -497,6 +517,35 @@ BICAPI  BOOLEAN  volumes_are_same_grid(
     Volume    volume1,
     Volume    volume2 );
 
+BICAPI  BOOLEAN  create_minmax_pyramid(
+    minmax_pyramid_struct  *pyramid,
+    Volume                 volume,
+    int                    block_size );
+
+BICAPI  void  delete_minmax_pyramid(
+    minmax_pyramid_struct  *pyramid );
+
+BICAPI  BOOLEAN  minmax_pyramid_box_intersects_range(
+    minmax_pyramid_struct  *pyramid,
+    int                    low[],
+    int                    high[],
+    Real                   min_value,
+    Real                   max_value );
+
+BICAPI  BOOLEAN  minmax_pyramid_box_spans_range(
+    minmax_pyramid_struct  *pyramid,
+    int                    low[],
+    int                    high[],
+    Real                   min_value,
+    Real                   max_value );
+
+BICAPI  BOOLEAN  get_minmax_pyramid_box_range(
+    minmax_pyramid_struct  *pyramid,
+    int                    low[],
+    int                    high[],
+    Real                   *min_value,
+    Real                   *max_value );
+
 BICAPI  Status  output_volume_free_format(
     STRING         prefix,
     Volume         volume,
@@ -566,6 +615,14 @@ BICAPI  void  initialize_resample_volume(
     General_transform    *dest_to_src_transform,
     Volume               dest_volume );
 
+BICAPI  void  set_resampling_degrees_continuity(
+    resample_struct  *resample,
+    int              degrees_continuity );
+
+BICAPI  void  set_resampling_n_threads(
+    resample_struct  *resample,
+    int              n_threads );
+
 BICAPI  BOOLEAN  do_more_resampling(
     resample_struct  *resample,
     Real             max_seconds,
@@ -576,6 +633,12 @@ BICAPI  void  resample_volume(
     General_transform        *dest_to_src_transform,
     Volume                   dest_volume );
 
+BICAPI  void  resample_volume_in_parallel(
+    Volume                   src_volume,
+    General_transform        *dest_to_src_transform,
+    Volume                   dest_volume,
+    int                      n_threads );
+
 BICAPI  void  scan_lines_to_voxels(
     lines_struct     *lines,
     Volume           volume,
@@ -626,6 +689,52 @@ BICAPI  Volume  smooth_resample_volume(
     int                 new_ny,
     int                 new_nz );
 
+BICAPI  BOOLEAN  create_spline_coef_volume(
+    spline_coef_volume_struct  *spline,
+    Volume                     volume );
+
+BICAPI  void  delete_spline_coef_volume(
+    spline_coef_volume_struct  *spline );
+
+BICAPI  BOOLEAN  evaluate_spline_coef_volume(
+    spline_coef_volume_struct  *spline,
+    Real                       voxel[],
+    Real                       outside_value,
+    Real                       *value,
+    Real                       derivs[],
+    Real                       second_derivs[] );
+
+BICAPI  BOOLEAN  evaluate_spline_coef_volume_in_world(
+    spline_coef_volume_struct  *spline,
+    Real                       x,
+    Real                       y,
+    Real                       z,
+    Real                       outside_value,
+    Real                       *value,
+    Real                       *deriv_x,
+    Real                       *deriv_y,
+    Real                       *deriv_z,
+    Real                       *deriv_xx,
+    Real                       *deriv_xy,
+    Real                       *deriv_xz,
+    Real                       *deriv_yy,
+    Real                       *deriv_yz,
+    Real                       *deriv_zz );
+
+BICAPI  void  get_spline_coef_volume_coefs(
+    spline_coef_volume_struct  *spline,
+    int                        x,
+    int                        y,
+    int                        z,
+    Real                       coefs[] );
+
+BICAPI  void  get_spline_coef_volume_samples(
+    spline_coef_volume_struct  *spline,
+    int                        x,
+    int                        y,
+    int                        z,
+    Real                       samples[] );
+
 BICAPI  void  convert_voxel_to_talairach(
     Real   x_voxel,
     Real   y_voxel,
@@ -24,11 +24,49 @@ typedef  enum  { FOUR_NEIGHBOURS, EIGHT_NEIGHBOURS } Neighbour_types;
 typedef struct
 {
     int                    x, y;
+    int                    n_threads;
+    int                    degrees_continuity;
     Volume                 src_volume;
     Volume                 dest_volume;
     General_transform      transform;
 } resample_struct;
 
+typedef struct
+{
+    Volume                 volume;
+    int                    degrees_continuity;
+    Real                   outside_value;
+    BOOLEAN                linear_world_to_voxel;
+    Real                   world_to_voxel[N_DIMENSIONS][4];
+    BOOLEAN                direct_access;
+    Data_types             data_type;
+    void                   *data;
+    int                    sizes[N_DIMENSIONS];
+    size_t                 strides[N_DIMENSIONS];
+    Real                   value_scale;
+    Real                   value_translation;
+} volume_evaluator_struct;
+
+typedef struct
+{
+    Volume                 volume;
+    int                    sizes[N_DIMENSIONS];
+    size_t                 strides[N_DIMENSIONS];
+    float                  *coefs;
+} spline_coef_volume_struct;
+
+#define  MAX_MINMAX_PYRAMID_LEVELS  32
+
+typedef struct
+{
+    int                    block_size;
+    int                    n_levels;
+    int                    sizes[N_DIMENSIONS];
+    int                    n_blocks[MAX_MINMAX_PYRAMID_LEVELS][N_DIMENSIONS];
+    Real                   *min_values[MAX_MINMAX_PYRAMID_LEVELS];
+    Real                   *max_values[MAX_MINMAX_PYRAMID_LEVELS];
+} minmax_pyramid_struct;
+
 #include  <bicpl/vol_prototypes.h>
 
 #endif
@@ -0,0 +1,1001 @@
+#include "bicpl_internal.h"
+#include "bicpl/marching.h"
+
+/*--- an edge point is identified by the voxel corner where its edge
+      starts and by the edge index; a point that falls exactly on a corner
+      is identified by the corner and the extra CORNER_SLOT(n_edges) */
+
+#define  CORNER_SLOT( n_edges )    (n_edges)
+
+/*--- the points, and the polygons joining them, extracted from a range of
+      slices of the volume.  Points are in voxel coordinates. */
+
+typedef  struct
+{
+    int         n_edges;
+    int         n_points;
+    int         n_points_alloced;
+    Point       *points;
+    int         n_polygons;
+    int         n_polygons_alloced;
+    int         *end_indices;
+    int         n_indices;
+    int         n_indices_alloced;
+    int         *indices;
+} isosurface_slab_struct;
+
+/*--- grows an array by doubling, so that appending is amortized constant */
+
+#define  ENSURE_ARRAY_SIZE( array, n_alloced, n_needed ) \
+         { \
+             if( (n_needed) > (n_alloced) ) \
+             { \
+                 (n_alloced) = MAX( 2 * (n_alloced), (n_needed) ); \
+                 (n_alloced) = MAX( (n_alloced), DEFAULT_CHUNK_SIZE ); \
+                 if( (array) == NULL ) \
+                     ALLOC( array, n_alloced ); \
+                 else \
+                     REALLOC( array, n_alloced ); \
+             } \
+         }
+
+static  void  initialize_isosurface_slab(
+    isosurface_slab_struct  *slab,
+    int                     n_edges )
+{
+    slab->n_edges = n_edges;
+    slab->n_points = 0;
+    slab->n_points_alloced = 0;
+    slab->points = NULL;
+    slab->n_polygons = 0;
+    slab->n_polygons_alloced = 0;
+    slab->end_indices = NULL;
+    slab->n_indices = 0;
+    slab->n_indices_alloced = 0;
+    slab->indices = NULL;
+}
+
+static  void  delete_isosurface_slab(
+    isosurface_slab_struct  *slab )
+{
+    if( slab->points != NULL )
+        FREE( slab->points );
+    if( slab->end_indices != NULL )
+        FREE( slab->end_indices );
+    if( slab->indices != NULL )
+        FREE( slab->indices );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_slice_ids
+@INPUT      : n_ids
+@OUTPUT     :
+@RETURNS    : array of point indices
+@DESCRIPTION: Allocates the point indices of the edges starting in one slice
+              of voxels, all initialized to none.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  int  *get_slice_ids(
+    int   n_ids )
+{
+    int   i, *ids;
+
+    ALLOC( ids, n_ids );
+
+    for_less( i, 0, n_ids )
+        ids[i] = -1;
+
+    return( ids );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_edge_point_id
+@INPUT      : slab
+              slice_ids       - indices of the points in slices x and x+1
+              sizes
+              x, y, z         - voxel of the cube
+              corners
+              edge_point      - edge of the cube
+              binary_flag
+              min_value
+              max_value
+@OUTPUT     :
+@RETURNS    : index of the point
+@DESCRIPTION: Returns the index of the isosurface point on an edge of a
+              cube, creating it if it was not already created by one of the
+              neighbouring cubes sharing the edge.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  int  get_edge_point_id(
+    isosurface_slab_struct  *slab,
+    int                     *slice_ids[2],
+    int                     sizes[],
+    int                     x,
+    int                     y,
+    int                     z,
+    Real                    corners[2][2][2],
+    voxel_point_type        *edge_point,
+    BOOLEAN                 binary_flag,
+    Real                    min_value,
+    Real                    max_value )
+{
+    int            dim, slot, offset[N_DIMENSIONS], corner[N_DIMENSIONS];
+    int            id, *id_ptr;
+    Real           point[N_DIMENSIONS];
+    Point_classes  point_class;
+
+    point_class = get_isosurface_point( corners, edge_point->coord,
+                                        edge_point->edge_intersected,
+                                        binary_flag, min_value, max_value,
+                                        point );
+
+    for_less( dim, 0, N_DIMENSIONS )
+        corner[dim] = edge_point->coord[dim];
+
+    switch( point_class )
+    {
+    case ON_FIRST_CORNER:
+        slot = CORNER_SLOT( slab->n_edges );
+        break;
+
+    case ON_SECOND_CORNER:
+        translate_from_edge_index( edge_point->edge_intersected, offset );
+        for_less( dim, 0, N_DIMENSIONS )
+            corner[dim] += offset[dim];
+        slot = CORNER_SLOT( slab->n_edges );
+        break;
+
+    case ON_EDGE:
+        slot = edge_point->edge_intersected;
+        break;
+
+    default:
+        /*--- the tables and the point disagree on an exact tie, so take
+              the middle of the edge */
+
+        translate_from_edge_index( edge_point->edge_intersected, offset );
+        for_less( dim, 0, N_DIMENSIONS )
+            point[dim] = (Real) corner[dim] + (Real) offset[dim] / 2.0;
+        slot = edge_point->edge_intersected;
+        break;
+    }
+
+    id_ptr = &slice_ids[corner[X]][((y + corner[Y]) * sizes[Z] +
+                                    z + corner[Z]) * (slab->n_edges + 1) +
+                                   slot];
+
+    if( *id_ptr < 0 )
+    {
+        id = slab->n_points;
+        ENSURE_ARRAY_SIZE( slab->points, slab->n_points_alloced, id + 1 );
+        fill_Point( slab->points[id], (Real) x + point[X],
+                                      (Real) y + point[Y],
+                                      (Real) z + point[Z] );
+        ++slab->n_points;
+        *id_ptr = id;
+    }
+
+    return( *id_ptr );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : add_slab_polygon
+@INPUT      : slab
+              size
+              ids
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Adds a polygon to the slab, dropping repeated vertices, which
+              occur where the isosurface passes exactly through a voxel.
+              Polygons left with fewer than 3 vertices are discarded.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  add_slab_polygon(
+    isosurface_slab_struct  *slab,
+    int                     size,
+    int                     ids[] )
+{
+    int   i, n;
+
+    ENSURE_ARRAY_SIZE( slab->indices, slab->n_indices_alloced,
+                       slab->n_indices + size );
+
+    n = 0;
+    for_less( i, 0, size )
+    {
+        if( n == 0 || ids[i] != slab->indices[slab->n_indices+n-1] )
+        {
+            slab->indices[slab->n_indices+n] = ids[i];
+            ++n;
+        }
+    }
+
+    while( n > 1 && slab->indices[slab->n_indices+n-1] ==
+                    slab->indices[slab->n_indices] )
+        --n;
+
+    if( n < 3 )
+        return;
+
+    slab->n_indices += n;
+
+    ENSURE_ARRAY_SIZE( slab->end_indices, slab->n_polygons_alloced,
+                       slab->n_polygons + 1 );
+    slab->end_indices[slab->n_polygons] = slab->n_indices;
+    ++slab->n_polygons;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : cube_may_intersect
+@INPUT      : corners
+              binary_flag
+              min_value
+              max_value
+@OUTPUT     :
+@RETURNS    : FALSE if the cube certainly contains no isosurface
+@DESCRIPTION: Quick rejection of cubes whose corners are all on one side of
+              the isosurface.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  BOOLEAN  cube_may_intersect(
+    Real      corners[2][2][2],
+    BOOLEAN   binary_flag,
+    Real      min_value,
+    Real      max_value )
+{
+    int       i, j, k;
+    int       n_below, n_above;
+    Real      value;
+
+    n_below = 0;
+    n_above = 0;
+
+    for_less( i, 0, 2 )
+    for_less( j, 0, 2 )
+    for_less( k, 0, 2 )
+    {
+        value = corners[i][j][k];
+
+        if( binary_flag )
+        {
+            if( min_value <= value && value <= max_value )
+                ++n_above;
+            else
+                ++n_below;
+        }
+        else if( value < min_value )
+            ++n_below;
+        else if( value > min_value )
+            ++n_above;
+        else
+            return( TRUE );
+    }
+
+    return( n_below > 0 && n_above > 0 );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_active_tiles
+@INPUT      : pyramid
+              x            - slice of cubes
+              binary_flag
+              min_value
+              max_value
+@OUTPUT     : active
+@RETURNS    : TRUE if any tile of the slice is active
+@DESCRIPTION: Divides slice x of cubes into tiles of the pyramid block size,
+              and finds the tiles that may contain part of the isosurface,
+              according to the pyramid.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  BOOLEAN  get_active_tiles(
+    minmax_pyramid_struct  *pyramid,
+    int                    x,
+    BOOLEAN                binary_flag,
+    Real                   min_value,
+    Real                   max_value,
+    BOOLEAN                active[] )
+{
+    int      ty, tz, n_tiles[N_DIMENSIONS], low[N_DIMENSIONS];
+    int      high[N_DIMENSIONS], block_size;
+    BOOLEAN  any_active;
+
+    if( !binary_flag )
+        max_value = min_value;
+
+    block_size = pyramid->block_size;
+    n_tiles[Y] = pyramid->n_blocks[0][Y];
+    n_tiles[Z] = pyramid->n_blocks[0][Z];
+
+    low[X] = x;
+    high[X] = x + 1;
+    low[Y] = 0;
+    high[Y] = pyramid->sizes[Y] - 1;
+    low[Z] = 0;
+    high[Z] = pyramid->sizes[Z] - 1;
+
+    any_active = minmax_pyramid_box_spans_range( pyramid, low, high,
+                                                 min_value, max_value );
+
+    for_less( ty, 0, n_tiles[Y] )
+    for_less( tz, 0, n_tiles[Z] )
+    {
+        if( any_active )
+        {
+            low[Y] = ty * block_size;
+            high[Y] = low[Y] + block_size;
+            low[Z] = tz * block_size;
+            high[Z] = low[Z] + block_size;
+
+            active[ty * n_tiles[Z] + tz] = minmax_pyramid_box_spans_range(
+                                               pyramid, low, high,
+                                               min_value, max_value );
+        }
+        else
+            active[ty * n_tiles[Z] + tz] = FALSE;
+    }
+
+    return( any_active );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : extract_isosurface_slab
+@INPUT      : volume
+              pyramid      - min/max pyramid of the volume, or NULL
+              method
+              binary_flag
+              min_value
+              max_value
+              x_start      - first slice of cubes
+              x_end        - one past the last slice of cubes
+@OUTPUT     : slab
+              first_ids    - if non-NULL, receives the point indices of the
+                             edges starting in slice x_start
+              last_ids     - if non-NULL, receives the point indices of the
+                             edges starting in slice x_end
+@RETURNS    :
+@DESCRIPTION: Extracts the isosurface from the cubes between voxel slices
+              x_start and x_end, along the first voxel axis.  Points shared
+              between cubes are created once, in the order the cubes first
+              use them.
+@METHOD     : Only two slices of voxel values and two slices of edge point
+              indices are kept, so the memory used is proportional to a
+              slice rather than to the volume.  Given a pyramid, cubes in
+              tiles that cannot contain the isosurface are skipped, and
+              slices are not read until a cube needs them.  The cubes are
+              visited in the same order either way, so the result is the
+              same.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  extract_isosurface_slab(
+    Volume                  volume,
+    minmax_pyramid_struct   *pyramid,
+    Marching_cubes_methods  method,
+    BOOLEAN                 binary_flag,
+    Real                    min_value,
+    Real                    max_value,
+    int                     x_start,
+    int                     x_end,
+    isosurface_slab_struct  *slab,
+    int                     **first_ids,
+    int                     **last_ids )
+{
+    int               x, y, z, i, j, k, sizes[MAX_DIMENSIONS];
+    int               n_slice_ids, n_polys, poly, vertex, ind;
+    int               *poly_sizes, *slice_ids[2], *tmp_ids;
+    int               ids[MAX_POINTS_PER_VOXEL_POLYGON];
+    int               values_x[2], tmp_x, n_tiles_z, tile_size;
+    Real              *values[2], *tmp_values, corners[2][2][2];
+    BOOLEAN           *active_tiles, slice_active;
+    voxel_point_type  *edge_points;
+
+    get_volume_sizes( volume, sizes );
+
+    initialize_isosurface_slab( slab, get_max_marching_edges( method ) );
+
+    n_slice_ids = sizes[Y] * sizes[Z] * (slab->n_edges + 1);
+
+    ALLOC( values[0], sizes[Y] * sizes[Z] );
+    ALLOC( values[1], sizes[Y] * sizes[Z] );
+    slice_ids[0] = get_slice_ids( n_slice_ids );
+    slice_ids[1] = get_slice_ids( n_slice_ids );
+
+    /*--- values_x records which slice each values array holds */
+
+    values_x[0] = -1;
+    values_x[1] = -1;
+
+    if( pyramid != NULL )
+    {
+        tile_size = pyramid->block_size;
+        n_tiles_z = pyramid->n_blocks[0][Z];
+        ALLOC( active_tiles, pyramid->n_blocks[0][Y] * n_tiles_z );
+    }
+    else
+    {
+        tile_size = MAX( sizes[Y], sizes[Z] );
+        n_tiles_z = 1;
+        ALLOC( active_tiles, 1 );
+        active_tiles[0] = TRUE;
+    }
+
+    for_less( x, x_start, x_end )
+    {
+        tmp_values = values[0];
+        values[0] = values[1];
+        values[1] = tmp_values;
+        tmp_x = values_x[0];
+        values_x[0] = values_x[1];
+        values_x[1] = tmp_x;
+
+        slice_active = (pyramid == NULL ||
+                        get_active_tiles( pyramid, x, binary_flag,
+                                          min_value, max_value,
+                                          active_tiles ));
+
+        if( slice_active )
+        {
+            for_less( i, 0, 2 )
+            {
+                if( values_x[i] != x + i )
+                {
+                    get_volume_value_hyperslab_3d( volume, x + i, 0, 0,
+                                                   1, sizes[Y], sizes[Z],
+                                                   values[i] );
+                    values_x[i] = x + i;
+                }
+            }
+        }
+
+        for_less( y, 0, slice_active ? sizes[Y] - 1 : 0 )
+        for_less( z, 0, sizes[Z] - 1 )
+        {
+            if( !active_tiles[(y / tile_size) * n_tiles_z + z / tile_size] )
+                continue;
+
+            for_less( i, 0, 2 )
+            for_less( j, 0, 2 )
+            for_less( k, 0, 2 )
+                corners[i][j][k] = values[i][(y+j) * sizes[Z] + z + k];
+
+            if( !cube_may_intersect( corners, binary_flag,
+                                     min_value, max_value ) )
+                continue;
+
+            n_polys = compute_isosurface_in_voxel( method, x, y, z, corners,
+                                                   binary_flag, min_value,
+                                                   max_value, &poly_sizes,
+                                                   &edge_points );
+
+            ind = 0;
+            for_less( poly, 0, n_polys )
+            {
+                for_less( vertex, 0, poly_sizes[poly] )
+                {
+                    ids[vertex] = get_edge_point_id( slab, slice_ids, sizes,
+                                                     x, y, z, corners,
+                                                     &edge_points[ind],
+                                                     binary_flag,
+                                                     min_value, max_value );
+                    ++ind;
+                }
+
+                add_slab_polygon( slab, poly_sizes[poly], ids );
+            }
+        }
+
+        /*--- the edges of slice x+1 become those of the next slice x */
+
+        if( x == x_start && first_ids != NULL )
+        {
+            *first_ids = slice_ids[0];
+            slice_ids[0] = slice_ids[1];
+            slice_ids[1] = get_slice_ids( n_slice_ids );
+        }
+        else
+        {
+            tmp_ids = slice_ids[0];
+            slice_ids[0] = slice_ids[1];
+            slice_ids[1] = tmp_ids;
+
+            for_less( i, 0, n_slice_ids )
+                slice_ids[1][i] = -1;
+        }
+    }
+
+    if( first_ids != NULL && x_start >= x_end )
+    {
+        *first_ids = slice_ids[0];
+        slice_ids[0] = get_slice_ids( n_slice_ids );
+    }
+
+    if( last_ids != NULL )
+    {
+        *last_ids = slice_ids[0];
+        slice_ids[0] = NULL;
+    }
+
+    if( slice_ids[0] != NULL )
+        FREE( slice_ids[0] );
+    FREE( slice_ids[1] );
+    FREE( values[0] );
+    FREE( values[1] );
+    FREE( active_tiles );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : create_isosurface_polygons
+@INPUT      : volume
+              slab
+@OUTPUT     : polygons
+@RETURNS    :
+@DESCRIPTION: Moves the points and polygons of a slab into a polygons
+              structure, converting the points to world coordinates and
+              computing the vertex normals.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  create_isosurface_polygons(
+    Volume                  volume,
+    isosurface_slab_struct  *slab,
+    polygons_struct         *polygons )
+{
+    int     point;
+    Real    voxel[MAX_DIMENSIONS], x_world, y_world, z_world;
+
+    initialize_polygons( polygons, WHITE, NULL );
+
+    if( slab->n_polygons == 0 )
+    {
+        delete_isosurface_slab( slab );
+        return;
+    }
+
+    polygons->n_points = slab->n_points;
+    polygons->points = slab->points;
+    REALLOC( polygons->points, polygons->n_points );
+    ALLOC( polygons->normals, polygons->n_points );
+
+    polygons->n_items = slab->n_polygons;
+    polygons->end_indices = slab->end_indices;
+    REALLOC( polygons->end_indices, polygons->n_items );
+    polygons->indices = slab->indices;
+    REALLOC( polygons->indices, slab->n_indices );
+
+    for_less( point, 0, polygons->n_points )
+    {
+        voxel[X] = (Real) Point_x(polygons->points[point]);
+        voxel[Y] = (Real) Point_y(polygons->points[point]);
+        voxel[Z] = (Real) Point_z(polygons->points[point]);
+
+        convert_voxel_to_world( volume, voxel, &x_world, &y_world, &z_world );
+
+        fill_Point( polygons->points[point], x_world, y_world, z_world );
+    }
+
+    compute_polygon_normals( polygons );
+}
+
+/*--- each thread extracts a few blocks of slices, for load balancing */
+
+#define  BLOCKS_PER_THREAD   4
+
+typedef  struct
+{
+    Volume                  volume;
+    minmax_pyramid_struct   *pyramid;
+    Marching_cubes_methods  method;
+    BOOLEAN                 binary_flag;
+    Real                    min_value;
+    Real                    max_value;
+    int                     *block_starts;
+    isosurface_slab_struct  *slabs;
+    int                     **first_ids;
+    int                     **last_ids;
+} isosurface_blocks_struct;
+
+static  void  extract_isosurface_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    isosurface_blocks_struct  *blocks;
+
+    blocks = (isosurface_blocks_struct *) data;
+
+    extract_isosurface_slab( blocks->volume, blocks->pyramid, blocks->method,
+                             blocks->binary_flag,
+                             blocks->min_value, blocks->max_value,
+                             blocks->block_starts[block],
+                             blocks->block_starts[block+1],
+                             &blocks->slabs[block],
+                             &blocks->first_ids[block],
+                             &blocks->last_ids[block] );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : merge_isosurface_slabs
+@INPUT      : n_slabs
+              slabs
+              first_ids
+              last_ids
+              n_slice_ids
+@OUTPUT     : merged
+@RETURNS    :
+@DESCRIPTION: Joins the slabs extracted from consecutive blocks of slices,
+              deleting them.  A point on the slice between two blocks is
+              created by both, so the copy from the second block is
+              replaced by the one from the first.
+@METHOD     : Slab by slab, the points not already present are appended in
+              the order the slab created them.  This is the order in which
+              the cubes first use them, so the result is the same as
+              extracting the whole volume as a single slab, whatever the
+              number of blocks.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  merge_isosurface_slabs(
+    int                     n_slabs,
+    isosurface_slab_struct  slabs[],
+    int                     *first_ids[],
+    int                     *last_ids[],
+    int                     n_slice_ids,
+    isosurface_slab_struct  *merged )
+{
+    int      s, i, p, n_points, n_polygons, n_indices, index_offset;
+    int      *point_map, *prev_point_map;
+
+    n_points = 0;
+    n_polygons = 0;
+    n_indices = 0;
+    for_less( s, 0, n_slabs )
+    {
+        n_points += slabs[s].n_points;
+        n_polygons += slabs[s].n_polygons;
+        n_indices += slabs[s].n_indices;
+    }
+
+    initialize_isosurface_slab( merged, slabs[0].n_edges );
+    ENSURE_ARRAY_SIZE( merged->points, merged->n_points_alloced, n_points );
+    ENSURE_ARRAY_SIZE( merged->end_indices, merged->n_polygons_alloced,
+                       n_polygons );
+    ENSURE_ARRAY_SIZE( merged->indices, merged->n_indices_alloced,
+                       n_indices );
+
+    prev_point_map = NULL;
+
+    for_less( s, 0, n_slabs )
+    {
+        ALLOC( point_map, MAX( 1, slabs[s].n_points ) );
+
+        for_less( p, 0, slabs[s].n_points )
+            point_map[p] = -1;
+
+        if( s > 0 )
+        {
+            for_less( i, 0, n_slice_ids )
+            {
+                if( first_ids[s][i] >= 0 && last_ids[s-1][i] >= 0 )
+                    point_map[first_ids[s][i]] =
+                                      prev_point_map[last_ids[s-1][i]];
+            }
+        }
+
+        for_less( p, 0, slabs[s].n_points )
+        {
+            if( point_map[p] < 0 )
+            {
+                point_map[p] = merged->n_points;
+                merged->points[merged->n_points] = slabs[s].points[p];
+                ++merged->n_points;
+            }
+        }
+
+        index_offset = merged->n_indices;
+
+        for_less( i, 0, slabs[s].n_indices )
+        {
+            merged->indices[merged->n_indices] =
+                                  point_map[slabs[s].indices[i]];
+            ++merged->n_indices;
+        }
+
+        for_less( p, 0, slabs[s].n_polygons )
+        {
+            merged->end_indices[merged->n_polygons] =
+                                  index_offset + slabs[s].end_indices[p];
+            ++merged->n_polygons;
+        }
+
+        if( prev_point_map != NULL )
+            FREE( prev_point_map );
+        prev_point_map = point_map;
+
+        delete_isosurface_slab( &slabs[s] );
+    }
+
+    FREE( prev_point_map );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : extract_isosurface_with_threads
+@INPUT      : volume
+              pyramid
+              method
+              binary_flag
+              min_value
+              max_value
+              n_threads
+@OUTPUT     : polygons
+@RETURNS    : TRUE if successful
+@DESCRIPTION: Does the work of extract_isosurface(),
+              extract_isosurface_in_parallel() and
+              extract_isosurface_with_pyramid().
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  BOOLEAN  extract_isosurface_with_threads(
+    Volume                  volume,
+    minmax_pyramid_struct   *pyramid,
+    Marching_cubes_methods  method,
+    BOOLEAN                 binary_flag,
+    Real                    min_value,
+    Real                    max_value,
+    int                     n_threads,
+    polygons_struct         *polygons )
+{
+    int                       sizes[MAX_DIMENSIONS], block, n_blocks;
+    int                       n_cube_slices, *poly_sizes;
+    Real                      corners[2][2][2];
+    voxel_point_type          *edge_points;
+    isosurface_slab_struct    slab;
+    isosurface_blocks_struct  blocks;
+
+    if( get_volume_n_dimensions( volume ) != N_DIMENSIONS )
+    {
+        print_error( "extract_isosurface: volume must be 3D.\n" );
+        return( FALSE );
+    }
+
+    if( get_max_marching_edges( method ) == 0 )
+        return( FALSE );
+
+    get_volume_sizes( volume, sizes );
+
+    if( pyramid != NULL &&
+        (pyramid->sizes[X] != sizes[X] || pyramid->sizes[Y] != sizes[Y] ||
+         pyramid->sizes[Z] != sizes[Z]) )
+    {
+        print_error( "extract_isosurface: pyramid does not match volume.\n" );
+        return( FALSE );
+    }
+
+    if( sizes[X] < 2 || sizes[Y] < 2 || sizes[Z] < 2 )
+    {
+        initialize_polygons( polygons, WHITE, NULL );
+        return( TRUE );
+    }
+
+    n_cube_slices = sizes[X] - 1;
+
+    /*--- cached volumes cannot be read from several threads at once */
+
+    if( volume->is_cached_volume )
+        n_threads = 1;
+
+    n_threads = get_n_threads_to_use( n_threads, n_cube_slices );
+
+    if( n_threads <= 1 )
+    {
+        extract_isosurface_slab( volume, pyramid, method, binary_flag,
+                                 min_value, max_value, 0, n_cube_slices,
+                                 &slab, NULL, NULL );
+    }
+    else
+    {
+        /*--- the case tables are built on first use, so build them before
+              the threads start */
+
+        for_less( block, 0, 8 )
+            corners[block/4][(block/2)%2][block%2] = 0.0;
+        (void) compute_isosurface_in_voxel( method, 0, 0, 0, corners,
+                                            FALSE, 1.0, 1.0, &poly_sizes,
+                                            &edge_points );
+
+        n_blocks = MIN( n_cube_slices, BLOCKS_PER_THREAD * n_threads );
+
+        blocks.volume = volume;
+        blocks.pyramid = pyramid;
+        blocks.method = method;
+        blocks.binary_flag = binary_flag;
+        blocks.min_value = min_value;
+        blocks.max_value = max_value;
+        ALLOC( blocks.block_starts, n_blocks + 1 );
+        ALLOC( blocks.slabs, n_blocks );
+        ALLOC( blocks.first_ids, n_blocks );
+        ALLOC( blocks.last_ids, n_blocks );
+
+        for_inclusive( block, 0, n_blocks )
+            blocks.block_starts[block] = (int) ((long) block *
+                                                n_cube_slices / n_blocks);
+
+        do_parallel_jobs( n_threads, n_blocks, extract_isosurface_block,
+                          (void *) &blocks );
+
+        merge_isosurface_slabs( n_blocks, blocks.slabs, blocks.first_ids,
+                                blocks.last_ids,
+                                sizes[Y] * sizes[Z] *
+                                (get_max_marching_edges( method ) + 1),
+                                &slab );
+
+        for_less( block, 0, n_blocks )
+        {
+            FREE( blocks.first_ids[block] );
+            FREE( blocks.last_ids[block] );
+        }
+
+        FREE( blocks.block_starts );
+        FREE( blocks.slabs );
+        FREE( blocks.first_ids );
+        FREE( blocks.last_ids );
+    }
+
+    create_isosurface_polygons( volume, &slab, polygons );
+
+    return( TRUE );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : extract_isosurface
+@INPUT      : volume
+              method       - MARCHING_CUBES, MARCHING_NO_HOLES or
+                             MARCHING_TETRA
+              binary_flag  - if TRUE, the surface encloses the voxels with
+                             values in min_value .. max_value, otherwise it
+                             is the isosurface at min_value
+              min_value
+              max_value
+@OUTPUT     : polygons
+@RETURNS    : TRUE if successful
+@DESCRIPTION: Extracts the isosurface of a whole 3D volume, as a single
+              polygons structure in world coordinates.  Points shared by
+              neighbouring voxels are shared by their polygons, and each
+              point has a normal.
+@METHOD     : Marches through the volume one slice at a time, using
+              compute_isosurface_in_voxel() on each voxel.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  extract_isosurface(
+    Volume                  volume,
+    Marching_cubes_methods  method,
+    BOOLEAN                 binary_flag,
+    Real                    min_value,
+    Real                    max_value,
+    polygons_struct         *polygons )
+{
+    return( extract_isosurface_with_threads( volume, NULL, method,
+                                             binary_flag, min_value,
+                                             max_value, 1, polygons ) );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : extract_isosurface_in_parallel
+@INPUT      : volume
+              method
+              binary_flag
+              min_value
+              max_value
+              n_threads    - number of threads, or <= 0 for the default
+@OUTPUT     : polygons
+@RETURNS    : TRUE if successful
+@DESCRIPTION: Same as extract_isosurface(), but divides the volume into
+              blocks of slices along the first voxel axis, which are
+              extracted by several threads and then joined.  The points and
+              polygons are in exactly the same order as extract_isosurface()
+              produces, whatever the number of threads, so per-vertex data
+              remains comparable between runs.  Cached volumes are extracted
+              by a single thread.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  extract_isosurface_in_parallel(
+    Volume                  volume,
+    Marching_cubes_methods  method,
+    BOOLEAN                 binary_flag,
+    Real                    min_value,
+    Real                    max_value,
+    int                     n_threads,
+    polygons_struct         *polygons )
+{
+    return( extract_isosurface_with_threads( volume, NULL, method,
+                                             binary_flag, min_value,
+                                             max_value, n_threads,
+                                             polygons ) );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : extract_isosurface_with_pyramid
+@INPUT      : volume
+              pyramid      - from create_minmax_pyramid() on the volume
+              method
+              binary_flag
+              min_value
+              max_value
+              n_threads    - number of threads, or <= 0 for the default
+@OUTPUT     : polygons
+@RETURNS    : TRUE if successful
+@DESCRIPTION: Same as extract_isosurface_in_parallel(), but uses a min/max
+              pyramid of the volume to skip the blocks of voxels which
+              cannot contain the isosurface, which is most of a typical
+              volume.  The result is identical.  The pyramid may be reused
+              for any number of isovalues.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  extract_isosurface_with_pyramid(
+    Volume                  volume,
+    minmax_pyramid_struct   *pyramid,
+    Marching_cubes_methods  method,
+    BOOLEAN                 binary_flag,
+    Real                    min_value,
+    Real                    max_value,
+    int                     n_threads,
+    polygons_struct         *polygons )
+{
+    return( extract_isosurface_with_threads( volume, pyramid, method,
+                                             binary_flag, min_value,
+                                             max_value, n_threads,
+                                             polygons ) );
+}
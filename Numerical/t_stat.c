@@ -54,13 +54,17 @@ static  Real  evaluate_probability_t(
     int    v,
     Real   t )
 {
-    Real   gamma_top, gamma_bottom, top, bottom, p;
+    Real   gamma_ratio, top, bottom, p;
 
-    gamma_top = exp( gamma( ((Real) v + 1.0) / 2.0 ) );
-    gamma_bottom = exp( gamma( (Real) v / 2.0 ) );
+    /*--- gamma() is the log of the gamma function, so the ratio is taken
+          before exponentiating, which would overflow beyond about 340
+          degrees of freedom */
 
-    top = gamma_top * pow( 1.0 + t * t / (Real) v, - (Real) (v+1)/ 2.0 );
-    bottom = sqrt( (Real) v * PI ) * gamma_bottom;
+    gamma_ratio = exp( gamma( ((Real) v + 1.0) / 2.0 ) -
+                       gamma( (Real) v / 2.0 ) );
+
+    top = gamma_ratio * pow( 1.0 + t * t / (Real) v, - (Real) (v+1)/ 2.0 );
+    bottom = sqrt( (Real) v * PI );
 
     p = top / bottom;
 
@@ -126,8 +130,8 @@ static  Real  convert_t_stat_to_probability(
         ind = (int) (abs_t / interval_width);
         alpha1 = abs_t / interval_width - (Real) ind;
         alpha2 = (Real) (ind+1) - abs_t / interval_width;
-        value = alpha1 * cumulative_probs[ind] +
-                alpha2 * cumulative_probs[ind+1];
+        value = alpha2 * cumulative_probs[ind] +
+                alpha1 * cumulative_probs[ind+1];
     }
 
     if( t < 0.0 )
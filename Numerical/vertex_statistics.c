@@ -0,0 +1,694 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#include "bicpl_internal.h"
+#include  <stdlib.h>
+
+/*--- the vertices are processed in blocks of this size, each block being
+      one parallel job, small enough that a block of the data of all
+      subjects stays in cache while it is reused */
+
+#define  GLM_BLOCK_SIZE   64
+
+typedef  struct
+{
+    glm_design_struct  *design;
+    int                n_vertices;
+    nc_type            value_type;
+    void               *data;
+
+    Real               *contrast_weights;   /* --- contrast . beta */
+    Real               contrast_scale;      /* --- contrast variance / dof */
+    t_stat_struct      *t_stat;
+
+    Real               **workspaces;        /* --- one per thread */
+
+    Real               *t_values;
+    Real               *p_values;
+
+    int                n_permutations;
+    int                *permutations;       /* --- n_subjects each */
+    int                *vertex_counts;
+    Real               **thread_max_t;      /* --- n_permutations per thread */
+} glm_job_struct;
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : initialize_glm_design
+@INPUT      : n_subjects
+              n_regressors
+              design_matrix   - [n_subjects][n_regressors]
+@OUTPUT     : design
+@RETURNS    : TRUE if successful
+@DESCRIPTION: Factorizes the design matrix X of a general linear model
+              Y = X beta + error, fitted independently at each vertex, so
+              that it can be reused for any number of vertices, contrasts
+              and permutations.  The pseudo-inverse (X^T X)^-1 X^T and
+              (X^T X)^-1 are stored.  For a two sample t test, X has one
+              column for each group, set to 1 for the subjects of the group
+              and 0 otherwise, and the contrast is 1, -1.  Fails if the
+              design matrix is not of full rank or leaves no degrees of
+              freedom.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  initialize_glm_design(
+    glm_design_struct  *design,
+    int                n_subjects,
+    int                n_regressors,
+    Real               **design_matrix )
+{
+    int      s, i, j;
+    Real     **xtx, **inverse, sum;
+
+    if( n_regressors <= 0 || n_subjects <= n_regressors )
+    {
+        print_error( "initialize_glm_design: %d subjects leave no degrees "
+                     "of freedom for %d regressors.\n", n_subjects,
+                     n_regressors );
+        return( FALSE );
+    }
+
+    ALLOC2D( xtx, n_regressors, n_regressors );
+    ALLOC2D( inverse, n_regressors, n_regressors );
+
+    for_less( i, 0, n_regressors )
+    {
+        for_less( j, 0, n_regressors )
+        {
+            sum = 0.0;
+            for_less( s, 0, n_subjects )
+                sum += design_matrix[s][i] * design_matrix[s][j];
+            xtx[i][j] = sum;
+        }
+    }
+
+    if( !invert_square_matrix( n_regressors, xtx, inverse ) )
+    {
+        print_error( "initialize_glm_design: the design matrix is not of "
+                     "full rank.\n" );
+        FREE2D( xtx );
+        FREE2D( inverse );
+        return( FALSE );
+    }
+
+    design->n_subjects = n_subjects;
+    design->n_regressors = n_regressors;
+    design->degrees_freedom = n_subjects - n_regressors;
+
+    ALLOC( design->design, n_subjects * n_regressors );
+    ALLOC( design->pseudo_inverse, n_regressors * n_subjects );
+    ALLOC( design->covariance, n_regressors * n_regressors );
+
+    for_less( s, 0, n_subjects )
+    {
+        for_less( i, 0, n_regressors )
+            design->design[s * n_regressors + i] = design_matrix[s][i];
+    }
+
+    for_less( i, 0, n_regressors )
+    {
+        for_less( j, 0, n_regressors )
+            design->covariance[i * n_regressors + j] = inverse[i][j];
+
+        for_less( s, 0, n_subjects )
+        {
+            sum = 0.0;
+            for_less( j, 0, n_regressors )
+                sum += inverse[i][j] * design_matrix[s][j];
+            design->pseudo_inverse[i * n_subjects + s] = sum;
+        }
+    }
+
+    FREE2D( xtx );
+    FREE2D( inverse );
+
+    return( TRUE );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : delete_glm_design
+@INPUT      : design
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Deletes the design created by initialize_glm_design().
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  delete_glm_design(
+    glm_design_struct  *design )
+{
+    FREE( design->design );
+    FREE( design->pseudo_inverse );
+    FREE( design->covariance );
+}
+
+/*--- copies the values of a block of vertices for all subjects, taking
+      subject s from row permutation[s] of the data if permutation is not
+      NULL, into values[n_subjects][n_block] */
+
+static  void  get_glm_block_values(
+    glm_job_struct   *job,
+    int              first_vertex,
+    int              n_block,
+    int              permutation[],
+    Real             values[] )
+{
+    int      s, j, row;
+    size_t   offset;
+    float    *float_data;
+    double   *double_data;
+    Real     *row_values;
+
+    float_data = (float *) job->data;
+    double_data = (double *) job->data;
+
+    for_less( s, 0, job->design->n_subjects )
+    {
+        row = (permutation == NULL) ? s : permutation[s];
+        offset = (size_t) row * (size_t) job->n_vertices +
+                 (size_t) first_vertex;
+        row_values = &values[s * n_block];
+
+        if( job->value_type == NC_FLOAT )
+        {
+            for_less( j, 0, n_block )
+                row_values[j] = (Real) float_data[offset+j];
+        }
+        else
+        {
+            for_less( j, 0, n_block )
+                row_values[j] = (Real) double_data[offset+j];
+        }
+    }
+}
+
+/*--- fits the model to a block of vertices, whose values are in
+      values[n_subjects][n_block], and computes their t statistics.  All
+      inner loops run over the vertices of the block, which are
+      contiguous. */
+
+static  void  compute_glm_block_t_values(
+    glm_job_struct   *job,
+    int              n_block,
+    Real             values[],
+    Real             workspace[],
+    Real             t_values[] )
+{
+    glm_design_struct  *design;
+    int                s, k, j, n_subjects, n_regressors;
+    Real               *beta, *residual, *sse, *effect;
+    Real               weight, x, *row_values, *row_beta, variance;
+
+    design = job->design;
+    n_subjects = design->n_subjects;
+    n_regressors = design->n_regressors;
+
+    beta = workspace;
+    residual = &beta[n_regressors * GLM_BLOCK_SIZE];
+    sse = &residual[GLM_BLOCK_SIZE];
+    effect = &sse[GLM_BLOCK_SIZE];
+
+    /*--- beta = (X^T X)^-1 X^T Y */
+
+    for_less( k, 0, n_regressors )
+    {
+        row_beta = &beta[k * n_block];
+
+        for_less( j, 0, n_block )
+            row_beta[j] = 0.0;
+
+        for_less( s, 0, n_subjects )
+        {
+            weight = design->pseudo_inverse[k * n_subjects + s];
+            row_values = &values[s * n_block];
+
+            for_less( j, 0, n_block )
+                row_beta[j] += weight * row_values[j];
+        }
+    }
+
+    /*--- sum of squared residuals of Y - X beta */
+
+    for_less( j, 0, n_block )
+        sse[j] = 0.0;
+
+    for_less( s, 0, n_subjects )
+    {
+        row_values = &values[s * n_block];
+
+        for_less( j, 0, n_block )
+            residual[j] = row_values[j];
+
+        for_less( k, 0, n_regressors )
+        {
+            x = design->design[s * n_regressors + k];
+            row_beta = &beta[k * n_block];
+
+            for_less( j, 0, n_block )
+                residual[j] -= x * row_beta[j];
+        }
+
+        for_less( j, 0, n_block )
+            sse[j] += residual[j] * residual[j];
+    }
+
+    /*--- t = contrast . beta / its standard error */
+
+    for_less( j, 0, n_block )
+        effect[j] = 0.0;
+
+    for_less( k, 0, n_regressors )
+    {
+        weight = job->contrast_weights[k];
+        row_beta = &beta[k * n_block];
+
+        for_less( j, 0, n_block )
+            effect[j] += weight * row_beta[j];
+    }
+
+    for_less( j, 0, n_block )
+    {
+        variance = job->contrast_scale * sse[j];
+
+        if( variance <= 0.0 )
+            t_values[j] = 0.0;
+        else
+            t_values[j] = effect[j] / sqrt( variance );
+    }
+}
+
+/*--- the two sided probability of a t statistic at least as large */
+
+static  Real  get_two_sided_t_probability(
+    t_stat_struct  *t_stat,
+    Real           t )
+{
+    Real   p;
+
+    p = 2.0 * (1.0 - get_cumulative_t_stat( t_stat, FABS( t ) ));
+
+    return( MAX( 0.0, MIN( 1.0, p ) ) );
+}
+
+static  void  glm_t_statistics_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    glm_job_struct   *job;
+    int              first_vertex, n_block, j;
+    Real             *values;
+
+    job = (glm_job_struct *) data;
+
+    first_vertex = block * GLM_BLOCK_SIZE;
+    n_block = MIN( GLM_BLOCK_SIZE, job->n_vertices - first_vertex );
+    values = job->workspaces[thread];
+
+    get_glm_block_values( job, first_vertex, n_block, NULL, values );
+
+    compute_glm_block_t_values( job, n_block, values,
+                                &values[job->design->n_subjects *
+                                        GLM_BLOCK_SIZE],
+                                &job->t_values[first_vertex] );
+
+    if( job->p_values != NULL )
+    {
+        for_less( j, 0, n_block )
+        {
+            job->p_values[first_vertex+j] = get_two_sided_t_probability(
+                             job->t_stat, job->t_values[first_vertex+j] );
+        }
+    }
+}
+
+/*--- every permutation of one block of vertices, counting for each vertex
+      the permuted statistics at least as large as the observed one, and
+      recording the largest of the block for each permutation */
+
+static  void  glm_permutations_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    glm_job_struct   *job;
+    int              first_vertex, n_block, j, perm, n_subjects;
+    Real             *values, *workspace, *t_values, *max_t, abs_t;
+
+    job = (glm_job_struct *) data;
+    n_subjects = job->design->n_subjects;
+
+    first_vertex = block * GLM_BLOCK_SIZE;
+    n_block = MIN( GLM_BLOCK_SIZE, job->n_vertices - first_vertex );
+    values = job->workspaces[thread];
+    workspace = &values[n_subjects * GLM_BLOCK_SIZE];
+    t_values = &workspace[(job->design->n_regressors + 3) * GLM_BLOCK_SIZE];
+    max_t = job->thread_max_t[thread];
+
+    for_less( perm, 0, job->n_permutations )
+    {
+        get_glm_block_values( job, first_vertex, n_block,
+                              &job->permutations[perm * n_subjects], values );
+
+        compute_glm_block_t_values( job, n_block, values, workspace,
+                                    t_values );
+
+        for_less( j, 0, n_block )
+        {
+            abs_t = FABS( t_values[j] );
+
+            if( abs_t >= FABS( job->t_values[first_vertex+j] ) )
+                ++job->vertex_counts[first_vertex+j];
+
+            if( abs_t > max_t[perm] )
+                max_t[perm] = abs_t;
+        }
+    }
+}
+
+/*--- sets up the parts of the job common to all computations, with one
+      workspace per thread */
+
+static  void  initialize_glm_job(
+    glm_job_struct     *job,
+    glm_design_struct  *design,
+    Real               contrast[],
+    int                n_vertices,
+    nc_type            value_type,
+    void               *data,
+    int                n_threads )
+{
+    int    i, j, n_regressors;
+    Real   contrast_variance;
+
+    n_regressors = design->n_regressors;
+
+    job->design = design;
+    job->n_vertices = n_vertices;
+    job->value_type = value_type;
+    job->data = data;
+    job->t_stat = NULL;
+    job->p_values = NULL;
+
+    ALLOC( job->contrast_weights, n_regressors );
+    contrast_variance = 0.0;
+
+    for_less( i, 0, n_regressors )
+    {
+        job->contrast_weights[i] = contrast[i];
+
+        for_less( j, 0, n_regressors )
+        {
+            contrast_variance += contrast[i] * contrast[j] *
+                                 design->covariance[i * n_regressors + j];
+        }
+    }
+
+    job->contrast_scale = contrast_variance / (Real) design->degrees_freedom;
+
+    ALLOC( job->workspaces, n_threads );
+    for_less( i, 0, n_threads )
+    {
+        ALLOC( job->workspaces[i], (design->n_subjects + n_regressors + 4) *
+                                   GLM_BLOCK_SIZE );
+    }
+}
+
+static  void  delete_glm_job(
+    glm_job_struct     *job,
+    int                n_threads )
+{
+    int    i;
+
+    for_less( i, 0, n_threads )
+        FREE( job->workspaces[i] );
+
+    FREE( job->workspaces );
+    FREE( job->contrast_weights );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : compute_glm_t_statistics
+@INPUT      : design      - from initialize_glm_design()
+              contrast    - n_regressors weights of the regressors
+              n_vertices
+              value_type  - NC_FLOAT or NC_DOUBLE
+              data        - [n_subjects][n_vertices] floats or doubles, as
+                            read by input_texture_values_matrix()
+              n_threads   - number of threads, or <= 0 for the default
+@OUTPUT     : t_values    - n_vertices t statistics of the contrast
+              p_values    - NULL, or n_vertices two sided probabilities
+@RETURNS    :
+@DESCRIPTION: Fits the general linear model independently at each vertex
+              and computes the t statistic of the contrast of its
+              parameters, with design->degrees_freedom degrees of freedom,
+              and optionally its two sided probability.  Vertices where the
+              model fits exactly have a t statistic of 0.
+@METHOD     : The vertices are processed in parallel blocks, fitting all
+              vertices of a block together with loops over contiguous
+              values.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  compute_glm_t_statistics(
+    glm_design_struct  *design,
+    Real               contrast[],
+    int                n_vertices,
+    nc_type            value_type,
+    void               *data,
+    int                n_threads,
+    Real               t_values[],
+    Real               p_values[] )
+{
+    int              n_blocks;
+    glm_job_struct   job;
+    t_stat_struct    t_stat;
+
+    n_blocks = (n_vertices + GLM_BLOCK_SIZE - 1) / GLM_BLOCK_SIZE;
+    if( n_blocks == 0 )
+        return;
+
+    n_threads = get_n_threads_to_use( n_threads, n_blocks );
+
+    initialize_glm_job( &job, design, contrast, n_vertices, value_type, data,
+                        n_threads );
+
+    job.t_values = t_values;
+    job.p_values = p_values;
+
+    if( p_values != NULL )
+    {
+        initialize_cumulative_t_stat( &t_stat, design->degrees_freedom );
+        job.t_stat = &t_stat;
+    }
+
+    do_parallel_jobs( n_threads, n_blocks, glm_t_statistics_block,
+                      (void *) &job );
+
+    if( p_values != NULL )
+        delete_cumulative_t_stat( &t_stat );
+
+    delete_glm_job( &job, n_threads );
+}
+
+/*--- used to sort the maximum statistics of the permutations */
+
+static  int  compare_reals(
+    const void   *r1,
+    const void   *r2 )
+{
+    Real   v1, v2;
+
+    v1 = *((Real *) r1);
+    v2 = *((Real *) r2);
+
+    if( v1 < v2 )
+        return( -1 );
+    else if( v1 > v2 )
+        return( 1 );
+    else
+        return( 0 );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : compute_glm_permutation_probabilities
+@INPUT      : design          - from initialize_glm_design()
+              contrast        - n_regressors weights of the regressors
+              n_vertices
+              value_type      - NC_FLOAT or NC_DOUBLE
+              data            - [n_subjects][n_vertices] floats or doubles
+              n_permutations
+              n_threads       - number of threads, or <= 0 for the default
+@OUTPUT     : t_values        - n_vertices t statistics of the contrast
+              uncorrected_p   - NULL, or n_vertices two sided permutation
+                                probabilities of each vertex
+              corrected_p     - NULL, or n_vertices two sided probabilities
+                                corrected for all vertices by the maximum
+                                statistic over vertices
+@RETURNS    :
+@DESCRIPTION: Computes the t statistics of the contrast as
+              compute_glm_t_statistics() does, then the probabilities of
+              statistics as large under random permutations of the
+              subjects.  The probability of a vertex is
+              (1 + n) / (1 + n_permutations), where n is the number of
+              permutations with an absolute statistic at least as large,
+              at the vertex for uncorrected_p, or anywhere for corrected_p.
+              The permutations are drawn with get_random_int(), so
+              set_random_seed() makes them repeatable.  The subjects are
+              assumed exchangeable under the null hypothesis.
+@METHOD     : The design is factorized once, and the permutations applied
+              to the data.  Each parallel job runs all the permutations for
+              one block of vertices, so that the block is read from
+              memory once, and each thread keeps the maximum statistic of
+              each permutation over its blocks.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  compute_glm_permutation_probabilities(
+    glm_design_struct  *design,
+    Real               contrast[],
+    int                n_vertices,
+    nc_type            value_type,
+    void               *data,
+    int                n_permutations,
+    int                n_threads,
+    Real               t_values[],
+    Real               uncorrected_p[],
+    Real               corrected_p[] )
+{
+    int              n_blocks, perm, s, i, tmp, thread, v, n_subjects;
+    int              low, high, mid, *permutation;
+    Real             *max_t, abs_t;
+    glm_job_struct   job;
+
+    compute_glm_t_statistics( design, contrast, n_vertices, value_type, data,
+                              n_threads, t_values, NULL );
+
+    n_blocks = (n_vertices + GLM_BLOCK_SIZE - 1) / GLM_BLOCK_SIZE;
+    if( n_blocks == 0 || n_permutations <= 0 )
+        return;
+
+    n_threads = get_n_threads_to_use( n_threads, n_blocks );
+    n_subjects = design->n_subjects;
+
+    initialize_glm_job( &job, design, contrast, n_vertices, value_type, data,
+                        n_threads );
+
+    job.t_values = t_values;
+    job.n_permutations = n_permutations;
+
+    ALLOC( job.permutations, n_permutations * n_subjects );
+
+    for_less( perm, 0, n_permutations )
+    {
+        permutation = &job.permutations[perm * n_subjects];
+
+        for_less( s, 0, n_subjects )
+            permutation[s] = s;
+
+        for( s = n_subjects - 1;  s > 0;  --s )
+        {
+            i = get_random_int( s + 1 );
+            tmp = permutation[s];
+            permutation[s] = permutation[i];
+            permutation[i] = tmp;
+        }
+    }
+
+    ALLOC( job.vertex_counts, n_vertices );
+    for_less( v, 0, n_vertices )
+        job.vertex_counts[v] = 0;
+
+    ALLOC( job.thread_max_t, n_threads );
+    for_less( thread, 0, n_threads )
+    {
+        ALLOC( job.thread_max_t[thread], n_permutations );
+        for_less( perm, 0, n_permutations )
+            job.thread_max_t[thread][perm] = 0.0;
+    }
+
+    do_parallel_jobs( n_threads, n_blocks, glm_permutations_block,
+                      (void *) &job );
+
+    if( uncorrected_p != NULL )
+    {
+        for_less( v, 0, n_vertices )
+        {
+            uncorrected_p[v] = (Real) (1 + job.vertex_counts[v]) /
+                               (Real) (1 + n_permutations);
+        }
+    }
+
+    if( corrected_p != NULL )
+    {
+        ALLOC( max_t, n_permutations );
+
+        for_less( perm, 0, n_permutations )
+        {
+            max_t[perm] = 0.0;
+            for_less( thread, 0, n_threads )
+                max_t[perm] = MAX( max_t[perm],
+                                   job.thread_max_t[thread][perm] );
+        }
+
+        qsort( (void *) max_t, (size_t) n_permutations, sizeof( max_t[0] ),
+               compare_reals );
+
+        /*--- the number of permutation maxima >= |t| is n_permutations
+              less the number below it, found by binary search */
+
+        for_less( v, 0, n_vertices )
+        {
+            abs_t = FABS( t_values[v] );
+            low = 0;
+            high = n_permutations;
+
+            while( low < high )
+            {
+                mid = (low + high) / 2;
+                if( max_t[mid] < abs_t )
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+
+            corrected_p[v] = (Real) (1 + n_permutations - low) /
+                             (Real) (1 + n_permutations);
+        }
+
+        FREE( max_t );
+    }
+
+    for_less( thread, 0, n_threads )
+        FREE( job.thread_max_t[thread] );
+    FREE( job.thread_max_t );
+    FREE( job.vertex_counts );
+    FREE( job.permutations );
+
+    delete_glm_job( &job, n_threads );
+}
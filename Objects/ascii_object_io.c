@@ -0,0 +1,1334 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#include "bicpl_internal.h"
+#include  <float.h>
+#include  <math.h>
+
+/*--- Block-buffered versions of the ascii branches of io_lines(),
+      io_polygons() and io_quadmesh().  They make the same sequence of
+      reads and writes as the volume_io routines io_float(), io_int() and
+      io_newline() used by those, so the files and objects are identical,
+      but parse and format the numbers directly in a large buffer instead
+      of calling fscanf() and fprintf() for each one. */
+
+#define  ASCII_BUFFER_SIZE     65536
+
+/*--- a number is parsed in place once this many characters are buffered,
+      so longer tokens are the only ones split by a buffer refill */
+
+#define  MAX_TOKEN_LENGTH      128
+
+/*--- as io_ints() in volume_io, which ends a line after every few ints */
+
+#define  INTS_PER_LINE         8
+
+typedef  struct
+{
+    FILE       *file;
+    IO_types   io_flag;
+    char       *buffer;
+    size_t     pos;
+    size_t     end;
+    BOOLEAN    at_eof;
+} ascii_stream_struct;
+
+static  BOOLEAN  fast_ascii_io = TRUE;
+static  BOOLEAN  fast_ascii_io_initialized = FALSE;
+
+static  BOOLEAN  use_fast_ascii_io( void )
+{
+    if( !fast_ascii_io_initialized )
+    {
+        fast_ascii_io_initialized = TRUE;
+        fast_ascii_io = getenv( "NO_FAST_ASCII_OBJECTS" ) == NULL;
+    }
+
+    return( fast_ascii_io );
+}
+
+BICAPI  void  set_fast_ascii_object_io_flag(
+    BOOLEAN  value )
+{
+    fast_ascii_io = value;
+    fast_ascii_io_initialized = TRUE;
+}
+
+BICAPI  BOOLEAN  get_fast_ascii_object_io_flag( void )
+{
+    return( use_fast_ascii_io() );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : can_use_fast_ascii_io
+@INPUT      : file
+              io_flag
+@OUTPUT     :
+@RETURNS    : TRUE if the buffered ascii routines may be used on the file
+@DESCRIPTION: The buffered routines are used unless turned off with
+              set_fast_ascii_object_io_flag() or the environment variable
+              NO_FAST_ASCII_OBJECTS.  When reading, they read ahead and then
+              seek back to the end of the object, so they are not used on
+              files which cannot seek.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  can_use_fast_ascii_io(
+    FILE      *file,
+    IO_types  io_flag )
+{
+    if( !use_fast_ascii_io() )
+        return( FALSE );
+
+    return( io_flag == WRITE_FILE || fseek( file, 0L, SEEK_CUR ) == 0 );
+}
+
+static  void  open_ascii_stream(
+    ascii_stream_struct  *stream,
+    FILE                 *file,
+    IO_types             io_flag )
+{
+    stream->file = file;
+    stream->io_flag = io_flag;
+    ALLOC( stream->buffer, ASCII_BUFFER_SIZE + 1 );
+    stream->pos = 0;
+    stream->end = 0;
+    stream->at_eof = FALSE;
+    stream->buffer[0] = (char) 0;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : sync_ascii_stream
+@INPUT      : stream
+@OUTPUT     :
+@RETURNS    : OK or ERROR
+@DESCRIPTION: Brings the file position up to date with the stream, writing
+              out the buffered output, or seeking back over the input read
+              ahead but not used, so that the file can be used directly.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  Status  sync_ascii_stream(
+    ascii_stream_struct  *stream )
+{
+    Status   status;
+
+    status = OK;
+
+    if( stream->io_flag == WRITE_FILE )
+    {
+        if( stream->end > 0 &&
+            fwrite( stream->buffer, 1, stream->end, stream->file ) !=
+                                                               stream->end )
+        {
+            print_error( "Error outputting ascii object.\n" );
+            status = ERROR;
+        }
+    }
+    else if( stream->end > stream->pos )
+    {
+        if( fseek( stream->file, -(long) (stream->end - stream->pos),
+                   SEEK_CUR ) != 0 )
+        {
+            print_error( "Error repositioning in ascii object.\n" );
+            status = ERROR;
+        }
+    }
+
+    stream->pos = 0;
+    stream->end = 0;
+    stream->at_eof = FALSE;
+    stream->buffer[0] = (char) 0;
+
+    return( status );
+}
+
+static  Status  close_ascii_stream(
+    ascii_stream_struct  *stream )
+{
+    Status   status;
+
+    status = sync_ascii_stream( stream );
+
+    FREE( stream->buffer );
+
+    return( status );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : fill_ascii_stream
+@INPUT      : stream
+              n_wanted
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Makes sure at least n_wanted characters are buffered for
+              reading, unless the end of the file is reached, keeping the
+              buffer terminated by a null character.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  fill_ascii_stream(
+    ascii_stream_struct  *stream,
+    size_t               n_wanted )
+{
+    size_t   n_read;
+
+    if( stream->end - stream->pos >= n_wanted || stream->at_eof )
+        return;
+
+    if( stream->pos > 0 )
+    {
+        (void) memmove( stream->buffer, &stream->buffer[stream->pos],
+                        stream->end - stream->pos );
+        stream->end -= stream->pos;
+        stream->pos = 0;
+    }
+
+    while( stream->end < n_wanted && !stream->at_eof )
+    {
+        n_read = fread( &stream->buffer[stream->end], 1,
+                        ASCII_BUFFER_SIZE - stream->end, stream->file );
+
+        if( n_read == 0 )
+            stream->at_eof = TRUE;
+
+        stream->end += n_read;
+    }
+
+    stream->buffer[stream->end] = (char) 0;
+}
+
+static  BOOLEAN  is_white_space(
+    char  ch )
+{
+    return( ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' ||
+            ch == '\v' || ch == '\f' );
+}
+
+/*--- skips white space, returning FALSE at the end of the file */
+
+static  BOOLEAN  skip_white_space(
+    ascii_stream_struct  *stream )
+{
+    for( ;; )
+    {
+        while( stream->pos < stream->end &&
+               is_white_space( stream->buffer[stream->pos] ) )
+            ++stream->pos;
+
+        if( stream->pos < stream->end )
+            return( TRUE );
+
+        fill_ascii_stream( stream, ASCII_BUFFER_SIZE );
+
+        if( stream->pos >= stream->end )
+            return( FALSE );
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : parse_float
+@INPUT      : str
+@OUTPUT     : value
+@RETURNS    : pointer past the number, or NULL if there is none
+@DESCRIPTION: Converts a number to the nearest float, exactly as strtof()
+              and the "%f" conversion of fscanf() do.
+@METHOD     : The common case, a decimal number with at most 19 significant
+              digits and a small exponent, is converted with one correctly
+              rounded double operation, as the digits and the power of ten
+              are both exact doubles.  Rounding that to float gives the
+              nearest float unless the double falls exactly halfway between
+              two floats.  Anything else, including that case, is passed to
+              strtof().
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  char  *parse_float(
+    char    *str,
+    float   *value )
+{
+    static  const  double  powers_of_ten[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5,
+                                               1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                               1e12, 1e13, 1e14, 1e15, 1e16,
+                                               1e17, 1e18, 1e19, 1e20, 1e21,
+                                               1e22 };
+    char                *p, *end;
+    BOOLEAN             negative, exact, exp_negative;
+    int                 n_digits, n_significant, exponent, exp_value;
+    unsigned long long  mantissa;
+    double              d;
+    float               f, neighbour;
+
+    p = str;
+    negative = FALSE;
+    if( *p == '+' || *p == '-' )
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    mantissa = 0;
+    n_digits = 0;
+    n_significant = 0;
+    exponent = 0;
+    exact = TRUE;
+
+    while( *p >= '0' && *p <= '9' )
+    {
+        if( n_significant < 19 )
+        {
+            mantissa = 10 * mantissa + (unsigned long long) (*p - '0');
+            if( mantissa > 0 )
+                ++n_significant;
+        }
+        else
+        {
+            ++exponent;
+            exact = FALSE;
+        }
+        ++n_digits;
+        ++p;
+    }
+
+    if( *p == '.' )
+    {
+        ++p;
+        while( *p >= '0' && *p <= '9' )
+        {
+            if( n_significant < 19 )
+            {
+                mantissa = 10 * mantissa + (unsigned long long) (*p - '0');
+                if( mantissa > 0 )
+                    ++n_significant;
+                --exponent;
+            }
+            else
+                exact = FALSE;
+            ++n_digits;
+            ++p;
+        }
+    }
+
+    if( n_digits > 0 && (*p == 'e' || *p == 'E') &&
+        ((p[1] >= '0' && p[1] <= '9') ||
+         ((p[1] == '+' || p[1] == '-') && p[2] >= '0' && p[2] <= '9')) )
+    {
+        ++p;
+        exp_negative = (*p == '-');
+        if( *p == '+' || *p == '-' )
+            ++p;
+
+        exp_value = 0;
+        while( *p >= '0' && *p <= '9' )
+        {
+            if( exp_value < 10000 )
+                exp_value = 10 * exp_value + (*p - '0');
+            ++p;
+        }
+
+        exponent += exp_negative ? -exp_value : exp_value;
+    }
+
+    /*--- anything unusual, such as hexadecimal, infinity or a number
+          running into other characters, is left to strtof() */
+
+    if( n_digits == 0 || !exact || (*p != (char) 0 && !is_white_space( *p )) ||
+        mantissa > ((unsigned long long) 1 << 53) ||
+        exponent < -22 || exponent > 22 )
+    {
+        f = strtof( str, &end );
+        if( end == str )
+            return( NULL );
+        *value = f;
+        return( end );
+    }
+
+    if( mantissa == 0 )
+    {
+        *value = negative ? -0.0f : 0.0f;
+        return( p );
+    }
+
+    if( exponent >= 0 )
+        d = (double) mantissa * powers_of_ten[exponent];
+    else
+        d = (double) mantissa / powers_of_ten[-exponent];
+
+    f = (float) d;
+
+    if( d < (double) FLT_MIN || d > (double) FLT_MAX )
+    {
+        *value = strtof( str, &end );
+        return( end );
+    }
+
+    if( (double) f != d )
+    {
+        neighbour = nextafterf( f, (double) f < d ? FLT_MAX : 0.0f );
+
+        if( ((double) f + (double) neighbour) / 2.0 == d )
+        {
+            f = strtof( str, &end );
+            *value = f;
+            return( end );
+        }
+    }
+
+    *value = negative ? -f : f;
+
+    return( p );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : format_float
+@INPUT      : value
+@OUTPUT     : str
+@RETURNS    : length of the string
+@DESCRIPTION: Formats a float exactly as the "%g" conversion of printf().
+@METHOD     : The 6 significant digits are found by scaling by an exact power
+              of ten in double precision, which has a relative error of at
+              most 2^-53.  That does not change the rounding to an integer
+              unless the scaled value is within about 1e-10 of halfway
+              between integers, and those cases, along with values too large
+              or small for an exact power of ten, are left to sprintf().
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  int  format_float(
+    float   value,
+    char    str[] )
+{
+    static  const  double  powers_of_ten[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5,
+                                               1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                               1e12, 1e13, 1e14, 1e15, 1e16,
+                                               1e17, 1e18, 1e19, 1e20, 1e21,
+                                               1e22 };
+    int      exponent, scale, n_digits, len, i, point, last;
+    long     n;
+    double   v, scaled, fraction;
+    char     digits[6];
+
+    v = fabs( (double) value );
+    len = 0;
+
+    if( v == 0.0 )
+    {
+        if( signbit( value ) )
+            str[len++] = '-';
+        str[len++] = '0';
+        str[len] = (char) 0;
+        return( len );
+    }
+
+    if( !(v <= (double) FLT_MAX) )
+        return( sprintf( str, "%g", (double) value ) );
+
+    exponent = (int) floor( log10( v ) );
+
+    for( i = 0;  i < 3;  ++i )
+    {
+        scale = 5 - exponent;
+        if( scale > 22 || scale < -22 )
+            return( sprintf( str, "%g", (double) value ) );
+
+        if( scale >= 0 )
+            scaled = v * powers_of_ten[scale];
+        else
+            scaled = v / powers_of_ten[-scale];
+
+        if( scaled < 99999.5 )
+            --exponent;
+        else if( scaled >= 999999.5 )
+            ++exponent;
+        else
+            break;
+    }
+
+    if( i == 3 )
+        return( sprintf( str, "%g", (double) value ) );
+
+    fraction = scaled - floor( scaled );
+    if( fabs( fraction - 0.5 ) < 1e-9 )
+        return( sprintf( str, "%g", (double) value ) );
+
+    n = (long) (scaled + 0.5);
+
+    for( i = 5;  i >= 0;  --i )
+    {
+        digits[i] = (char) ('0' + n % 10);
+        n /= 10;
+    }
+
+    /*--- trailing zeros are removed, as by %g */
+
+    n_digits = 6;
+    while( n_digits > 1 && digits[n_digits-1] == '0' )
+        --n_digits;
+
+    if( value < 0.0f )
+        str[len++] = '-';
+
+    if( exponent < -4 || exponent >= 6 )
+    {
+        str[len++] = digits[0];
+        if( n_digits > 1 )
+        {
+            str[len++] = '.';
+            for_less( i, 1, n_digits )
+                str[len++] = digits[i];
+        }
+
+        str[len++] = 'e';
+        str[len++] = (exponent < 0) ? '-' : '+';
+        if( exponent < 0 )
+            exponent = -exponent;
+        if( exponent >= 100 )
+            str[len++] = (char) ('0' + exponent / 100);
+        str[len++] = (char) ('0' + (exponent / 10) % 10);
+        str[len++] = (char) ('0' + exponent % 10);
+    }
+    else if( exponent >= 0 )
+    {
+        point = exponent + 1;
+        last = MAX( n_digits, point );
+        for_less( i, 0, last )
+        {
+            if( i == point )
+                str[len++] = '.';
+            str[len++] = digits[i];
+        }
+    }
+    else
+    {
+        str[len++] = '0';
+        str[len++] = '.';
+        for_less( i, 0, -exponent - 1 )
+            str[len++] = '0';
+        for_less( i, 0, n_digits )
+            str[len++] = digits[i];
+    }
+
+    str[len] = (char) 0;
+
+    return( len );
+}
+
+/*--- formats an int as "%d" does */
+
+static  int  format_int(
+    int     value,
+    char    str[] )
+{
+    unsigned int  u;
+    int           len, i;
+    char          digits[12];
+
+    len = 0;
+    if( value < 0 )
+    {
+        str[len++] = '-';
+        u = 0u - (unsigned int) value;
+    }
+    else
+        u = (unsigned int) value;
+
+    i = 0;
+    do
+    {
+        digits[i++] = (char) ('0' + u % 10);
+        u /= 10;
+    }
+    while( u > 0 );
+
+    while( i > 0 )
+        str[len++] = digits[--i];
+
+    str[len] = (char) 0;
+
+    return( len );
+}
+
+/*--- makes room for n characters of output */
+
+static  Status  reserve_output(
+    ascii_stream_struct  *stream,
+    size_t               n )
+{
+    if( stream->end + n > ASCII_BUFFER_SIZE )
+        return( sync_ascii_stream( stream ) );
+
+    return( OK );
+}
+
+static  Status  ascii_io_float(
+    ascii_stream_struct  *stream,
+    float                *value )
+{
+    Status   status;
+    char     *end;
+
+    if( stream->io_flag == WRITE_FILE )
+    {
+        status = reserve_output( stream, 64 );
+        if( status == OK )
+        {
+            stream->buffer[stream->end++] = ' ';
+            stream->end += (size_t) format_float( *value,
+                                          &stream->buffer[stream->end] );
+        }
+        return( status );
+    }
+
+    if( !skip_white_space( stream ) )
+        return( ERROR );
+
+    fill_ascii_stream( stream, MAX_TOKEN_LENGTH );
+
+    end = parse_float( &stream->buffer[stream->pos], value );
+
+    if( end == NULL )
+        return( ERROR );
+
+    stream->pos = (size_t) (end - stream->buffer);
+
+    return( OK );
+}
+
+static  Status  ascii_io_int(
+    ascii_stream_struct  *stream,
+    int                  *value )
+{
+    Status   status;
+    char     *p, *start;
+    BOOLEAN  negative;
+    long     n;
+    int      n_digits;
+
+    if( stream->io_flag == WRITE_FILE )
+    {
+        status = reserve_output( stream, 16 );
+        if( status == OK )
+        {
+            stream->buffer[stream->end++] = ' ';
+            stream->end += (size_t) format_int( *value,
+                                          &stream->buffer[stream->end] );
+        }
+        return( status );
+    }
+
+    if( !skip_white_space( stream ) )
+        return( ERROR );
+
+    fill_ascii_stream( stream, MAX_TOKEN_LENGTH );
+
+    start = &stream->buffer[stream->pos];
+    p = start;
+
+    negative = FALSE;
+    if( *p == '+' || *p == '-' )
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    n = 0;
+    n_digits = 0;
+    while( *p >= '0' && *p <= '9' )
+    {
+        if( n_digits < 9 )
+            n = 10 * n + (*p - '0');
+        ++n_digits;
+        ++p;
+    }
+
+    if( n_digits == 0 )
+        return( ERROR );
+
+    if( n_digits > 9 )
+        n = strtol( start, &p, 10 );
+    else if( negative )
+        n = -n;
+
+    *value = (int) n;
+    stream->pos = (size_t) (p - stream->buffer);
+
+    return( OK );
+}
+
+/*--- as io_newline(), which on input skips the rest of the line */
+
+static  Status  ascii_io_newline(
+    ascii_stream_struct  *stream )
+{
+    Status   status;
+    char     *newline;
+
+    if( stream->io_flag == WRITE_FILE )
+    {
+        status = reserve_output( stream, 1 );
+        if( status == OK )
+            stream->buffer[stream->end++] = '\n';
+        return( status );
+    }
+
+    for( ;; )
+    {
+        newline = (char *) memchr( &stream->buffer[stream->pos], '\n',
+                                   stream->end - stream->pos );
+
+        if( newline != NULL )
+        {
+            stream->pos = (size_t) (newline - stream->buffer) + 1;
+            return( OK );
+        }
+
+        stream->pos = stream->end;
+        fill_ascii_stream( stream, ASCII_BUFFER_SIZE );
+
+        if( stream->pos >= stream->end )
+        {
+            print_error( "Error inputting newline.\n" );
+            return( ERROR );
+        }
+    }
+}
+
+static  Status  ascii_io_object_type(
+    ascii_stream_struct  *stream,
+    char                 ch )
+{
+    Status   status;
+
+    status = OK;
+
+    if( stream->io_flag == WRITE_FILE )
+    {
+        status = reserve_output( stream, 1 );
+        if( status == OK )
+            stream->buffer[stream->end++] = ch;
+    }
+
+    return( status );
+}
+
+static  Status  ascii_io_boolean(
+    ascii_stream_struct  *stream,
+    BOOLEAN              *value )
+{
+    Status   status;
+
+    /*--- rare enough to hand to volume_io */
+
+    status = sync_ascii_stream( stream );
+
+    if( status == OK )
+        status = io_boolean( stream->file, stream->io_flag, ASCII_FORMAT,
+                             value );
+
+    return( status );
+}
+
+static  Status  ascii_io_surfprop(
+    ascii_stream_struct  *stream,
+    Surfprop             *surfprop )
+{
+    Status   status;
+
+    status = ascii_io_float( stream, &Surfprop_a(*surfprop) );
+
+    if( status == OK )
+        status = ascii_io_float( stream, &Surfprop_d(*surfprop) );
+
+    if( status == OK )
+        status = ascii_io_float( stream, &Surfprop_s(*surfprop) );
+
+    if( status == OK )
+        status = ascii_io_float( stream, &Surfprop_se(*surfprop) );
+
+    if( status == OK )
+        status = ascii_io_float( stream, &Surfprop_t(*surfprop) );
+
+    if( stream->io_flag == READ_FILE && Surfprop_t(*surfprop) == 0.0f )
+        Surfprop_t(*surfprop) = 1.0f;
+
+    return( status );
+}
+
+static  Status  ascii_io_points(
+    ascii_stream_struct  *stream,
+    int                  n,
+    Point                *points[] )
+{
+    Status   status;
+    int      i;
+
+    status = OK;
+
+    if( stream->io_flag == READ_FILE )
+    {
+        ALLOC( *points, n );
+    }
+
+    for_less( i, 0, n )
+    {
+        status = ascii_io_float( stream, &Point_x((*points)[i]) );
+
+        if( status == OK )
+            status = ascii_io_float( stream, &Point_y((*points)[i]) );
+
+        if( status == OK )
+            status = ascii_io_float( stream, &Point_z((*points)[i]) );
+
+        if( status == OK )
+            status = ascii_io_newline( stream );
+
+        if( status == ERROR )
+            break;
+    }
+
+    return( status );
+}
+
+static  Status  ascii_io_vectors(
+    ascii_stream_struct  *stream,
+    int                  n,
+    Vector               *vectors[] )
+{
+    Status   status;
+    int      i;
+
+    status = OK;
+
+    if( stream->io_flag == READ_FILE )
+    {
+        ALLOC( *vectors, n );
+    }
+
+    for_less( i, 0, n )
+    {
+        status = ascii_io_float( stream, &Vector_x((*vectors)[i]) );
+
+        if( status == OK )
+            status = ascii_io_float( stream, &Vector_y((*vectors)[i]) );
+
+        if( status == OK )
+            status = ascii_io_float( stream, &Vector_z((*vectors)[i]) );
+
+        if( status == OK )
+            status = ascii_io_newline( stream );
+
+        if( status == ERROR )
+            break;
+    }
+
+    return( status );
+}
+
+static  Status  ascii_io_colours(
+    ascii_stream_struct  *stream,
+    Colour_flags         *colour_flag,
+    int                  n_items,
+    int                  n_points,
+    Colour               **colours )
+{
+    int      i, n_colours;
+    float    r, g, b, a;
+    Status   status;
+
+    n_colours = 0;
+
+    status = ascii_io_int( stream, (int *) colour_flag );
+
+    if( status == OK )
+    {
+        switch( *colour_flag )
+        {
+        case ONE_COLOUR:          n_colours = 1;   break;
+        case PER_ITEM_COLOURS:    n_colours = n_items;   break;
+        case PER_VERTEX_COLOURS:  n_colours = n_points;   break;
+        default:
+            print_error( "Error inputting colour flag.\n" );
+            status = ERROR;
+            break;
+        }
+    }
+
+    if( status == OK && stream->io_flag == READ_FILE && n_colours > 0 )
+        ALLOC( *colours, n_colours );
+
+    if( status == OK )
+    {
+        for_less( i, 0, n_colours )
+        {
+            if( stream->io_flag == WRITE_FILE )
+            {
+                r = (float) get_Colour_r_0_1( (*colours)[i] );
+                g = (float) get_Colour_g_0_1( (*colours)[i] );
+                b = (float) get_Colour_b_0_1( (*colours)[i] );
+                a = (float) get_Colour_a_0_1( (*colours)[i] );
+            }
+
+            status = ascii_io_float( stream, &r );
+            if( status == OK )
+                status = ascii_io_float( stream, &g );
+            if( status == OK )
+                status = ascii_io_float( stream, &b );
+            if( status == OK )
+                status = ascii_io_float( stream, &a );
+
+            if( status == OK && stream->io_flag == READ_FILE )
+                (*colours)[i] = make_rgba_Colour_0_1( (Real) r, (Real) g,
+                                                      (Real) b, (Real) a );
+
+            if( status == OK )
+                status = ascii_io_newline( stream );
+        }
+    }
+
+    return( status );
+}
+
+static  Status  ascii_io_ints(
+    ascii_stream_struct  *stream,
+    int                  n,
+    int                  *ints[] )
+{
+    Status   status;
+    int      i;
+
+    status = OK;
+
+    if( stream->io_flag == READ_FILE && n > 0 )
+    {
+        ALLOC( *ints, n );
+    }
+
+    for_less( i, 0, n )
+    {
+        status = ascii_io_int( stream, &(*ints)[i] );
+
+        if( status == OK && (i == n - 1 || (i+1) % INTS_PER_LINE == 0) )
+            status = ascii_io_newline( stream );
+
+        if( status == ERROR )
+            break;
+    }
+
+    return( status );
+}
+
+/*--- as io_end_indices() in object_io.c */
+
+static  Status  ascii_io_end_indices(
+    ascii_stream_struct  *stream,
+    int                  n_items,
+    int                  *end_indices[],
+    int                  min_size )
+{
+    int      *sizes, item;
+    Status   status;
+
+    if( stream->io_flag == WRITE_FILE )
+    {
+        if( getenv( "NEW_OBJ_FORMAT" ) != NULL )
+        {
+            ALLOC( sizes, n_items );
+            sizes[0] = (*end_indices)[0];
+            for_less( item, 1, n_items )
+                sizes[item] = (*end_indices)[item] - (*end_indices)[item-1];
+
+            status = ascii_io_ints( stream, n_items, &sizes );
+
+            FREE( sizes );
+        }
+        else
+            status = ascii_io_ints( stream, n_items, end_indices );
+    }
+    else
+    {
+        status = ascii_io_ints( stream, n_items, end_indices );
+
+        if( status != OK )
+            return( status );
+
+        for_less( item, 1, n_items )
+        {
+            if( (*end_indices)[item] - (*end_indices)[item-1] < min_size )
+                break;
+        }
+
+        if( item < n_items )
+        {
+            for_less( item, 1, n_items )
+                (*end_indices)[item] += (*end_indices)[item-1];
+        }
+    }
+
+    return( status );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : io_ascii_lines
+@INPUT      : file
+              io_flag
+              lines
+@OUTPUT     : (lines)
+@RETURNS    : OK or ERROR
+@DESCRIPTION: The ascii format branch of io_lines(), using a large buffer.
+              On input, the file is left positioned just after the object.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Status  io_ascii_lines(
+    FILE                *file,
+    IO_types            io_flag,
+    lines_struct        *lines )
+{
+    Status               status, close_status;
+    ascii_stream_struct  stream;
+
+    status = OK;
+
+    if( io_flag == READ_FILE )
+    {
+        initialize_lines( lines, WHITE );
+        FREE( lines->colours );
+    }
+
+    if( io_flag == WRITE_FILE &&
+        (lines->n_points <= 0 || lines->n_items <= 0) )
+        return( status );
+
+    open_ascii_stream( &stream, file, io_flag );
+
+    status = ascii_io_object_type( &stream, 'L' );
+
+    if( status == OK )
+        status = ascii_io_float( &stream, &lines->line_thickness );
+
+    if( status == OK )
+        status = ascii_io_int( &stream, &lines->n_points );
+
+    if( status == OK )
+        status = ascii_io_newline( &stream );
+
+    if( status == OK )
+        status = ascii_io_points( &stream, lines->n_points, &lines->points );
+
+    if( status == OK )
+        status = ascii_io_newline( &stream );
+
+    if( status == OK )
+        status = ascii_io_int( &stream, &lines->n_items );
+
+    if( status == OK )
+        status = ascii_io_newline( &stream );
+
+    if( status == OK )
+    {
+        status = ascii_io_colours( &stream, &lines->colour_flag,
+                                   lines->n_items, lines->n_points,
+                                   &lines->colours );
+    }
+
+    if( status == OK )
+        status = ascii_io_newline( &stream );
+
+    if( status == OK )
+    {
+        status = ascii_io_end_indices( &stream, lines->n_items,
+                                       &lines->end_indices, 1 );
+    }
+
+    if( status == OK )
+        status = ascii_io_newline( &stream );
+
+    if( status == OK )
+    {
+        status = ascii_io_ints( &stream, NUMBER_INDICES(*lines),
+                                &lines->indices );
+    }
+
+    close_status = close_ascii_stream( &stream );
+
+    if( status == OK )
+        status = close_status;
+
+    return( status );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : io_ascii_polygons
+@INPUT      : file
+              io_flag
+              polygons
+@OUTPUT     : (polygons)
+@RETURNS    : OK or ERROR
+@DESCRIPTION: The ascii format branch of io_polygons(), using a large
+              buffer.  On input, the file is left positioned just after the
+              object.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Status  io_ascii_polygons(
+    FILE                *file,
+    IO_types            io_flag,
+    polygons_struct     *polygons )
+{
+    int                  n_items;
+    Status               status, close_status;
+    Surfprop             save_surfprop;
+    Point                centre;
+    BOOLEAN              compressed_format;
+    ascii_stream_struct  stream;
+
+    status = OK;
+
+    if( io_flag == READ_FILE )
+    {
+        initialize_polygons( polygons, WHITE, NULL );
+        FREE( polygons->colours );
+    }
+
+    if( io_flag == WRITE_FILE &&
+        (polygons->n_points <= 0 || polygons->n_items <= 0) )
+        return( status );
+
+    open_ascii_stream( &stream, file, io_flag );
+
+    status = ascii_io_object_type( &stream, 'P' );
+
+    if( status == OK )
+        status = ascii_io_surfprop( &stream, &polygons->surfprop );
+
+    compressed_format = FALSE;
+
+    if( status == OK )
+    {
+        if( io_flag == WRITE_FILE && get_use_compressed_polygons_flag() &&
+            is_this_tetrahedral_topology(polygons) )
+        {
+            n_items = -polygons->n_items;
+            status = ascii_io_int( &stream, &n_items );
+            compressed_format = TRUE;
+        }
+        else
+            status = ascii_io_int( &stream, &polygons->n_points );
+    }
+
+    if( status == OK )
+        status = ascii_io_newline( &stream );
+
+    if( io_flag == READ_FILE && polygons->n_points < 0 )
+    {
+        n_items = -polygons->n_points;
+        compressed_format = TRUE;
+        fill_Point( centre, 0.0, 0.0, 0.0 );
+        save_surfprop = polygons->surfprop;
+        create_tetrahedral_sphere( &centre, 1.0, 1.0, 1.0, n_items,
+                                   polygons );
+        polygons->surfprop = save_surfprop;
+        FREE( polygons->points );
+    }
+
+    if( status == OK )
+    {
+        status = ascii_io_points( &stream, polygons->n_points,
+                                  &polygons->points );
+    }
+
+    if( status == OK )
+        status = ascii_io_newline( &stream );
+
+    if( !compressed_format )
+    {
+        if( status == OK )
+        {
+            status = ascii_io_vectors( &stream, polygons->n_points,
+                                       &polygons->normals );
+        }
+
+        if( status == OK )
+            status = ascii_io_newline( &stream );
+
+        if( status == OK )
+            status = ascii_io_int( &stream, &polygons->n_items );
+
+        if( status == OK )
+            status = ascii_io_newline( &stream );
+    }
+
+    if( status == OK )
+    {
+        status = ascii_io_colours( &stream, &polygons->colour_flag,
+                                   polygons->n_items, polygons->n_points,
+                                   &polygons->colours );
+
+        if( status == OK )
+            status = ascii_io_newline( &stream );
+    }
+
+    if( !compressed_format )
+    {
+        if( status == OK )
+        {
+            status = ascii_io_end_indices( &stream, polygons->n_items,
+                                           &polygons->end_indices, 3 );
+        }
+
+        if( status == OK )
+            status = ascii_io_newline( &stream );
+
+        if( status == OK )
+        {
+            status = ascii_io_ints( &stream, NUMBER_INDICES(*polygons),
+                                    &polygons->indices );
+        }
+
+        if( status == OK )
+            status = ascii_io_newline( &stream );
+    }
+
+    close_status = close_ascii_stream( &stream );
+
+    if( status == OK )
+        status = close_status;
+
+    if( io_flag == READ_FILE && compressed_format )
+        compute_polygon_normals( polygons );
+
+    if( io_flag == READ_FILE )
+        polygons->line_thickness = 1.0f;
+
+    return( status );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : io_ascii_quadmesh
+@INPUT      : file
+              io_flag
+              quadmesh
+@OUTPUT     : (quadmesh)
+@RETURNS    : OK or ERROR
+@DESCRIPTION: The ascii format branch of io_quadmesh(), using a large
+              buffer.  On input, the file is left positioned just after the
+              object.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Status  io_ascii_quadmesh(
+    FILE                *file,
+    IO_types            io_flag,
+    quadmesh_struct     *quadmesh )
+{
+    Status               status, close_status;
+    ascii_stream_struct  stream;
+
+    status = OK;
+
+    if( io_flag == READ_FILE )
+    {
+        initialize_quadmesh( quadmesh, WHITE, NULL, 0, 0 );
+        FREE( quadmesh->colours );
+    }
+
+    if( io_flag == WRITE_FILE && (quadmesh->m <= 1 || quadmesh->n <= 1) )
+        return( status );
+
+    open_ascii_stream( &stream, file, io_flag );
+
+    status = ascii_io_object_type( &stream, 'Q' );
+
+    if( status == OK )
+        status = ascii_io_surfprop( &stream, &quadmesh->surfprop );
+
+    if( status == OK )
+        status = ascii_io_int( &stream, &quadmesh->m );
+
+    if( status == OK )
+        status = ascii_io_int( &stream, &quadmesh->n );
+
+    if( status == OK )
+        status = ascii_io_boolean( &stream, &quadmesh->m_closed );
+
+    if( status == OK )
+        status = ascii_io_boolean( &stream, &quadmesh->n_closed );
+
+    if( status == OK )
+        status = ascii_io_newline( &stream );
+
+    if( status == OK )
+        status = ascii_io_colours( &stream, &quadmesh->colour_flag,
+                                   (quadmesh->m-1) * (quadmesh->n-1),
+                                   quadmesh->m * quadmesh->n,
+                                   &quadmesh->colours );
+
+    if( status == OK )
+        status = ascii_io_newline( &stream );
+
+    if( status == OK )
+    {
+        status = ascii_io_points( &stream, quadmesh->m * quadmesh->n,
+                                  &quadmesh->points );
+    }
+
+    if( status == OK )
+        status = ascii_io_newline( &stream );
+
+    if( status == OK )
+    {
+        status = ascii_io_vectors( &stream, quadmesh->m * quadmesh->n,
+                                   &quadmesh->normals );
+    }
+
+    if( status == OK )
+        status = ascii_io_newline( &stream );
+
+    close_status = close_ascii_stream( &stream );
+
+    if( status == OK )
+        status = close_status;
+
+    return( status );
+}
@@ -0,0 +1,445 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "bicpl_internal.h"
+
+#if HAVE_SYS_MMAN_H && HAVE_MMAP
+#include  <sys/types.h>
+#include  <sys/stat.h>
+#include  <sys/mman.h>
+#define  USE_MMAP
+#endif
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_mapped_array
+@INPUT      : mapped
+              offset       - of the array in the mapping
+              n_bytes
+              alignment    - required by the array element type
+@OUTPUT     : in_mapping   - TRUE if the returned array is in the mapping
+@RETURNS    : pointer to the array
+@DESCRIPTION: Returns a pointer to an array stored in the mapped file, if it
+              is suitably aligned, or else a copy of it.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  *get_mapped_array(
+    mapped_polygons_struct  *mapped,
+    size_t                  offset,
+    size_t                  n_bytes,
+    size_t                  alignment,
+    BOOLEAN                 *in_mapping )
+{
+    unsigned char  *ptr, *copy;
+
+    ptr = (unsigned char *) mapped->mapping + offset;
+
+    if( n_bytes == 0 )
+    {
+        *in_mapping = FALSE;
+        return( NULL );
+    }
+
+    if( (size_t) ptr % alignment == 0 )
+    {
+        *in_mapping = TRUE;
+        return( (void *) ptr );
+    }
+
+    ALLOC( copy, n_bytes );
+    (void) memcpy( copy, ptr, n_bytes );
+    *in_mapping = FALSE;
+
+    return( (void *) copy );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : read_int_at
+@INPUT      : mapped
+              offset
+@OUTPUT     :
+@RETURNS    : the int at the offset in the mapping
+@DESCRIPTION: Reads an int in the native byte order, whatever its alignment.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  int  read_int_at(
+    mapped_polygons_struct  *mapped,
+    size_t                  offset )
+{
+    int   value;
+
+    (void) memcpy( &value, (unsigned char *) mapped->mapping + offset,
+                   sizeof(value) );
+
+    return( value );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : map_binary_polygons
+@INPUT      : mapped       - with the mapping set
+@OUTPUT     : mapped
+@RETURNS    : TRUE if the mapping holds a binary polygons object
+@DESCRIPTION: Sets up the polygons of mapped from the first object in the
+              mapped file, if it is a binary polygons object with the sizes
+              of its arrays consistent with the size of the file.  Otherwise
+              returns FALSE, with nothing allocated, so the file can be read
+              by io_polygons() instead.
+@METHOD     : The layout is that written by io_polygons(), in the native
+              byte order.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  BOOLEAN  map_binary_polygons(
+    mapped_polygons_struct  *mapped )
+{
+    int              i, n_colours, n_points, n_items, item;
+    int              *end_indices;
+    size_t           n_indices, offset, size, points_offset, normals_offset;
+    size_t           colours_offset, end_indices_offset, indices_offset;
+    unsigned char    *bytes, *comps;
+    Colour_flags     colour_flag;
+    polygons_struct  *polygons;
+
+    bytes = (unsigned char *) mapped->mapping;
+    size = mapped->mapping_size;
+    polygons = &mapped->polygons;
+
+    /*--- skip white space, as input_nonwhite_character() does */
+
+    offset = 0;
+    while( offset < size && (bytes[offset] == ' ' || bytes[offset] == '\t' ||
+                             bytes[offset] == '\n' || bytes[offset] == '\r') )
+        ++offset;
+
+    if( offset >= size || bytes[offset] != 'p' )
+        return( FALSE );
+    ++offset;
+
+    if( size - offset < sizeof(Surfprop) + sizeof(int) )
+        return( FALSE );
+
+    (void) memcpy( &polygons->surfprop, bytes + offset, sizeof(Surfprop) );
+    offset += sizeof(Surfprop);
+
+    /*--- a negative number of points is the compressed format */
+
+    n_points = read_int_at( mapped, offset );
+    offset += sizeof(int);
+
+    if( n_points <= 0 ||
+        (size - offset) / (2 * sizeof(Point)) < (size_t) n_points )
+        return( FALSE );
+
+    points_offset = offset;
+    offset += (size_t) n_points * sizeof(Point);
+    normals_offset = offset;
+    offset += (size_t) n_points * sizeof(Vector);
+
+    if( size - offset < 2 * sizeof(int) )
+        return( FALSE );
+
+    n_items = read_int_at( mapped, offset );
+    offset += sizeof(int);
+    colour_flag = (Colour_flags) read_int_at( mapped, offset );
+    offset += sizeof(int);
+
+    if( n_items <= 0 )
+        return( FALSE );
+
+    switch( colour_flag )
+    {
+    case ONE_COLOUR:          n_colours = 1;          break;
+    case PER_ITEM_COLOURS:    n_colours = n_items;    break;
+    case PER_VERTEX_COLOURS:  n_colours = n_points;   break;
+    default:                  return( FALSE );
+    }
+
+    colours_offset = offset;
+
+    if( (size - offset) / 4 < (size_t) n_colours )
+        return( FALSE );
+    offset += 4 * (size_t) n_colours;
+
+    end_indices_offset = offset;
+
+    if( (size - offset) / sizeof(int) < (size_t) n_items )
+        return( FALSE );
+    offset += (size_t) n_items * sizeof(int);
+
+    /*--- the end indices may be stored as polygon sizes, which are
+          recognized as in io_end_indices() */
+
+    for_less( item, 1, n_items )
+    {
+        if( read_int_at( mapped, end_indices_offset +
+                                 (size_t) item * sizeof(int) ) -
+            read_int_at( mapped, end_indices_offset +
+                                 (size_t) (item-1) * sizeof(int) ) < 3 )
+            break;
+    }
+
+    if( item < n_items )
+    {
+        n_indices = 0;
+        for_less( item, 0, n_items )
+        {
+            i = read_int_at( mapped, end_indices_offset +
+                                     (size_t) item * sizeof(int) );
+            if( i < 0 )
+                return( FALSE );
+            n_indices += (size_t) i;
+        }
+    }
+    else
+    {
+        i = read_int_at( mapped, end_indices_offset +
+                                 (size_t) (n_items-1) * sizeof(int) );
+        if( i < 0 || read_int_at( mapped, end_indices_offset ) < 0 )
+            return( FALSE );
+        n_indices = (size_t) i;
+    }
+
+    if( (size - offset) / sizeof(int) < n_indices )
+        return( FALSE );
+    indices_offset = offset;
+
+    /*--- the object is consistent, so set up the polygons */
+
+    if( Surfprop_t(polygons->surfprop) == 0.0f )
+        Surfprop_t(polygons->surfprop) = 1.0f;
+
+    polygons->colour_flag = colour_flag;
+    ALLOC( polygons->colours, n_colours );
+    for_less( i, 0, n_colours )
+    {
+        comps = bytes + colours_offset + 4 * (size_t) i;
+        polygons->colours[i] = make_rgba_Colour( (int) comps[3],
+                                                 (int) comps[2],
+                                                 (int) comps[1],
+                                                 (int) comps[0] );
+    }
+
+    polygons->line_thickness = 1.0f;
+    polygons->n_points = n_points;
+    polygons->n_items = n_items;
+    polygons->visibilities = (Smallest_int *) 0;
+    polygons->neighbours = (int *) 0;
+    polygons->bintree = (bintree_struct_ptr) NULL;
+    polygons->topology = NULL;
+
+    polygons->points = (Point *) get_mapped_array( mapped, points_offset,
+                                 (size_t) n_points * sizeof(Point),
+                                 sizeof(Point_coord_type),
+                                 &mapped->points_in_mapping );
+    polygons->normals = (Vector *) get_mapped_array( mapped, normals_offset,
+                                 (size_t) n_points * sizeof(Vector),
+                                 sizeof(Point_coord_type),
+                                 &mapped->normals_in_mapping );
+    polygons->end_indices = (int *) get_mapped_array( mapped,
+                                 end_indices_offset,
+                                 (size_t) n_items * sizeof(int), sizeof(int),
+                                 &mapped->end_indices_in_mapping );
+    polygons->indices = (int *) get_mapped_array( mapped, indices_offset,
+                                 n_indices * sizeof(int), sizeof(int),
+                                 &mapped->indices_in_mapping );
+
+    /*--- the mapping is private, so this does not change the file */
+
+    end_indices = polygons->end_indices;
+    for_less( item, 1, n_items )
+    {
+        if( end_indices[item] - end_indices[item-1] < 3 )
+            break;
+    }
+
+    if( item < n_items )
+    {
+        for_less( item, 1, n_items )
+            end_indices[item] += end_indices[item-1];
+    }
+
+    return( TRUE );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : input_mapped_polygons
+@INPUT      : filename
+@OUTPUT     : mapped
+@RETURNS    : OK or ERROR
+@DESCRIPTION: Reads the polygons which are the first object in a file.  For
+              binary files in the native byte order, the file is memory
+              mapped, and the points, normals, end indices and indices are
+              used where they lie in the mapping, without reading or copying
+              them, if their alignment permits.  Other files are read with
+              io_polygons().  The polygons are in mapped->polygons, and may
+              be modified, as the mapping is private, but the arrays must
+              not be reallocated, nor the polygons passed to
+              delete_polygons().  Call
+              delete_mapped_polygons() when done.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Status  input_mapped_polygons(
+    STRING                  filename,
+    mapped_polygons_struct  *mapped )
+{
+    Status         status;
+    FILE           *file;
+    Object_types   type;
+    File_formats   format;
+    BOOLEAN        eof;
+#ifdef  USE_MMAP
+    struct  stat   file_stat;
+    void           *mapping;
+#endif
+
+    mapped->mapping = NULL;
+    mapped->mapping_size = 0;
+    mapped->points_in_mapping = FALSE;
+    mapped->normals_in_mapping = FALSE;
+    mapped->end_indices_in_mapping = FALSE;
+    mapped->indices_in_mapping = FALSE;
+
+    status = open_file_with_default_suffix( filename, "obj", READ_FILE,
+                                            BINARY_FORMAT, &file );
+
+    if( status != OK )
+        return( status );
+
+#ifdef  USE_MMAP
+    if( fstat( fileno( file ), &file_stat ) == 0 && file_stat.st_size > 0 &&
+        (off_t) (size_t) file_stat.st_size == file_stat.st_size )
+    {
+        mapping = mmap( NULL, (size_t) file_stat.st_size,
+                        PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                        fileno( file ), 0 );
+
+        if( mapping != MAP_FAILED )
+        {
+            mapped->mapping = mapping;
+            mapped->mapping_size = (size_t) file_stat.st_size;
+
+            if( map_binary_polygons( mapped ) )
+                return( close_file( file ) );
+
+            (void) munmap( mapped->mapping, mapped->mapping_size );
+            mapped->mapping = NULL;
+            mapped->mapping_size = 0;
+        }
+    }
+#endif
+
+    /*--- fall back to reading the file */
+
+    status = input_object_type( file, &type, &format, &eof );
+
+    if( status == OK && (eof || type != POLYGONS) )
+    {
+        print_error( "input_mapped_polygons: %s does not start with polygons.\n",
+                     filename );
+        status = ERROR;
+    }
+
+    if( status == OK )
+        status = io_polygons( file, READ_FILE, format, &mapped->polygons );
+
+    (void) close_file( file );
+
+    return( status );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : delete_mapped_polygons
+@INPUT      : mapped
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Deletes polygons read by input_mapped_polygons(), unmapping
+              the file.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  delete_mapped_polygons(
+    mapped_polygons_struct  *mapped )
+{
+    polygons_struct  *polygons;
+
+    polygons = &mapped->polygons;
+
+    /*--- as delete_polygons(), but leaving the arrays in the mapping */
+
+    free_colours( polygons->colour_flag, polygons->colours, polygons->n_points,
+                  polygons->n_items );
+
+    if( !mapped->points_in_mapping && polygons->points != NULL )
+        FREE( polygons->points );
+
+    if( !mapped->normals_in_mapping && polygons->normals != NULL )
+        FREE( polygons->normals );
+
+    if( !mapped->end_indices_in_mapping && polygons->end_indices != NULL )
+        FREE( polygons->end_indices );
+
+    if( !mapped->indices_in_mapping && polygons->indices != NULL )
+        FREE( polygons->indices );
+
+    if( polygons->visibilities != (Smallest_int *) 0 )
+        FREE( polygons->visibilities );
+
+    free_polygon_neighbours( polygons );
+
+    delete_bintree_if_any( &polygons->bintree );
+
+    polygons->points = NULL;
+    polygons->normals = NULL;
+    polygons->end_indices = NULL;
+    polygons->indices = NULL;
+    polygons->visibilities = (Smallest_int *) 0;
+
+    mapped->points_in_mapping = FALSE;
+    mapped->normals_in_mapping = FALSE;
+    mapped->end_indices_in_mapping = FALSE;
+    mapped->indices_in_mapping = FALSE;
+
+#ifdef  USE_MMAP
+    if( mapped->mapping != NULL )
+        (void) munmap( mapped->mapping, mapped->mapping_size );
+#endif
+
+    mapped->mapping = NULL;
+    mapped->mapping_size = 0;
+}
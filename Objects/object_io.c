@@ -213,6 +213,9 @@ BICAPI  Status  io_lines(
 {
     Status   status;
 
+    if( format == ASCII_FORMAT && can_use_fast_ascii_io( file, io_flag ) )
+        return( io_ascii_lines( file, io_flag, lines ) );
+
     status = OK;
 
     if( io_flag == READ_FILE )
@@ -512,6 +515,9 @@ BICAPI  Status  io_polygons(
     Point    centre;
     BOOLEAN  compressed_format;
 
+    if( format == ASCII_FORMAT && can_use_fast_ascii_io( file, io_flag ) )
+        return( io_ascii_polygons( file, io_flag, polygons ) );
+
     status = OK;
 
     if( io_flag == READ_FILE )
@@ -657,6 +663,9 @@ BICAPI  Status  io_quadmesh(
 {
     Status   status;
 
+    if( format == ASCII_FORMAT && can_use_fast_ascii_io( file, io_flag ) )
+        return( io_ascii_quadmesh( file, io_flag, quadmesh ) );
+
     status = OK;
 
     if( io_flag == READ_FILE )
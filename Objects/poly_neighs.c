@@ -55,12 +55,11 @@ BICAPI  void  delete_polygon_point_neighbours(
     Smallest_int     interior_flags[],
     int              *point_polygons[] )
 {
-    int   i;
-
     FREE( n_point_neighbours );
 
-    for_less( i, 0, polygons->n_points )
-        FREE( point_neighbours[i] );
+    /*--- the neighbours of all points are in one array */
+
+    FREE( point_neighbours[0] );
     FREE( point_neighbours );
 
     if( interior_flags != NULL )
@@ -73,12 +72,17 @@ BICAPI  void  delete_polygon_point_neighbours(
     }
 }
 
+/*--- adds the points in indices, a fan of the polygon around the point,
+      to the ordered neighbours of the point, where a neighbour beyond
+      which the fan is not closed is marked by adding n_nodes to it */
+
 static  void  insert_neighbours(
     int    n_to_add,
     int    indices[],
     int    n_nodes,
     int    *n_neighbours,
-    int    *neighbours[] )
+    int    *neighbours[],
+    int    *n_neighbours_alloced )
 {
     int       p1, p2, first_index, start, i, n_to_insert, n_to_do, last_index;
     BOOLEAN   wrapped;
@@ -146,143 +150,214 @@ static  void  insert_neighbours(
         }
     }
 
-    SET_ARRAY_SIZE( *neighbours, *n_neighbours, n_to_add, SMALL_CHUNK_SIZE);
+    if( n_to_add > *n_neighbours_alloced )
+    {
+        SET_ARRAY_SIZE( *neighbours, *n_neighbours_alloced, n_to_add,
+                        SMALL_CHUNK_SIZE );
+        *n_neighbours_alloced = n_to_add;
+    }
 
     *n_neighbours = n_to_add;
     for_less( i, 0, n_to_add )
         (*neighbours)[i] = indices[i];
 }
 
-BICAPI   void   create_polygon_point_neighbours(
-    polygons_struct  *polygons,
-    BOOLEAN          across_polygons_flag,
-    int              *n_point_neighbours_ptr[],
-    int              **point_neighbours_ptr[],
-    Smallest_int     *interior_flags_ptr[],
-    int              **point_polygons_ptr[] )
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : create_polygon_point_neighbour_graph
+@INPUT      : polygons
+              across_polygons_flag  - if TRUE, all points of the polygons
+                                      around a point are its neighbours,
+                                      rather than only those on its edges
+              point_polygons_flag   - if TRUE, also finds the polygon on
+                                      each edge
+@OUTPUT     : graph
+@RETURNS    : 
+@DESCRIPTION: Finds the neighbours of each point of the polygons, in order
+              around the point, storing them in compressed sparse row form:
+              the neighbours of point p are graph->neighbours[
+              graph->offsets[p]] to graph->neighbours[graph->offsets[p+1]-1].
+              graph->interior_flags[p] is TRUE if the polygons around p form
+              a closed fan.  If requested, graph->point_polygons holds, at
+              the same positions as the neighbours, the polygon with the
+              edge from the point to the neighbour.  The order is the same
+              as that of create_polygon_point_neighbours().
+@METHOD     : The polygon corners at each point are gathered in a first
+              pass, so that each point's neighbours are then ordered in a
+              small reused buffer and appended to one array, instead of
+              growing an array per point.
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  void  create_polygon_point_neighbour_graph(
+    polygons_struct          *polygons,
+    BOOLEAN                  across_polygons_flag,
+    BOOLEAN                  point_polygons_flag,
+    point_neighbours_struct  *graph )
 {
-    int                 edge, i0, i1, size, poly, total_neighbours, p0, p1;
-    int                 points_to_add_alloced;
-    int                 n_points, n;
-    int                 *n_point_neighbours, **point_neighbours;
-    int                 **point_polygons, point, index0, index1;
-    int                 i, v, indices[MAX_POINTS_PER_POLYGON], ii;
-    int                 n_to_add, *points_to_add;
-    progress_struct     progress;
+    int              n_points, point, poly, size, v, i0, i1, ii, c;
+    int              edge, index0, index1, start, n_corners;
+    int              *corner_offsets, *corner_polys, *corner_vertices;
+    int              *offsets, *neighbours, *point_polygons;
+    int              max_neighbours, n_total, n_to_add, n_added;
+    int              *points_to_add, points_to_add_alloced;
+    int              *ring, n_ring, n_ring_alloced;
+    Smallest_int     *interior_flags;
+    progress_struct  progress;
 
-    if( across_polygons_flag && point_polygons_ptr != NULL )
+    n_points = polygons->n_points;
+
+    /*--- first pass: the polygon corners at each point */
+
+    ALLOC( corner_offsets, n_points + 1 );
+    for_inclusive( point, 0, n_points )
+        corner_offsets[point] = 0;
+
+    max_neighbours = 0;
+    n_corners = 0;
+
+    for_less( poly, 0, polygons->n_items )
     {
-        print_error(
-                "create_polygon_point_neighbours: conflicting argument.\n" );
-        return;
-    }
+        size = GET_OBJECT_SIZE( *polygons, poly );
+        for_less( v, 0, size )
+        {
+            point = polygons->indices[POINT_INDEX(polygons->end_indices,
+                                                  poly,v)];
+            ++corner_offsets[point+1];
+        }
 
-    points_to_add_alloced = 0;
-    points_to_add = NULL;
+        n_corners += size;
 
-    n_points = polygons->n_points;
+        if( across_polygons_flag )
+            max_neighbours += size * (size - 1);
+        else
+            max_neighbours += size * MIN( 2, size - 1 );
+    }
 
-    ALLOC( n_point_neighbours, n_points );
     for_less( point, 0, n_points )
-        n_point_neighbours[point] = 0;
-
-    ALLOC( point_neighbours, n_points );
+        corner_offsets[point+1] += corner_offsets[point];
 
-    initialize_progress_report( &progress, FALSE, polygons->n_items,
-                                "Neighbour-finding" );
+    ALLOC( corner_polys, MAX( 1, n_corners ) );
+    ALLOC( corner_vertices, MAX( 1, n_corners ) );
 
     for_less( poly, 0, polygons->n_items )
     {
-
         size = GET_OBJECT_SIZE( *polygons, poly );
         for_less( v, 0, size )
         {
-            indices[v] = polygons->indices[
-                                    POINT_INDEX(polygons->end_indices,poly,v)];
+            point = polygons->indices[POINT_INDEX(polygons->end_indices,
+                                                  poly,v)];
+            corner_polys[corner_offsets[point]] = poly;
+            corner_vertices[corner_offsets[point]] = v;
+            ++corner_offsets[point];
         }
+    }
+
+    for_down( point, n_points, 1 )
+        corner_offsets[point] = corner_offsets[point-1];
+    corner_offsets[0] = 0;
+
+    /*--- second pass: order the neighbours of each point, in the order
+          in which the polygons are given */
+
+    ALLOC( offsets, n_points + 1 );
+    ALLOC( neighbours, MAX( 1, max_neighbours ) );
+    ALLOC( interior_flags, MAX( 1, n_points ) );
 
-        for_less( i0, 0, size )
+    points_to_add_alloced = 0;
+    points_to_add = NULL;
+    n_ring_alloced = 0;
+    ring = NULL;
+    n_total = 0;
+
+    initialize_progress_report( &progress, FALSE, n_points,
+                                "Neighbour-finding" );
+
+    for_less( point, 0, n_points )
+    {
+        n_ring = 0;
+
+        for_less( c, corner_offsets[point], corner_offsets[point+1] )
         {
-            p0 = indices[i0];
+            poly = corner_polys[c];
+            i0 = corner_vertices[c];
+            size = GET_OBJECT_SIZE( *polygons, poly );
+            start = START_INDEX( polygons->end_indices, poly );
 
-            if( size + n_point_neighbours[p0] > points_to_add_alloced )
+            if( size + n_ring > points_to_add_alloced )
             {
                 SET_ARRAY_SIZE( points_to_add, points_to_add_alloced,
-                                size + n_point_neighbours[p0],
-                                DEFAULT_CHUNK_SIZE);
-                points_to_add_alloced = size + n_point_neighbours[p0];
+                                size + n_ring, DEFAULT_CHUNK_SIZE );
+                points_to_add_alloced = size + n_ring;
             }
 
             n_to_add = 0;
             for_less( ii, 0, size-1 )
             {
-                i1 = (i0 + 1 + ii) % size;
                 if( !across_polygons_flag && ii != 0 && ii != size-2 )
                     continue;
 
-                p1 = indices[i1];
-                points_to_add[n_to_add] = p1;
+                i1 = (i0 + 1 + ii) % size;
+                points_to_add[n_to_add] = polygons->indices[start + i1];
                 ++n_to_add;
             }
 
             insert_neighbours( n_to_add, points_to_add, n_points,
-                               &n_point_neighbours[p0], &point_neighbours[p0] );
+                               &n_ring, &ring, &n_ring_alloced );
         }
 
-        update_progress_report( &progress, poly+1 );
+        offsets[point] = n_total;
+
+        if( n_ring > 0 )
+            interior_flags[point] = (Smallest_int) (ring[n_ring-1] < n_points);
+        else
+            interior_flags[point] = (Smallest_int) FALSE;
+
+        for_less( n_added, 0, n_ring )
+        {
+            if( ring[n_added] >= n_points )
+                neighbours[n_total] = ring[n_added] - n_points;
+            else
+                neighbours[n_total] = ring[n_added];
+            ++n_total;
+        }
+
+        update_progress_report( &progress, point+1 );
     }
 
+    offsets[n_points] = n_total;
+
     terminate_progress_report( &progress );
 
     if( points_to_add_alloced > 0 )
         FREE( points_to_add );
+    if( n_ring_alloced > 0 )
+        FREE( ring );
 
-    total_neighbours = 0;
-    for_less( i, 0, n_points )
-    {
-        REALLOC( point_neighbours[i], n_point_neighbours[i] );
-        total_neighbours += n_point_neighbours[i];
-    }
+    FREE( corner_polys );
+    FREE( corner_vertices );
+    FREE( corner_offsets );
 
-    if( interior_flags_ptr != NULL )
-    {
-        ALLOC( *interior_flags_ptr, n_points );
-        for_less( point, 0, n_points )
-        {
-            (*interior_flags_ptr)[point] = (Smallest_int)
-              (point_neighbours[point][n_point_neighbours[point]-1] < n_points);
-        }
-    }
-
-    for_less( point, 0, n_points )
-    {
-        for_less( n, 0, n_point_neighbours[point] )
-        {
-            if( point_neighbours[point][n] >= n_points )
-                point_neighbours[point][n] -= n_points;
-        }
-    }
+    if( n_total > 0 && n_total < max_neighbours )
+        REALLOC( neighbours, n_total );
 
-    *n_point_neighbours_ptr = n_point_neighbours;   
-    *point_neighbours_ptr = point_neighbours;   
+    graph->n_points = n_points;
+    graph->offsets = offsets;
+    graph->neighbours = neighbours;
+    graph->interior_flags = interior_flags;
+    graph->point_polygons = NULL;
 
-    if( point_polygons_ptr == NULL )
+    if( !point_polygons_flag )
         return;
 
-    ALLOC( point_polygons, n_points );
-    ALLOC( point_polygons[0], total_neighbours );
+    /*--- the polygon with the edge from each point to each neighbour */
 
-    for_less( point, 0, total_neighbours )
-        point_polygons[0][point] = -1;
+    ALLOC( point_polygons, MAX( 1, n_total ) );
 
-    for_less( point, 1, n_points )
-    {
-        point_polygons[point] = &point_polygons[point-1]
-                                               [n_point_neighbours[point-1]];
-    }
-
-    initialize_progress_report( &progress, FALSE, polygons->n_items,
-                                "Neighbour-finding step 2" );
+    for_less( index0, 0, n_total )
+        point_polygons[index0] = -1;
 
     for_less( poly, 0, polygons->n_items )
     {
@@ -295,30 +370,168 @@ BICAPI   void   create_polygon_point_neighbours(
             i1 = polygons->indices[
                   POINT_INDEX(polygons->end_indices,poly,(edge+1)%size)];
 
-            for_less( index0, 0, n_point_neighbours[i0] )
+            for_less( index0, offsets[i0], offsets[i0+1] )
             {
-                if( point_neighbours[i0][index0] == i1 )
+                if( neighbours[index0] == i1 )
                     break;
             }
 
-            for_less( index1, 0, n_point_neighbours[i1] )
+            for_less( index1, offsets[i1], offsets[i1+1] )
             {
-                if( point_neighbours[i1][index1] == i0 )
+                if( neighbours[index1] == i0 )
                     break;
             }
 
-            if( point_polygons[i0][index0] < 0 )
-                point_polygons[i0][index0] = poly;
+            if( point_polygons[index0] < 0 )
+                point_polygons[index0] = poly;
             else
-                point_polygons[i1][index1] = poly;
+                point_polygons[index1] = poly;
         }
+    }
+
+    graph->point_polygons = point_polygons;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : delete_polygon_point_neighbour_graph
+@INPUT      : graph
+@OUTPUT     : 
+@RETURNS    : 
+@DESCRIPTION: Deletes the point neighbours created by
+              create_polygon_point_neighbour_graph().
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  void  delete_polygon_point_neighbour_graph(
+    point_neighbours_struct  *graph )
+{
+    FREE( graph->offsets );
+    FREE( graph->neighbours );
+    FREE( graph->interior_flags );
 
-        update_progress_report( &progress, poly+1 );
+    if( graph->point_polygons != NULL )
+        FREE( graph->point_polygons );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_point_neighbour_graph_arrays
+@INPUT      : graph
+@OUTPUT     : n_point_neighbours
+              point_neighbours
+              point_polygons      - may be NULL
+@RETURNS    : 
+@DESCRIPTION: Returns the number of neighbours and a pointer to the
+              neighbours of each point of the graph, for the many functions
+              taking the neighbours in this form.  The pointers are into
+              the graph, so only the two arrays themselves, and point
+              polygons if requested, need be freed, with FREE().
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI  void  get_point_neighbour_graph_arrays(
+    point_neighbours_struct  *graph,
+    int                      *n_point_neighbours[],
+    int                      **point_neighbours[],
+    int                      **point_polygons[] )
+{
+    int   point;
+
+    ALLOC( *n_point_neighbours, MAX( 1, graph->n_points ) );
+    ALLOC( *point_neighbours, MAX( 1, graph->n_points ) );
+
+    for_less( point, 0, graph->n_points )
+    {
+        (*n_point_neighbours)[point] = graph->offsets[point+1] -
+                                       graph->offsets[point];
+        (*point_neighbours)[point] = &graph->neighbours[graph->offsets[point]];
     }
 
-    terminate_progress_report( &progress );
+    if( point_polygons == NULL )
+        return;
+
+    if( graph->point_polygons == NULL )
+    {
+        *point_polygons = NULL;
+        return;
+    }
+
+    ALLOC( *point_polygons, MAX( 1, graph->n_points ) );
+
+    for_less( point, 0, graph->n_points )
+    {
+        (*point_polygons)[point] =
+                         &graph->point_polygons[graph->offsets[point]];
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : create_polygon_point_neighbours
+@INPUT      : polygons
+              across_polygons_flag
+@OUTPUT     : n_point_neighbours_ptr
+              point_neighbours_ptr
+              interior_flags_ptr    - may be NULL
+              point_polygons_ptr    - may be NULL
+@RETURNS    : 
+@DESCRIPTION: Finds the neighbours of each point of the polygons, in order
+              around the point, as arrays of neighbours per point, which are
+              deleted with delete_polygon_point_neighbours().
+@METHOD     : Built with create_polygon_point_neighbour_graph(), the arrays
+              of the points pointing into its single neighbours array.
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    :         1993    David MacDonald
+@MODIFIED   : Oct. 2026
+---------------------------------------------------------------------------- */
+
+BICAPI   void   create_polygon_point_neighbours(
+    polygons_struct  *polygons,
+    BOOLEAN          across_polygons_flag,
+    int              *n_point_neighbours_ptr[],
+    int              **point_neighbours_ptr[],
+    Smallest_int     *interior_flags_ptr[],
+    int              **point_polygons_ptr[] )
+{
+    point_neighbours_struct  graph;
+
+    if( across_polygons_flag && point_polygons_ptr != NULL )
+    {
+        print_error(
+                "create_polygon_point_neighbours: conflicting argument.\n" );
+        return;
+    }
+
+    create_polygon_point_neighbour_graph( polygons, across_polygons_flag,
+                                          point_polygons_ptr != NULL, &graph );
+
+    /*--- the arrays take over the memory of the graph, the neighbours of
+          point 0 being the start of the neighbours array */
+
+    get_point_neighbour_graph_arrays( &graph, n_point_neighbours_ptr,
+                                      point_neighbours_ptr,
+                                      point_polygons_ptr );
+
+    if( polygons->n_points == 0 )
+    {
+        (*point_neighbours_ptr)[0] = graph.neighbours;
+        if( point_polygons_ptr != NULL )
+            (*point_polygons_ptr)[0] = graph.point_polygons;
+    }
+
+    if( interior_flags_ptr != NULL )
+        *interior_flags_ptr = graph.interior_flags;
+    else
+        FREE( graph.interior_flags );
 
-    *point_polygons_ptr = point_polygons;   
+    FREE( graph.offsets );
 }
 
 /* ----------------------------- MNI Header -----------------------------------
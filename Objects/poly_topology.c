@@ -0,0 +1,426 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#include "bicpl_internal.h"
+
+/*--- the points are matched in blocks of this size, each block being one
+      parallel job */
+
+#define  TOPOLOGY_BLOCK_SIZE   4096
+
+typedef  struct
+{
+    polygons_struct          *polygons;
+    polygon_topology_struct  *topology;
+} topology_job_struct;
+
+/*--- the point at the end of half-edge h */
+
+static  int  get_half_edge_end(
+    polygons_struct          *polygons,
+    polygon_topology_struct  *topology,
+    int                      h )
+{
+    int   poly;
+
+    poly = topology->polys[h];
+
+    if( h + 1 < polygons->end_indices[poly] )
+        return( polygons->indices[h+1] );
+    else
+        return( polygons->indices[START_INDEX(polygons->end_indices,poly)] );
+}
+
+/*--- the half-edge ending at the start of half-edge h */
+
+static  int  get_previous_half_edge(
+    polygons_struct          *polygons,
+    polygon_topology_struct  *topology,
+    int                      h )
+{
+    int   poly, start;
+
+    poly = topology->polys[h];
+    start = START_INDEX( polygons->end_indices, poly );
+
+    if( h > start )
+        return( h - 1 );
+    else
+        return( polygons->end_indices[poly] - 1 );
+}
+
+/*--- finds the opposite of each half-edge starting at the points of a block,
+      looking first for a half-edge running the other way, then for one
+      running the same way in an inconsistently oriented polygon */
+
+static  void  match_half_edges_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    topology_job_struct      *job;
+    polygons_struct          *polygons;
+    polygon_topology_struct  *topology;
+    int                      point, end_point, c, c2, h, h2, p2;
+
+    job = (topology_job_struct *) data;
+    polygons = job->polygons;
+    topology = job->topology;
+
+    end_point = MIN( topology->n_points, (block+1) * TOPOLOGY_BLOCK_SIZE );
+
+    for_less( point, block * TOPOLOGY_BLOCK_SIZE, end_point )
+    {
+        for_less( c, topology->offsets[point], topology->offsets[point+1] )
+        {
+            h = topology->corners[c];
+            p2 = get_half_edge_end( polygons, topology, h );
+            topology->opposite[h] = -1;
+
+            for_less( c2, topology->offsets[p2], topology->offsets[p2+1] )
+            {
+                h2 = topology->corners[c2];
+                if( get_half_edge_end( polygons, topology, h2 ) == point )
+                {
+                    topology->opposite[h] = h2;
+                    break;
+                }
+            }
+
+            if( topology->opposite[h] >= 0 )
+                continue;
+
+            for_less( c2, topology->offsets[point], topology->offsets[point+1] )
+            {
+                h2 = topology->corners[c2];
+                if( h2 != h &&
+                    get_half_edge_end( polygons, topology, h2 ) == p2 )
+                {
+                    topology->opposite[h] = h2;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/*--- flags the points of a block lying on a boundary edge, once all
+      opposites are known */
+
+static  void  flag_boundary_points_block(
+    void   *data,
+    int    block,
+    int    thread )
+{
+    topology_job_struct      *job;
+    polygons_struct          *polygons;
+    polygon_topology_struct  *topology;
+    int                      point, end_point, c, h;
+    BOOLEAN                  boundary;
+
+    job = (topology_job_struct *) data;
+    polygons = job->polygons;
+    topology = job->topology;
+
+    end_point = MIN( topology->n_points, (block+1) * TOPOLOGY_BLOCK_SIZE );
+
+    for_less( point, block * TOPOLOGY_BLOCK_SIZE, end_point )
+    {
+        boundary = FALSE;
+
+        for_less( c, topology->offsets[point], topology->offsets[point+1] )
+        {
+            h = topology->corners[c];
+            if( topology->opposite[h] < 0 ||
+                topology->opposite[get_previous_half_edge(polygons,topology,h)]
+                                                                        < 0 )
+            {
+                boundary = TRUE;
+                break;
+            }
+        }
+
+        topology->boundary_flags[point] = (Smallest_int) boundary;
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : create_polygons_topology
+@INPUT      : polygons
+              n_threads   - number of threads, or <= 0 for the default
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Creates the half-edge index of the polygons, replacing any
+              already cached in polygons->topology.  The half-edges starting
+              at each point are gathered in one pass, then the opposite
+              half-edges and the boundary points are found in parallel,
+              each point only looking at the half-edges of its neighbours.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  create_polygons_topology(
+    polygons_struct   *polygons,
+    int               n_threads )
+{
+    polygon_topology_struct  *topology;
+    topology_job_struct      job;
+    int                      poly, h, point, n_indices, n_blocks;
+    int                      *fill;
+
+    delete_polygons_topology( polygons );
+
+    n_indices = NUMBER_INDICES( *polygons );
+
+    ALLOC( topology, 1 );
+    topology->n_points = polygons->n_points;
+    topology->n_indices = n_indices;
+
+    ALLOC( topology->polys, MAX( 1, n_indices ) );
+    ALLOC( topology->opposite, MAX( 1, n_indices ) );
+    ALLOC( topology->corners, MAX( 1, n_indices ) );
+    ALLOC( topology->offsets, polygons->n_points + 1 );
+    ALLOC( topology->boundary_flags, MAX( 1, polygons->n_points ) );
+
+    for_less( point, 0, polygons->n_points + 1 )
+        topology->offsets[point] = 0;
+
+    for_less( poly, 0, polygons->n_items )
+    {
+        for_less( h, START_INDEX(polygons->end_indices,poly),
+                     polygons->end_indices[poly] )
+        {
+            topology->polys[h] = poly;
+            ++topology->offsets[polygons->indices[h]+1];
+        }
+    }
+
+    for_less( point, 0, polygons->n_points )
+        topology->offsets[point+1] += topology->offsets[point];
+
+    ALLOC( fill, MAX( 1, polygons->n_points ) );
+    for_less( point, 0, polygons->n_points )
+        fill[point] = topology->offsets[point];
+
+    for_less( h, 0, n_indices )
+    {
+        point = polygons->indices[h];
+        topology->corners[fill[point]] = h;
+        ++fill[point];
+    }
+
+    FREE( fill );
+
+    job.polygons = polygons;
+    job.topology = topology;
+
+    n_blocks = (polygons->n_points + TOPOLOGY_BLOCK_SIZE - 1) /
+               TOPOLOGY_BLOCK_SIZE;
+
+    if( n_blocks > 0 )
+    {
+        n_threads = get_n_threads_to_use( n_threads, n_blocks );
+
+        do_parallel_jobs( n_threads, n_blocks, match_half_edges_block,
+                          (void *) &job );
+        do_parallel_jobs( n_threads, n_blocks, flag_boundary_points_block,
+                          (void *) &job );
+    }
+
+    polygons->topology = topology;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : check_polygons_topology_computed
+@INPUT      : polygons
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Creates the half-edge index of the polygons with the default
+              number of threads, if necessary.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  check_polygons_topology_computed(
+    polygons_struct   *polygons )
+{
+    if( polygons->topology == NULL )
+        create_polygons_topology( polygons, 0 );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : delete_polygons_topology
+@INPUT      : polygons
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Deletes the half-edge index of the polygons, if any.  Must be
+              called whenever the indices of the polygons change.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  delete_polygons_topology(
+    polygons_struct   *polygons )
+{
+    polygon_topology_struct  *topology;
+
+    topology = polygons->topology;
+
+    if( topology == NULL )
+        return;
+
+    FREE( topology->polys );
+    FREE( topology->opposite );
+    FREE( topology->corners );
+    FREE( topology->offsets );
+    FREE( topology->boundary_flags );
+    FREE( topology );
+
+    polygons->topology = NULL;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_polygon_across_edge
+@INPUT      : polygons
+              poly
+              edge
+@OUTPUT     : neighbour_poly
+              neighbour_edge
+@RETURNS    : TRUE if the edge is not on the boundary
+@DESCRIPTION: Finds the polygon sharing the given edge of poly, and the index
+              of the edge within it, in constant time.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  get_polygon_across_edge(
+    polygons_struct   *polygons,
+    int               poly,
+    int               edge,
+    int               *neighbour_poly,
+    int               *neighbour_edge )
+{
+    int   h;
+
+    check_polygons_topology_computed( polygons );
+
+    h = polygons->topology->opposite[POINT_INDEX(polygons->end_indices,
+                                                 poly,edge)];
+    if( h < 0 )
+        return( FALSE );
+
+    *neighbour_poly = polygons->topology->polys[h];
+    *neighbour_edge = h - START_INDEX( polygons->end_indices,
+                                       *neighbour_poly );
+
+    return( TRUE );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : point_is_on_polygons_boundary
+@INPUT      : polygons
+              point_index
+@OUTPUT     :
+@RETURNS    : TRUE if the point is on a boundary edge
+@DESCRIPTION: Tests if a point of the polygons is on the boundary, in
+              constant time.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  point_is_on_polygons_boundary(
+    polygons_struct   *polygons,
+    int               point_index )
+{
+    check_polygons_topology_computed( polygons );
+
+    return( (BOOLEAN) polygons->topology->boundary_flags[point_index] );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_polygons_topology_edge
+@INPUT      : polygons
+              point_index1
+              point_index2
+@OUTPUT     : poly_containing_edge
+              edge_index
+@RETURNS    : TRUE if found
+@DESCRIPTION: Finds the lowest numbered polygon containing the given edge,
+              using the half-edge index, which must have been created.
+              Only the half-edges starting at the two points are examined.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  get_polygons_topology_edge(
+    polygons_struct   *polygons,
+    int               point_index1,
+    int               point_index2,
+    int               *poly_containing_edge,
+    int               *edge_index )
+{
+    polygon_topology_struct  *topology;
+    int                      c, h, best, from, to, pass;
+
+    topology = polygons->topology;
+    best = -1;
+
+    if( point_index1 < 0 || point_index1 >= topology->n_points ||
+        point_index2 < 0 || point_index2 >= topology->n_points )
+        return( FALSE );
+
+    for_less( pass, 0, 2 )
+    {
+        from = (pass == 0) ? point_index1 : point_index2;
+        to = (pass == 0) ? point_index2 : point_index1;
+
+        for_less( c, topology->offsets[from], topology->offsets[from+1] )
+        {
+            h = topology->corners[c];
+            if( get_half_edge_end( polygons, topology, h ) == to )
+            {
+                if( best < 0 || h < best )
+                    best = h;
+                break;
+            }
+        }
+    }
+
+    if( best < 0 )
+        return( FALSE );
+
+    *poly_containing_edge = topology->polys[best];
+    *edge_index = best - START_INDEX( polygons->end_indices,
+                                      *poly_containing_edge );
+
+    return( TRUE );
+}
@@ -95,6 +95,7 @@ BICAPI  void  initialize_polygons(
     polygons->visibilities = (Smallest_int *) 0;
     polygons->neighbours = (int *) 0;
     polygons->bintree = (bintree_struct_ptr) NULL;
+    polygons->topology = NULL;
 }
 
 
@@ -144,12 +145,13 @@ BICAPI  void  initialize_polygons_with_size(
 @INPUT      : polygons
 @OUTPUT     : 
 @RETURNS    : 
-@DESCRIPTION: Deletes the polygon neighbours.
+@DESCRIPTION: Deletes the polygon neighbours and the half-edge index, if
+              any, as must be done whenever the topology changes.
 @METHOD     : 
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1993    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 
 BICAPI  void  free_polygon_neighbours(
@@ -160,6 +162,8 @@ BICAPI  void  free_polygon_neighbours(
         FREE( polygons->neighbours );
         polygons->neighbours = (int *) NULL;
     }
+
+    delete_polygons_topology( polygons );
 }
 
 /* ----------------------------- MNI Header -----------------------------------
@@ -212,7 +216,7 @@ BICAPI  void  delete_polygons( polygons_struct *polygons )
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1993    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 
 BICAPI  void  copy_polygons(
@@ -254,6 +258,7 @@ BICAPI  void  copy_polygons(
     dest->visibilities = (Smallest_int *) 0;
     dest->neighbours = (int *) 0;
     dest->bintree = (bintree_struct_ptr) NULL;
+    dest->topology = NULL;
 }
 
 /* ----------------------------- MNI Header -----------------------------------
@@ -352,7 +357,7 @@ BICAPI  void  set_polygons_visibilities(
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1993    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 
 BICAPI  void  start_new_polygon(
@@ -360,6 +365,8 @@ BICAPI  void  start_new_polygon(
 {
     int      n_indices;
 
+    delete_polygons_topology( polygons );
+
     n_indices = NUMBER_INDICES( *polygons );
 
     ADD_ELEMENT_TO_ARRAY( polygons->end_indices, polygons->n_items,
@@ -378,7 +385,7 @@ BICAPI  void  start_new_polygon(
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1993    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 
 BICAPI  void  add_point_to_polygon(
@@ -391,6 +398,8 @@ BICAPI  void  add_point_to_polygon(
     if( polygons->n_items == 0 )
         start_new_polygon( polygons );
 
+    delete_polygons_topology( polygons );
+
     if( polygons->n_points > 1 )
     {
         if( (normal != (Vector *) 0 && polygons->normals == (Vector *) 0) ||
@@ -580,12 +589,14 @@ BICAPI  int  find_edge_index(
 @OUTPUT     : poly_containing_edge
               edge_index
 @RETURNS    : TRUE if found
-@DESCRIPTION: Finds a polygon containing the given edge.
+@DESCRIPTION: Finds a polygon containing the given edge.  If the half-edge
+              index has been created, only the polygons around the two
+              points are examined.
 @METHOD     : 
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1993    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 
 BICAPI  BOOLEAN  find_polygon_with_edge(
@@ -597,6 +608,11 @@ BICAPI  BOOLEAN  find_polygon_with_edge(
 {
     int   poly;
 
+    if( polygons->topology != NULL )
+        return( get_polygons_topology_edge( polygons, point_index1,
+                                            point_index2, poly_containing_edge,
+                                            edge_index ) );
+
     for_less( poly, 0, polygons->n_items )
     {
         *edge_index = find_edge_index( polygons, poly,
@@ -619,12 +635,13 @@ BICAPI  BOOLEAN  find_polygon_with_edge(
 @OUTPUT     : poly_index
               vertex_index
 @RETURNS    : TRUE if found
-@DESCRIPTION: Searches for a polygon containing the point.
+@DESCRIPTION: Searches for a polygon containing the point, in constant time
+              if the half-edge index has been created.
 @METHOD     : 
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1993    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 
 BICAPI  BOOLEAN  find_polygon_with_vertex(
@@ -633,11 +650,28 @@ BICAPI  BOOLEAN  find_polygon_with_vertex(
     int               *poly_index,
     int               *vertex_index )
 {
-    int      poly, size, i;
+    int      poly, size, i, h;
     BOOLEAN  found;
 
     found = FALSE;
 
+    if( polygons->topology != NULL )
+    {
+        if( point_index < 0 || point_index >= polygons->topology->n_points ||
+            polygons->topology->offsets[point_index+1] ==
+            polygons->topology->offsets[point_index] )
+            return( FALSE );
+
+        /*--- the last polygon containing the point, as found by the scan */
+
+        h = polygons->topology->corners[
+                               polygons->topology->offsets[point_index+1]-1];
+        *poly_index = polygons->topology->polys[h];
+        *vertex_index = h - START_INDEX( polygons->end_indices, *poly_index );
+
+        return( TRUE );
+    }
+
     for_less( poly, 0, polygons->n_items )
     {
         size = GET_OBJECT_SIZE( *polygons, poly );
@@ -704,11 +738,13 @@ BICAPI  BOOLEAN  lookup_polygon_vertex(
               corresponding to an edge, finds the neighbouring poly, and
               the two vertex indices corresponding to the next 
               edge around the point corresponding to poly,index_1.
+              Uses the half-edge index if it has been created, otherwise
+              the polygon neighbours, which must have been computed.
 @METHOD     : 
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1993    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 
 BICAPI  BOOLEAN  find_next_edge_around_point(
@@ -721,7 +757,7 @@ BICAPI  BOOLEAN  find_next_edge_around_point(
     int               *next_index_2 )
 {
     int                    size, edge, point_index, neighbour_point_index;
-    int                    next_neigh_index;
+    int                    next_neigh_index, h;
 
     point_index = polygons->indices[
                        POINT_INDEX( polygons->end_indices, poly, index_1 )];
@@ -736,13 +772,33 @@ BICAPI  BOOLEAN  find_next_edge_around_point(
     else
         edge = index_2;
  
-    *next_poly = polygons->neighbours[
+    if( polygons->topology != NULL )
+    {
+        h = polygons->topology->opposite[
                       POINT_INDEX(polygons->end_indices,poly,edge)];
+        *next_poly = (h < 0) ? -1 : polygons->topology->polys[h];
+    }
+    else
+    {
+        h = -1;
+        *next_poly = polygons->neighbours[
+                          POINT_INDEX(polygons->end_indices,poly,edge)];
+    }
 
     if( *next_poly >= 0 )
     {
         size = GET_OBJECT_SIZE(*polygons,*next_poly);
-        *next_index_1 = find_vertex_index( polygons, *next_poly, point_index );
+
+        if( h >= 0 )
+        {
+            *next_index_1 = h - START_INDEX( polygons->end_indices,
+                                             *next_poly );
+            if( polygons->indices[h] != point_index )
+                *next_index_1 = (*next_index_1 + 1) % size;
+        }
+        else
+            *next_index_1 = find_vertex_index( polygons, *next_poly,
+                                               point_index );
 
         *next_index_2 = (*next_index_1 + 1) % size;
         next_neigh_index = polygons->indices[
@@ -1282,7 +1338,7 @@ BICAPI  BOOLEAN  get_plane_segment_intersection(
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1993    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 
 BICAPI  void   reverse_polygons_vertices(
@@ -1290,8 +1346,7 @@ BICAPI  void   reverse_polygons_vertices(
 {
     int         poly;
 
-    if( polygons->neighbours != NULL )
-        FREE( polygons->neighbours );
+    free_polygon_neighbours( polygons );
 
     for_less( poly, 0, polygons->n_items )
         reverse_polygon_order( polygons, poly );
@@ -1308,7 +1363,7 @@ BICAPI  void   reverse_polygons_vertices(
 @GLOBALS    : 
 @CALLS      : 
 @CREATED    :         1993    David MacDonald
-@MODIFIED   : 
+@MODIFIED   : Oct. 2026
 ---------------------------------------------------------------------------- */
 
 BICAPI  void   make_polygons_front_facing(
@@ -1316,8 +1371,7 @@ BICAPI  void   make_polygons_front_facing(
 {
     int         poly;
 
-    if( polygons->neighbours != (int *) 0 )
-        FREE( polygons->neighbours );
+    free_polygon_neighbours( polygons );
 
     for_less( poly, 0, polygons->n_items )
     {
@@ -0,0 +1,641 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#include "bicpl_internal.h"
+
+/*--- A surface bundle file holds many surfaces with the same topology, such
+      as one surface per subject of a study, storing the topology once.  It
+      is binary, in the native byte order:
+
+          magic               8 characters
+          byte order check    int
+          version             int
+          encoding            int
+          n_points            int
+          n_items             int
+          n_subjects          int
+          surfprop
+          end_indices         n_items ints
+          indices             end_indices[n_items-1] ints
+          reference points    n_points Points, BUNDLE_DELTA_FLOAT16 only
+          subjects            n_subjects blocks of n_points points
+
+      Each subject is 3 floats per point for BUNDLE_FLOAT32, and 3 half
+      precision floats per point for BUNDLE_FLOAT16.  BUNDLE_DELTA_FLOAT16
+      stores the half precision difference from the reference points, which
+      are those of the first subject, so the precision is much better than
+      BUNDLE_FLOAT16 when the surfaces are close to each other. */
+
+#define  BUNDLE_MAGIC            "SURFBNDL"
+#define  BUNDLE_MAGIC_LENGTH     8
+#define  BUNDLE_BYTE_ORDER       0x01020304
+#define  BUNDLE_VERSION          1
+
+/*--- offset of n_subjects, rewritten as subjects are added */
+
+#define  N_SUBJECTS_OFFSET       (BUNDLE_MAGIC_LENGTH + 5 * sizeof(int))
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : float_to_half
+@INPUT      : value
+@OUTPUT     :
+@RETURNS    : IEEE half precision bits
+@DESCRIPTION: Converts a float to the nearest half precision float, rounding
+              ties to even, with overflow to infinity.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  unsigned short  float_to_half(
+    float   value )
+{
+    unsigned int    bits, sign, mantissa, round_bit, sticky;
+    int             exponent, shift;
+    unsigned short  half;
+
+    (void) memcpy( &bits, &value, sizeof(bits) );
+
+    sign = (bits >> 16) & 0x8000u;
+    exponent = (int) ((bits >> 23) & 0xff);
+    mantissa = bits & 0x7fffffu;
+
+    if( exponent == 0xff )
+    {
+        half = (unsigned short) (sign | 0x7c00u | (mantissa != 0 ? 0x200u : 0));
+        return( half );
+    }
+
+    exponent = exponent - 127 + 15;
+
+    if( exponent >= 0x1f )
+        return( (unsigned short) (sign | 0x7c00u) );
+
+    if( exponent <= 0 )
+    {
+        /*--- subnormal half, or zero */
+
+        if( exponent < -10 )
+            return( (unsigned short) sign );
+
+        mantissa |= 0x800000u;
+        shift = 14 - exponent;
+        round_bit = (mantissa >> (shift - 1)) & 1u;
+        sticky = (mantissa & ((1u << (shift - 1)) - 1u)) != 0;
+        mantissa >>= shift;
+
+        if( round_bit && (sticky || (mantissa & 1u)) )
+            ++mantissa;
+
+        return( (unsigned short) (sign | mantissa) );
+    }
+
+    round_bit = (mantissa >> 12) & 1u;
+    sticky = (mantissa & 0xfffu) != 0;
+    half = (unsigned short) (sign | ((unsigned int) exponent << 10) |
+                             (mantissa >> 13));
+
+    /*--- a carry out of the mantissa correctly increments the exponent */
+
+    if( round_bit && (sticky || (half & 1u)) )
+        ++half;
+
+    return( half );
+}
+
+static  float  half_to_float(
+    unsigned short  half )
+{
+    unsigned int   sign, exponent, mantissa, bits;
+    float          value;
+
+    sign = ((unsigned int) half & 0x8000u) << 16;
+    exponent = ((unsigned int) half >> 10) & 0x1fu;
+    mantissa = (unsigned int) half & 0x3ffu;
+
+    if( exponent == 0x1f )
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    else if( exponent != 0 )
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    else if( mantissa == 0 )
+        bits = sign;
+    else
+    {
+        /*--- subnormal half, normalized as a float */
+
+        exponent = 127 - 15 + 1;
+        while( (mantissa & 0x400u) == 0 )
+        {
+            mantissa <<= 1;
+            --exponent;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+    }
+
+    (void) memcpy( &value, &bits, sizeof(value) );
+
+    return( value );
+}
+
+static  size_t  get_subject_size(
+    surface_bundle_struct  *bundle )
+{
+    if( bundle->encoding == BUNDLE_FLOAT32 )
+        return( (size_t) bundle->polygons.n_points * sizeof(Point) );
+    else
+        return( (size_t) bundle->polygons.n_points * 3 *
+                sizeof(unsigned short) );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : create_surface_bundle
+@INPUT      : filename
+              topology   - polygons whose topology is shared by all subjects
+              encoding   - BUNDLE_FLOAT32, BUNDLE_FLOAT16 or
+                           BUNDLE_DELTA_FLOAT16
+@OUTPUT     : bundle
+@RETURNS    : OK or ERROR
+@DESCRIPTION: Creates a surface bundle file holding the topology, to which
+              the points of each subject are then added with
+              add_surface_bundle_subject(), and which is finished with
+              close_surface_bundle().
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Status  create_surface_bundle(
+    STRING                 filename,
+    polygons_struct        *topology,
+    Bundle_encodings       encoding,
+    surface_bundle_struct  *bundle )
+{
+    Status   status;
+    int      byte_order, version, enc, n_subjects;
+
+    if( topology->n_points <= 0 || topology->n_items <= 0 )
+    {
+        print_error( "create_surface_bundle: empty topology.\n" );
+        return( ERROR );
+    }
+
+    status = open_file( filename, WRITE_FILE, BINARY_FORMAT, &bundle->file );
+
+    if( status != OK )
+        return( status );
+
+    bundle->io_flag = WRITE_FILE;
+    bundle->encoding = encoding;
+    bundle->n_subjects = 0;
+    bundle->reference = NULL;
+    bundle->buffer = NULL;
+
+    /*--- the bundle polygons hold only the counts when writing */
+
+    bundle->polygons = *topology;
+    bundle->polygons.points = NULL;
+    bundle->polygons.normals = NULL;
+    bundle->polygons.end_indices = NULL;
+    bundle->polygons.indices = NULL;
+    bundle->polygons.colours = NULL;
+
+    byte_order = BUNDLE_BYTE_ORDER;
+    version = BUNDLE_VERSION;
+    enc = (int) encoding;
+    n_subjects = 0;
+
+    status = io_binary_data( bundle->file, WRITE_FILE, (void *) BUNDLE_MAGIC,
+                             sizeof(char), BUNDLE_MAGIC_LENGTH );
+
+    if( status == OK )
+        status = io_binary_data( bundle->file, WRITE_FILE, &byte_order,
+                                 sizeof(int), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, WRITE_FILE, &version,
+                                 sizeof(int), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, WRITE_FILE, &enc,
+                                 sizeof(int), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, WRITE_FILE,
+                                 &topology->n_points, sizeof(int), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, WRITE_FILE,
+                                 &topology->n_items, sizeof(int), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, WRITE_FILE, &n_subjects,
+                                 sizeof(int), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, WRITE_FILE,
+                                 &topology->surfprop, sizeof(Surfprop), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, WRITE_FILE,
+                                 topology->end_indices, sizeof(int),
+                                 topology->n_items );
+    if( status == OK )
+        status = io_binary_data( bundle->file, WRITE_FILE,
+                                 topology->indices, sizeof(int),
+                                 NUMBER_INDICES(*topology) );
+
+    if( status == OK && encoding != BUNDLE_FLOAT32 )
+        ALLOC( bundle->buffer, 3 * topology->n_points );
+
+    if( status != OK )
+        (void) close_file( bundle->file );
+
+    return( status );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : add_surface_bundle_subject
+@INPUT      : bundle
+              points   - n_points points of the next subject
+@OUTPUT     :
+@RETURNS    : OK or ERROR
+@DESCRIPTION: Appends the points of a subject to a bundle being created.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Status  add_surface_bundle_subject(
+    surface_bundle_struct  *bundle,
+    Point                  points[] )
+{
+    Status   status;
+    int      n_points, p, dim;
+    float    value;
+
+    if( bundle->io_flag != WRITE_FILE )
+    {
+        print_error( "add_surface_bundle_subject: bundle not created.\n" );
+        return( ERROR );
+    }
+
+    n_points = bundle->polygons.n_points;
+    status = OK;
+
+    if( bundle->encoding == BUNDLE_DELTA_FLOAT16 && bundle->n_subjects == 0 )
+    {
+        ALLOC( bundle->reference, n_points );
+        for_less( p, 0, n_points )
+            bundle->reference[p] = points[p];
+
+        status = io_binary_data( bundle->file, WRITE_FILE, bundle->reference,
+                                 sizeof(Point), n_points );
+    }
+
+    if( status != OK )
+        return( status );
+
+    if( bundle->encoding == BUNDLE_FLOAT32 )
+    {
+        status = io_binary_data( bundle->file, WRITE_FILE, points,
+                                 sizeof(Point), n_points );
+    }
+    else
+    {
+        for_less( p, 0, n_points )
+        for_less( dim, 0, N_DIMENSIONS )
+        {
+            value = Point_coord( points[p], dim );
+            if( bundle->encoding == BUNDLE_DELTA_FLOAT16 )
+                value -= Point_coord( bundle->reference[p], dim );
+
+            bundle->buffer[3*p+dim] = float_to_half( value );
+        }
+
+        status = io_binary_data( bundle->file, WRITE_FILE, bundle->buffer,
+                                 sizeof(unsigned short), 3 * n_points );
+    }
+
+    if( status == OK )
+        ++bundle->n_subjects;
+
+    return( status );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : open_surface_bundle
+@INPUT      : filename
+@OUTPUT     : bundle
+@RETURNS    : OK or ERROR
+@DESCRIPTION: Opens a surface bundle file for reading, reading the topology
+              into bundle->polygons, whose points are then filled in for one
+              subject at a time by input_surface_bundle_subject().
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Status  open_surface_bundle(
+    STRING                 filename,
+    surface_bundle_struct  *bundle )
+{
+    Status           status;
+    char             magic[BUNDLE_MAGIC_LENGTH];
+    int              byte_order, version, enc, n_points, n_items, p;
+    Surfprop         surfprop;
+    polygons_struct  *polygons;
+
+    status = open_file( filename, READ_FILE, BINARY_FORMAT, &bundle->file );
+
+    if( status != OK )
+        return( status );
+
+    status = io_binary_data( bundle->file, READ_FILE, magic, sizeof(char),
+                             BUNDLE_MAGIC_LENGTH );
+
+    if( status == OK &&
+        strncmp( magic, BUNDLE_MAGIC, BUNDLE_MAGIC_LENGTH ) != 0 )
+    {
+        print_error( "%s is not a surface bundle file.\n", filename );
+        status = ERROR;
+    }
+
+    if( status == OK )
+        status = io_binary_data( bundle->file, READ_FILE, &byte_order,
+                                 sizeof(int), 1 );
+
+    if( status == OK && byte_order != BUNDLE_BYTE_ORDER )
+    {
+        print_error( "%s was written with a different byte order.\n",
+                     filename );
+        status = ERROR;
+    }
+
+    if( status == OK )
+        status = io_binary_data( bundle->file, READ_FILE, &version,
+                                 sizeof(int), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, READ_FILE, &enc,
+                                 sizeof(int), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, READ_FILE, &n_points,
+                                 sizeof(int), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, READ_FILE, &n_items,
+                                 sizeof(int), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, READ_FILE,
+                                 &bundle->n_subjects, sizeof(int), 1 );
+    if( status == OK )
+        status = io_binary_data( bundle->file, READ_FILE, &surfprop,
+                                 sizeof(Surfprop), 1 );
+
+    if( status == OK &&
+        (version != BUNDLE_VERSION || enc < (int) BUNDLE_FLOAT32 ||
+         enc > (int) BUNDLE_DELTA_FLOAT16 || n_points <= 0 || n_items <= 0 ||
+         bundle->n_subjects < 0) )
+    {
+        print_error( "Invalid surface bundle header in %s.\n", filename );
+        status = ERROR;
+    }
+
+    if( status != OK )
+    {
+        (void) close_file( bundle->file );
+        return( status );
+    }
+
+    bundle->io_flag = READ_FILE;
+    bundle->encoding = (Bundle_encodings) enc;
+    bundle->reference = NULL;
+    bundle->buffer = NULL;
+
+    polygons = &bundle->polygons;
+    initialize_polygons( polygons, WHITE, &surfprop );
+
+    polygons->n_points = n_points;
+    polygons->n_items = n_items;
+    ALLOC( polygons->points, n_points );
+    ALLOC( polygons->normals, n_points );
+    ALLOC( polygons->end_indices, n_items );
+
+    for_less( p, 0, n_points )
+    {
+        fill_Point( polygons->points[p], 0.0, 0.0, 0.0 );
+        fill_Vector( polygons->normals[p], 0.0, 0.0, 0.0 );
+    }
+
+    status = io_binary_data( bundle->file, READ_FILE, polygons->end_indices,
+                             sizeof(int), n_items );
+
+    if( status == OK && NUMBER_INDICES(*polygons) <= 0 )
+        status = ERROR;
+
+    if( status == OK )
+    {
+        ALLOC( polygons->indices, NUMBER_INDICES(*polygons) );
+        status = io_binary_data( bundle->file, READ_FILE, polygons->indices,
+                                 sizeof(int), NUMBER_INDICES(*polygons) );
+    }
+
+    if( status == OK && bundle->encoding == BUNDLE_DELTA_FLOAT16 &&
+        bundle->n_subjects > 0 )
+    {
+        ALLOC( bundle->reference, n_points );
+        status = io_binary_data( bundle->file, READ_FILE, bundle->reference,
+                                 sizeof(Point), n_points );
+    }
+
+    if( status == OK && bundle->encoding != BUNDLE_FLOAT32 )
+        ALLOC( bundle->buffer, 3 * n_points );
+
+    if( status == OK )
+        bundle->data_start = ftell( bundle->file );
+
+    if( status != OK )
+    {
+        print_error( "Error reading surface bundle %s.\n", filename );
+        (void) close_surface_bundle( bundle );
+    }
+
+    return( status );
+}
+
+BICAPI  int  get_surface_bundle_n_subjects(
+    surface_bundle_struct  *bundle )
+{
+    return( bundle->n_subjects );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : input_surface_bundle_subject
+@INPUT      : bundle
+              subject          - 0 to n_subjects - 1, in any order
+              compute_normals  - whether to compute the normals
+@OUTPUT     :
+@RETURNS    : OK or ERROR
+@DESCRIPTION: Reads the points of one subject of a bundle into the points
+              of bundle->polygons, overwriting the previous subject's, so
+              that the topology and arrays are reused from subject to
+              subject.  The normals are left as they were unless
+              compute_normals is TRUE.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Status  input_surface_bundle_subject(
+    surface_bundle_struct  *bundle,
+    int                    subject,
+    BOOLEAN                compute_normals )
+{
+    Status    status;
+    int       p, dim, n_points;
+    Real      value;
+    Point     *points;
+
+    if( bundle->io_flag != READ_FILE ||
+        subject < 0 || subject >= bundle->n_subjects )
+    {
+        print_error( "input_surface_bundle_subject: invalid subject %d.\n",
+                     subject );
+        return( ERROR );
+    }
+
+    n_points = bundle->polygons.n_points;
+    points = bundle->polygons.points;
+
+    if( fseek( bundle->file, bundle->data_start +
+                             (long) subject * (long) get_subject_size( bundle ),
+               SEEK_SET ) != 0 )
+    {
+        print_error( "input_surface_bundle_subject: error seeking.\n" );
+        return( ERROR );
+    }
+
+    if( bundle->encoding == BUNDLE_FLOAT32 )
+    {
+        status = io_binary_data( bundle->file, READ_FILE, points,
+                                 sizeof(Point), n_points );
+    }
+    else
+    {
+        status = io_binary_data( bundle->file, READ_FILE, bundle->buffer,
+                                 sizeof(unsigned short), 3 * n_points );
+
+        if( status == OK )
+        {
+            for_less( p, 0, n_points )
+            for_less( dim, 0, N_DIMENSIONS )
+            {
+                value = (Real) half_to_float( bundle->buffer[3*p+dim] );
+                if( bundle->encoding == BUNDLE_DELTA_FLOAT16 )
+                    value += (Real) Point_coord( bundle->reference[p], dim );
+
+                Point_coord( points[p], dim ) = (Point_coord_type) value;
+            }
+        }
+    }
+
+    if( status == OK && compute_normals )
+        compute_polygon_normals( &bundle->polygons );
+
+    return( status );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : close_surface_bundle
+@INPUT      : bundle
+@OUTPUT     :
+@RETURNS    : OK or ERROR
+@DESCRIPTION: Closes a bundle being read or created.  When creating, the
+              number of subjects is written into the header.  When reading,
+              bundle->polygons is deleted.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  Status  close_surface_bundle(
+    surface_bundle_struct  *bundle )
+{
+    Status   status;
+
+    status = OK;
+
+    if( bundle->io_flag == WRITE_FILE )
+    {
+        if( fseek( bundle->file, (long) N_SUBJECTS_OFFSET, SEEK_SET ) != 0 )
+            status = ERROR;
+
+        if( status == OK )
+            status = io_binary_data( bundle->file, WRITE_FILE,
+                                     &bundle->n_subjects, sizeof(int), 1 );
+    }
+    else
+        delete_polygons( &bundle->polygons );
+
+    if( close_file( bundle->file ) != OK )
+        status = ERROR;
+
+    if( bundle->reference != NULL )
+        FREE( bundle->reference );
+
+    if( bundle->buffer != NULL )
+        FREE( bundle->buffer );
+
+    return( status );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : is_surface_bundle_file
+@INPUT      : filename
+@OUTPUT     :
+@RETURNS    : TRUE if the file starts as a surface bundle does
+@DESCRIPTION: Lets programs accept either surface bundles or object files.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  is_surface_bundle_file(
+    STRING   filename )
+{
+    FILE     *file;
+    char     magic[BUNDLE_MAGIC_LENGTH];
+    BOOLEAN  is_bundle;
+    STRING   expanded;
+
+    expanded = expand_filename( filename );
+    file = fopen( expanded, "rb" );
+    delete_string( expanded );
+
+    if( file == NULL )
+        return( FALSE );
+
+    is_bundle = fread( magic, 1, BUNDLE_MAGIC_LENGTH, file ) ==
+                                                    BUNDLE_MAGIC_LENGTH &&
+                strncmp( magic, BUNDLE_MAGIC, BUNDLE_MAGIC_LENGTH ) == 0;
+
+    (void) fclose( file );
+
+    return( is_bundle );
+}
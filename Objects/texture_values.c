@@ -17,6 +17,241 @@ static char rcsid[] = "$Header: /private-cvsroot/libraries/bicpl/Objects/texture
 #endif
 
 #include "bicpl_internal.h"
+#include  <ctype.h>
+#include  <stdlib.h>
+
+/*--- size of the chunks in which ascii texture files are read */
+
+#define  TEXTURE_BUFFER_SIZE   65536
+
+/*--- a value written with more significant digits, or a larger exponent,
+      is left to strtod() */
+
+#define  MAX_FAST_DIGITS       15
+#define  MAX_FAST_EXPONENT     22
+
+static  double  exact_powers_of_ten[MAX_FAST_EXPONENT+1] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+typedef  struct
+{
+    FILE      *file;
+    char      *buffer;
+    int       start;
+    int       end;
+    BOOLEAN   end_of_file;
+} texture_stream_struct;
+
+/*--- parses a plain decimal number at s, which must be followed by white
+      space or the end of the string.  The significant digits are
+      accumulated exactly in a double and scaled by an exactly
+      representable power of ten, so the result is correctly rounded and
+      the same as that of strtod().  Returns FALSE for anything else, such
+      as too many digits, hexadecimal or nan, for strtod() to handle. */
+
+static  BOOLEAN  parse_fast_decimal(
+    char     *s,
+    double   *value,
+    char     **next )
+{
+    double    mantissa;
+    int       n_digits, exponent, exp_value, exp_sign;
+    BOOLEAN   negative, any_digits;
+    char      *p, *exp_start;
+
+    p = s;
+    negative = FALSE;
+    if( *p == '-' || *p == '+' )
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    mantissa = 0.0;
+    n_digits = 0;
+    exponent = 0;
+    any_digits = FALSE;
+
+    while( *p >= '0' && *p <= '9' )
+    {
+        any_digits = TRUE;
+        if( mantissa != 0.0 || *p != '0' )
+        {
+            mantissa = 10.0 * mantissa + (double) (*p - '0');
+            ++n_digits;
+        }
+        ++p;
+    }
+
+    if( *p == '.' )
+    {
+        ++p;
+        while( *p >= '0' && *p <= '9' )
+        {
+            any_digits = TRUE;
+            if( mantissa != 0.0 || *p != '0' )
+            {
+                mantissa = 10.0 * mantissa + (double) (*p - '0');
+                ++n_digits;
+            }
+            --exponent;
+            ++p;
+        }
+    }
+
+    if( !any_digits || n_digits > MAX_FAST_DIGITS )
+        return( FALSE );
+
+    if( *p == 'e' || *p == 'E' )
+    {
+        exp_start = p;
+        ++p;
+        exp_sign = 1;
+        if( *p == '-' || *p == '+' )
+        {
+            exp_sign = (*p == '-') ? -1 : 1;
+            ++p;
+        }
+
+        if( *p < '0' || *p > '9' )
+            p = exp_start;
+        else
+        {
+            exp_value = 0;
+            while( *p >= '0' && *p <= '9' )
+            {
+                if( exp_value < 10000 )
+                    exp_value = 10 * exp_value + (*p - '0');
+                ++p;
+            }
+            exponent += exp_sign * exp_value;
+        }
+    }
+
+    if( *p != '\0' && *p != ' ' && *p != '\t' && *p != '\n' &&
+        *p != '\r' && *p != '\f' && *p != '\v' )
+        return( FALSE );
+
+    if( mantissa != 0.0 )
+    {
+        if( exponent < -MAX_FAST_EXPONENT || exponent > MAX_FAST_EXPONENT )
+            return( FALSE );
+
+        if( exponent < 0 )
+            mantissa /= exact_powers_of_ten[-exponent];
+        else
+            mantissa *= exact_powers_of_ten[exponent];
+    }
+
+    *value = negative ? -mantissa : mantissa;
+    *next = p;
+
+    return( TRUE );
+}
+
+static  void  initialize_texture_stream(
+    texture_stream_struct  *stream,
+    FILE                   *file )
+{
+    stream->file = file;
+    ALLOC( stream->buffer, TEXTURE_BUFFER_SIZE + 1 );
+    stream->start = 0;
+    stream->end = 0;
+    stream->end_of_file = FALSE;
+    stream->buffer[0] = '\0';
+}
+
+static  void  delete_texture_stream(
+    texture_stream_struct  *stream )
+{
+    FREE( stream->buffer );
+}
+
+/*--- moves the unread characters to the start of the buffer and fills the
+      rest from the file */
+
+static  void  refill_texture_stream(
+    texture_stream_struct  *stream )
+{
+    int     i, n_left;
+    size_t  n_read;
+
+    n_left = stream->end - stream->start;
+    for_less( i, 0, n_left )
+        stream->buffer[i] = stream->buffer[stream->start+i];
+
+    stream->start = 0;
+    stream->end = n_left;
+
+    n_read = fread( &stream->buffer[n_left], 1,
+                    (size_t) (TEXTURE_BUFFER_SIZE - n_left), stream->file );
+
+    if( n_read == 0 )
+        stream->end_of_file = TRUE;
+
+    stream->end += (int) n_read;
+    stream->buffer[stream->end] = '\0';
+}
+
+/*--- reads the next number, stopping like input_real() at the end of the
+      file or at anything that is not a number */
+
+static  BOOLEAN  input_texture_stream_value(
+    texture_stream_struct  *stream,
+    double                 *value )
+{
+    char   *buffer, *next;
+    int    word_end;
+
+    buffer = stream->buffer;
+
+    while( TRUE )
+    {
+        while( stream->start < stream->end &&
+               isspace( (unsigned char) buffer[stream->start] ) )
+            ++stream->start;
+
+        if( stream->start == stream->end )
+        {
+            if( stream->end_of_file )
+                return( FALSE );
+
+            refill_texture_stream( stream );
+            continue;
+        }
+
+        /*--- the whole word must be in the buffer before it is parsed */
+
+        word_end = stream->start;
+        while( word_end < stream->end &&
+               !isspace( (unsigned char) buffer[word_end] ) )
+            ++word_end;
+
+        if( word_end == stream->end && !stream->end_of_file &&
+            (stream->start > 0 || stream->end < TEXTURE_BUFFER_SIZE) )
+        {
+            refill_texture_stream( stream );
+            continue;
+        }
+
+        break;
+    }
+
+    if( !parse_fast_decimal( &buffer[stream->start], value, &next ) )
+    {
+        *value = strtod( &buffer[stream->start], &next );
+
+        if( next == &buffer[stream->start] )
+            return( FALSE );
+    }
+
+    stream->start = (int) (next - buffer);
+
+    return( TRUE );
+}
 
 static  Status  output_texture_values_ascii(
     STRING   filename,
@@ -53,9 +288,10 @@ static  Status  input_texture_values_ascii(
     int      *n_values,
     Real     *values[] )
 {
-    Status   status;
-    FILE     *file;
-    Real     value;
+    Status                 status;
+    FILE                   *file;
+    double                 value;
+    texture_stream_struct  stream;
 
     status = open_file( filename, READ_FILE, ASCII_FORMAT, &file );
 
@@ -65,11 +301,16 @@ static  Status  input_texture_values_ascii(
     *n_values = 0;
     *values = NULL;
 
-    while( input_real( file, &value ) == OK )
+    initialize_texture_stream( &stream, file );
+
+    while( input_texture_stream_value( &stream, &value ) )
     {
-        ADD_ELEMENT_TO_ARRAY( *values, *n_values, value, DEFAULT_CHUNK_SIZE );
+        ADD_ELEMENT_TO_ARRAY( *values, *n_values, (Real) value,
+                              DEFAULT_CHUNK_SIZE );
     }
 
+    delete_texture_stream( &stream );
+
     (void) close_file( file );
 
     return( OK );
@@ -175,3 +416,258 @@ BICAPI  Status  input_texture_values(
 
     return( status );
 }
+
+/*--- stores a value in a buffer of floats or doubles */
+
+static  void  set_texture_buffer_value(
+    nc_type   value_type,
+    void      *values,
+    int       index,
+    double    value )
+{
+    if( value_type == NC_FLOAT )
+        ((float *) values)[index] = (float) value;
+    else
+        ((double *) values)[index] = value;
+}
+
+static  Status  input_texture_values_ascii_to_buffer(
+    STRING    filename,
+    nc_type   value_type,
+    int       max_values,
+    void      *values,
+    int       *n_values )
+{
+    Status                 status;
+    FILE                   *file;
+    double                 value;
+    texture_stream_struct  stream;
+
+    status = open_file( filename, READ_FILE, ASCII_FORMAT, &file );
+
+    if( status != OK )
+        return( status );
+
+    *n_values = 0;
+
+    initialize_texture_stream( &stream, file );
+
+    while( input_texture_stream_value( &stream, &value ) )
+    {
+        if( *n_values >= max_values )
+        {
+            print_error( "More than %d values in file %s\n", max_values,
+                         filename );
+            status = ERROR;
+            break;
+        }
+
+        set_texture_buffer_value( value_type, values, *n_values, value );
+        ++(*n_values);
+    }
+
+    delete_texture_stream( &stream );
+
+    (void) close_file( file );
+
+    return( status );
+}
+
+static  Status  input_texture_values_binary_to_buffer(
+    STRING    filename,
+    nc_type   value_type,
+    int       max_values,
+    void      *values,
+    int       *n_values )
+{
+    int      v, sizes[2];
+    Status   status;
+    Volume   volume;
+    STRING   dim_names[] = { MIxspace, MIyspace };
+
+    status = input_volume( filename, 2, dim_names,
+                           NC_UNSPECIFIED, FALSE, 0.0, 0.0,
+                           TRUE, &volume, NULL );
+
+    if( status != OK )
+        return( status );
+
+    get_volume_sizes( volume, sizes );
+
+    if( sizes[1] > max_values )
+    {
+        print_error( "More than %d values in file %s\n", max_values,
+                     filename );
+        delete_volume( volume );
+        return( ERROR );
+    }
+
+    *n_values = sizes[1];
+
+    for_less( v, 0, *n_values )
+    {
+        set_texture_buffer_value( value_type, values, v, (double)
+                          get_volume_real_value( volume, 0, v, 0, 0, 0 ) );
+    }
+
+    delete_volume( volume );
+
+    return( OK );
+}
+
+/*!
+ * \brief Read a set of values from file into a buffer.
+ *
+ * Reads the values of a file written by output_texture_values() directly
+ * into \a values, an array of \a max_values floats if \a value_type is
+ * NC_FLOAT, or doubles if it is NC_DOUBLE, and sets \a n_values to the
+ * number read.  It is an error for the file to hold more than
+ * \a max_values values.  Ascii files are read in large chunks and
+ * parsed without going through input_real(), giving the same values.
+ */
+BICAPI  Status  input_texture_values_to_buffer(
+    STRING         filename,
+    nc_type        value_type,
+    int            max_values,
+    void           *values,
+    int            *n_values )
+{
+    Status         status;
+
+    if( value_type != NC_FLOAT && value_type != NC_DOUBLE )
+    {
+        print_error( "input_texture_values_to_buffer: "
+                     "values must be NC_FLOAT or NC_DOUBLE.\n" );
+        return( ERROR );
+    }
+
+    if( filename_extension_matches( filename, MNC_ENDING ) )
+        status = input_texture_values_binary_to_buffer( filename, value_type,
+                                                        max_values, values,
+                                                        n_values );
+    else
+        status = input_texture_values_ascii_to_buffer( filename, value_type,
+                                                       max_values, values,
+                                                       n_values );
+
+    return( status );
+}
+
+typedef  struct
+{
+    STRING    *filenames;
+    nc_type   value_type;
+    int       n_values;
+    void      *matrix;
+    Status    *statuses;
+} texture_matrix_struct;
+
+/*--- reads one file into its row of the matrix, checking that it has the
+      right number of values */
+
+static  Status  input_texture_matrix_row(
+    texture_matrix_struct  *job,
+    int                    file )
+{
+    Status   status;
+    size_t   offset;
+    void     *row;
+    int      n_read;
+
+    offset = (size_t) file * (size_t) job->n_values;
+
+    if( job->value_type == NC_FLOAT )
+        row = (void *) &((float *) job->matrix)[offset];
+    else
+        row = (void *) &((double *) job->matrix)[offset];
+
+    status = input_texture_values_to_buffer( job->filenames[file],
+                                             job->value_type, job->n_values,
+                                             row, &n_read );
+
+    if( status == OK && n_read != job->n_values )
+    {
+        print_error( "File %s has %d values instead of %d\n",
+                     job->filenames[file], n_read, job->n_values );
+        status = ERROR;
+    }
+
+    return( status );
+}
+
+/*--- the parallel job reading one ascii file; MINC files are read
+      afterwards, one at a time, as the MINC library is not thread safe */
+
+static  void  input_texture_matrix_job(
+    void   *data,
+    int    file,
+    int    thread )
+{
+    texture_matrix_struct  *job;
+
+    job = (texture_matrix_struct *) data;
+
+    if( !filename_extension_matches( job->filenames[file], MNC_ENDING ) )
+        job->statuses[file] = input_texture_matrix_row( job, file );
+}
+
+/*!
+ * \brief Read the values of many files into one matrix.
+ *
+ * Reads \a n_files files, such as one per subject, each holding exactly
+ * \a n_values values, into the contiguous \a matrix of n_files rows of
+ * n_values floats if \a value_type is NC_FLOAT or doubles if it is
+ * NC_DOUBLE.  The value of vertex v of file f is at index
+ * f * n_values + v.  Ascii files are read in parallel on \a n_threads
+ * threads, or the default number if \a n_threads <= 0.  Returns ERROR if
+ * any file cannot be read.
+ */
+BICAPI  Status  input_texture_values_matrix(
+    int            n_files,
+    STRING         filenames[],
+    nc_type        value_type,
+    int            n_values,
+    void           *matrix,
+    int            n_threads )
+{
+    int                    file;
+    Status                 status;
+    texture_matrix_struct  job;
+
+    if( n_files <= 0 )
+        return( OK );
+
+    if( value_type != NC_FLOAT && value_type != NC_DOUBLE )
+    {
+        print_error( "input_texture_values_matrix: "
+                     "values must be NC_FLOAT or NC_DOUBLE.\n" );
+        return( ERROR );
+    }
+
+    job.filenames = filenames;
+    job.value_type = value_type;
+    job.n_values = n_values;
+    job.matrix = matrix;
+
+    ALLOC( job.statuses, n_files );
+    for_less( file, 0, n_files )
+        job.statuses[file] = OK;
+
+    do_parallel_jobs( get_n_threads_to_use( n_threads, n_files ), n_files,
+                      input_texture_matrix_job, (void *) &job );
+
+    status = OK;
+
+    for_less( file, 0, n_files )
+    {
+        if( filename_extension_matches( filenames[file], MNC_ENDING ) )
+            job.statuses[file] = input_texture_matrix_row( &job, file );
+
+        if( job.statuses[file] != OK )
+            status = ERROR;
+    }
+
+    FREE( job.statuses );
+
+    return( status );
+}
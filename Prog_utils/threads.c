@@ -0,0 +1,317 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "bicpl_internal.h"
+
+#if HAVE_PTHREAD_H
+#include  <pthread.h>
+#endif
+
+#if HAVE_UNISTD_H
+#include  <unistd.h>
+#endif
+
+#include <stdlib.h>
+
+#define  N_THREADS_ENV_VARIABLE   "BICPL_N_THREADS"
+
+#define  MAX_THREADS              256
+
+static  int  default_n_threads = 0;
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_n_processors
+@INPUT      :
+@OUTPUT     :
+@RETURNS    : number of processors
+@DESCRIPTION: Returns the number of online processors, or 1 if this cannot
+              be determined.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  int  get_n_processors( void )
+{
+    int   n_processors;
+
+    n_processors = 1;
+
+#if HAVE_SYSCONF && defined(_SC_NPROCESSORS_ONLN)
+    n_processors = (int) sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+
+    if( n_processors < 1 )
+        n_processors = 1;
+
+    return( n_processors );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : set_default_n_threads
+@INPUT      : n_threads
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Sets the number of threads used by the parallel routines when
+              the caller passes a non-positive thread count.  Passing 0
+              reverts to the BICPL_N_THREADS environment variable, or the
+              number of processors if it is not set.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  set_default_n_threads(
+    int   n_threads )
+{
+    if( n_threads < 0 )
+        n_threads = 0;
+
+    default_n_threads = MIN( n_threads, MAX_THREADS );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_default_n_threads
+@INPUT      :
+@OUTPUT     :
+@RETURNS    : number of threads
+@DESCRIPTION: Returns the number of threads used by the parallel routines
+              when the caller passes a non-positive thread count.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  int  get_default_n_threads( void )
+{
+    int     n_threads;
+    char    *env_value;
+
+    if( default_n_threads > 0 )
+        return( default_n_threads );
+
+    env_value = getenv( N_THREADS_ENV_VARIABLE );
+
+    if( env_value == NULL || sscanf( env_value, "%d", &n_threads ) != 1 ||
+        n_threads < 1 )
+    {
+        n_threads = get_n_processors();
+    }
+
+    return( MIN( n_threads, MAX_THREADS ) );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_n_threads_to_use
+@INPUT      : n_threads  - requested number, or <= 0 for the default
+              n_jobs
+@OUTPUT     :
+@RETURNS    : number of threads
+@DESCRIPTION: Resolves a requested thread count, never exceeding the number
+              of jobs, and always 1 if the library was built without
+              thread support.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  int  get_n_threads_to_use(
+    int   n_threads,
+    int   n_jobs )
+{
+#if HAVE_PTHREAD_H
+    if( n_threads <= 0 )
+        n_threads = get_default_n_threads();
+
+    n_threads = MIN( n_threads, MAX_THREADS );
+    n_threads = MIN( n_threads, n_jobs );
+#else
+    n_threads = 1;
+#endif
+
+    if( n_threads < 1 )
+        n_threads = 1;
+
+    return( n_threads );
+}
+
+#if HAVE_PTHREAD_H
+
+typedef  struct
+{
+    pthread_mutex_t      mutex;
+    int                  next_job;
+    int                  n_jobs;
+    parallel_job_func    job_func;
+    void                 *data;
+} job_queue_struct;
+
+typedef  struct
+{
+    job_queue_struct     *queue;
+    int                  thread_index;
+} worker_struct;
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_next_job
+@INPUT      : queue
+@OUTPUT     :
+@RETURNS    : job index, or -1 if none left
+@DESCRIPTION: Hands out job indices in increasing order to whichever worker
+              asks first.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  int  get_next_job(
+    job_queue_struct  *queue )
+{
+    int   job;
+
+    (void) pthread_mutex_lock( &queue->mutex );
+
+    if( queue->next_job < queue->n_jobs )
+    {
+        job = queue->next_job;
+        ++queue->next_job;
+    }
+    else
+        job = -1;
+
+    (void) pthread_mutex_unlock( &queue->mutex );
+
+    return( job );
+}
+
+static  void  *worker_thread(
+    void   *ptr )
+{
+    worker_struct     *worker;
+    job_queue_struct  *queue;
+    int               job;
+
+    worker = (worker_struct *) ptr;
+    queue = worker->queue;
+
+    while( (job = get_next_job( queue )) >= 0 )
+        (*queue->job_func)( queue->data, job, worker->thread_index );
+
+    return( NULL );
+}
+
+#endif
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : do_parallel_jobs
+@INPUT      : n_threads  - number of threads, or <= 0 for the default
+              n_jobs
+              job_func
+              data
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Calls job_func( data, job, thread ) once for each job in
+              0 .. n_jobs-1, distributing the jobs dynamically over a pool
+              of worker threads, and returns when all jobs are done.  The
+              thread argument is in the range 0 .. n_threads-1 and may be
+              used to index per-thread workspaces.  The jobs must be
+              independent of each other; the order in which they complete
+              is undefined.  If the threads cannot be created, the jobs are
+              run serially in the calling thread.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  do_parallel_jobs(
+    int                n_threads,
+    int                n_jobs,
+    parallel_job_func  job_func,
+    void               *data )
+{
+    int                job;
+#if HAVE_PTHREAD_H
+    int                t, n_started;
+    job_queue_struct   queue;
+    worker_struct      *workers;
+    pthread_t          *threads;
+#endif
+
+    if( n_jobs <= 0 )
+        return;
+
+    n_threads = get_n_threads_to_use( n_threads, n_jobs );
+
+#if HAVE_PTHREAD_H
+    if( n_threads > 1 )
+    {
+        queue.next_job = 0;
+        queue.n_jobs = n_jobs;
+        queue.job_func = job_func;
+        queue.data = data;
+        (void) pthread_mutex_init( &queue.mutex, NULL );
+
+        ALLOC( workers, n_threads );
+        ALLOC( threads, n_threads );
+
+        /*--- the calling thread acts as worker 0 */
+
+        n_started = 0;
+        for_less( t, 1, n_threads )
+        {
+            workers[t].queue = &queue;
+            workers[t].thread_index = t;
+
+            if( pthread_create( &threads[t], NULL, worker_thread,
+                                (void *) &workers[t] ) != 0 )
+                break;
+
+            ++n_started;
+        }
+
+        workers[0].queue = &queue;
+        workers[0].thread_index = 0;
+        (void) worker_thread( (void *) &workers[0] );
+
+        for_less( t, 1, n_started + 1 )
+            (void) pthread_join( threads[t], NULL );
+
+        (void) pthread_mutex_destroy( &queue.mutex );
+
+        FREE( threads );
+        FREE( workers );
+
+        return;
+    }
+#endif
+
+    for_less( job, 0, n_jobs )
+        (*job_func)( data, job, 0 );
+}
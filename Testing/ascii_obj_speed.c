@@ -0,0 +1,163 @@
+#include  <bicpl.h>
+
+/*--- Times writing and reading a file of objects in ascii format, with the
+      buffered ascii object routines and with the original token at a time
+      routines, and checks that both give the same file and objects. */
+
+static  BOOLEAN  same_objects(
+    object_struct  *a,
+    object_struct  *b )
+{
+    polygons_struct  *pa, *pb;
+    lines_struct     *la, *lb;
+    quadmesh_struct  *qa, *qb;
+
+    if( get_object_type( a ) != get_object_type( b ) )
+        return( FALSE );
+
+    switch( get_object_type( a ) )
+    {
+    case POLYGONS:
+        pa = get_polygons_ptr( a );
+        pb = get_polygons_ptr( b );
+        return( pa->n_points == pb->n_points && pa->n_items == pb->n_items &&
+                memcmp( pa->points, pb->points,
+                        (size_t) pa->n_points * sizeof(Point) ) == 0 &&
+                memcmp( pa->normals, pb->normals,
+                        (size_t) pa->n_points * sizeof(Vector) ) == 0 &&
+                memcmp( pa->end_indices, pb->end_indices,
+                        (size_t) pa->n_items * sizeof(int) ) == 0 &&
+                memcmp( pa->indices, pb->indices,
+                        (size_t) NUMBER_INDICES(*pa) * sizeof(int) ) == 0 );
+
+    case LINES:
+        la = get_lines_ptr( a );
+        lb = get_lines_ptr( b );
+        return( la->n_points == lb->n_points && la->n_items == lb->n_items &&
+                memcmp( la->points, lb->points,
+                        (size_t) la->n_points * sizeof(Point) ) == 0 &&
+                memcmp( la->end_indices, lb->end_indices,
+                        (size_t) la->n_items * sizeof(int) ) == 0 &&
+                memcmp( la->indices, lb->indices,
+                        (size_t) NUMBER_INDICES(*la) * sizeof(int) ) == 0 );
+
+    case QUADMESH:
+        qa = get_quadmesh_ptr( a );
+        qb = get_quadmesh_ptr( b );
+        return( qa->m == qb->m && qa->n == qb->n &&
+                memcmp( qa->points, qb->points,
+                        (size_t) (qa->m * qa->n) * sizeof(Point) ) == 0 );
+
+    default:
+        return( TRUE );
+    }
+}
+
+static  BOOLEAN  same_files(
+    STRING  filename1,
+    STRING  filename2 )
+{
+    FILE     *file1, *file2;
+    int      ch1, ch2;
+
+    file1 = fopen( filename1, "r" );
+    file2 = fopen( filename2, "r" );
+
+    if( file1 == NULL || file2 == NULL )
+        return( FALSE );
+
+    do
+    {
+        ch1 = getc( file1 );
+        ch2 = getc( file2 );
+    }
+    while( ch1 == ch2 && ch1 != EOF );
+
+    (void) fclose( file1 );
+    (void) fclose( file2 );
+
+    return( ch1 == ch2 );
+}
+
+int  main(
+    int   argc,
+    char  *argv[] )
+{
+    STRING           input_filename, output_prefix, filenames[2];
+    File_formats     format;
+    int              n_objects, n_read[2], i, fast, iter, n_iters;
+    object_struct    **objects, **read_objects[2];
+    Real             start, write_time[2], read_time[2];
+    BOOLEAN          same;
+
+    initialize_argument_processing( argc, argv );
+
+    if( !get_string_argument( NULL, &input_filename ) ||
+        !get_string_argument( NULL, &output_prefix ) )
+    {
+        print( "Usage: %s input.obj output_prefix [n_iters]\n", argv[0] );
+        return( 1 );
+    }
+
+    (void) get_int_argument( 3, &n_iters );
+
+    if( input_graphics_file( input_filename, &format, &n_objects,
+                             &objects ) != OK )
+        return( 1 );
+
+    for_less( fast, 0, 2 )
+    {
+        filenames[fast] = concat_strings( output_prefix,
+                                          fast ? "_fast.obj" : "_slow.obj" );
+
+        set_fast_ascii_object_io_flag( fast );
+
+        write_time[fast] = 0.0;
+        read_time[fast] = 0.0;
+
+        for_less( iter, 0, n_iters )
+        {
+            start = current_realtime_seconds();
+            if( output_graphics_file( filenames[fast], ASCII_FORMAT,
+                                      n_objects, objects ) != OK )
+                return( 1 );
+            write_time[fast] += current_realtime_seconds() - start;
+
+            start = current_realtime_seconds();
+            if( input_graphics_file( filenames[fast], &format, &n_read[fast],
+                                     &read_objects[fast] ) != OK )
+                return( 1 );
+            read_time[fast] += current_realtime_seconds() - start;
+
+            if( iter < n_iters - 1 )
+                delete_object_list( n_read[fast], read_objects[fast] );
+        }
+
+        print( "%s routines: write %g s, read %g s\n",
+               fast ? "Buffered" : "Original",
+               write_time[fast] / (Real) n_iters,
+               read_time[fast] / (Real) n_iters );
+    }
+
+    print( "Speedup: write %g, read %g\n",
+           write_time[0] / write_time[1], read_time[0] / read_time[1] );
+
+    same = same_files( filenames[0], filenames[1] ) &&
+           n_read[0] == n_read[1];
+
+    for_less( i, 0, n_read[0] )
+    {
+        if( same && !same_objects( read_objects[0][i], read_objects[1][i] ) )
+            same = FALSE;
+    }
+
+    print( "Files and objects %s\n", same ? "identical" : "DIFFER" );
+
+    delete_object_list( n_objects, objects );
+    delete_object_list( n_read[0], read_objects[0] );
+    delete_object_list( n_read[1], read_objects[1] );
+    delete_string( filenames[0] );
+    delete_string( filenames[1] );
+
+    return( same ? 0 : 1 );
+}
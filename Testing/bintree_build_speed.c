@@ -0,0 +1,87 @@
+#include  <bicpl.h>
+
+/*--- Times building the bintree of a polygons file with the original
+      bintree builder and with the bounding volume hierarchy builder, using
+      one thread and the default number of threads, and reports the
+      efficiency estimates of the resulting trees side by side. */
+
+#define  N_BUILDERS  3
+
+static  STRING  builder_names[N_BUILDERS] = { "Original bintree",
+                                              "BVH, 1 thread",
+                                              "BVH, default threads" };
+
+int  main(
+    int   argc,
+    char  *argv[] )
+{
+    STRING           input_filename;
+    File_formats     format;
+    int              n_objects, builder, iter, n_iters, max_nodes;
+    int              n_nodes[N_BUILDERS];
+    object_struct    **objects;
+    polygons_struct  *polygons;
+    Real             ratio, start, build_time[N_BUILDERS];
+    Real             avg_nodes[N_BUILDERS], avg_objects[N_BUILDERS];
+
+    initialize_argument_processing( argc, argv );
+
+    if( !get_string_argument( NULL, &input_filename ) )
+    {
+        print( "Usage: %s input.obj [max_nodes_ratio] [n_iters]\n", argv[0] );
+        return( 1 );
+    }
+
+    (void) get_real_argument( 0.3, &ratio );
+    (void) get_int_argument( 1, &n_iters );
+
+    if( input_graphics_file( input_filename, &format, &n_objects,
+                             &objects ) != OK ||
+        n_objects < 1 || get_object_type( objects[0] ) != POLYGONS )
+        return( 1 );
+
+    polygons = get_polygons_ptr( objects[0] );
+    max_nodes = ROUND( (Real) polygons->n_items * ratio );
+
+    print( "%d polygons, max nodes %d, %d threads\n", polygons->n_items,
+           max_nodes, get_default_n_threads() );
+
+    for_less( builder, 0, N_BUILDERS )
+    {
+        set_polygons_bvh_flag( builder > 0 );
+        set_default_n_threads( builder == 1 ? 1 : 0 );
+
+        build_time[builder] = 0.0;
+
+        for_less( iter, 0, n_iters )
+        {
+            delete_the_bintree( &polygons->bintree );
+
+            start = current_realtime_seconds();
+            create_polygons_bintree( polygons, max_nodes );
+            build_time[builder] += current_realtime_seconds() - start;
+        }
+
+        build_time[builder] /= (Real) n_iters;
+        n_nodes[builder] = polygons->bintree->n_nodes;
+        evaluate_bintree_efficiency( polygons->bintree, &avg_nodes[builder],
+                                     &avg_objects[builder] );
+    }
+
+    print( "%-22s %10s %10s %12s %12s\n", "Builder", "Time (s)", "Nodes",
+           "Avg nodes", "Avg objects" );
+
+    for_less( builder, 0, N_BUILDERS )
+    {
+        print( "%-22s %10.4f %10d %12.3f %12.3f\n", builder_names[builder],
+               build_time[builder], n_nodes[builder], avg_nodes[builder],
+               avg_objects[builder] );
+    }
+
+    print( "Speedup over original: %g (1 thread), %g (default threads)\n",
+           build_time[0] / build_time[1], build_time[0] / build_time[2] );
+
+    delete_object_list( n_objects, objects );
+
+    return( 0 );
+}
@@ -0,0 +1,198 @@
+#include  <bicpl.h>
+#include  <bicpl/deform.h>
+
+/*--- Traces rays through a synthetic volume with
+      find_boundary_in_direction(), with and without a min/max pyramid set
+      on the lookup, for degrees of continuity 0, 1 and 2, and for both an
+      isovalue and a range boundary.  The pyramid only rejects voxels,
+      and skips blocks of voxels, that cannot contain the boundary, so the
+      hits must be identical.
+      Reports the number of hits, the mismatches and the time taken, and
+      returns nonzero if any ray differs. */
+
+#define  N_DEGREES      3
+#define  N_BOUNDARIES   2
+
+static  void  create_test_volume(
+    int      size,
+    Volume   *volume )
+{
+    static  STRING  dim_names[] = { MIxspace, MIyspace, MIzspace };
+    int      x, y, z, sizes[N_DIMENSIONS];
+    Real     dx, dy, dz, r, value;
+
+    *volume = create_volume( N_DIMENSIONS, dim_names, NC_FLOAT, FALSE,
+                             0.0, 0.0 );
+
+    sizes[X] = size;
+    sizes[Y] = size;
+    sizes[Z] = size;
+    set_volume_sizes( *volume, sizes );
+    alloc_volume_data( *volume );
+
+    /*--- a bumpy ball of high values in a background of low values, with
+          large constant regions both inside and outside */
+
+    for_less( x, 0, size )
+    for_less( y, 0, size )
+    for_less( z, 0, size )
+    {
+        dx = (Real) x - 0.5 * (Real) size;
+        dy = (Real) y - 0.45 * (Real) size;
+        dz = (Real) z - 0.55 * (Real) size;
+        r = sqrt( dx * dx + dy * dy + dz * dz ) +
+            2.0 * sin( 0.3 * (Real) x ) * cos( 0.2 * (Real) z );
+
+        if( r < 0.2 * (Real) size )
+            value = 100.0;
+        else if( r > 0.35 * (Real) size )
+            value = 0.0;
+        else
+            value = 100.0 * (0.35 * (Real) size - r) / (0.15 * (Real) size);
+
+        set_volume_real_value( *volume, x, y, z, 0, 0, value );
+    }
+}
+
+static  int  trace_rays(
+    Volume                      volume,
+    minmax_pyramid_struct       *pyramid,
+    int                         degrees_continuity,
+    boundary_definition_struct  *boundary_def,
+    int                         n_rays,
+    BOOLEAN                     found[],
+    Real                        distances[],
+    Real                        *time_taken )
+{
+    int                 ray, sizes[N_DIMENSIONS], n_found;
+    Real                dist, start;
+    Point               origin;
+    Vector              pos_dir, neg_dir;
+    voxel_coef_struct   lookup;
+    bitlist_3d_struct   done_bits, surface_bits;
+
+    get_volume_sizes( volume, sizes );
+
+    initialize_lookup_volume_coeficients( &lookup );
+    set_lookup_minmax_pyramid( &lookup, pyramid );
+
+    create_bitlist_3d( sizes[X], sizes[Y], sizes[Z], &done_bits );
+    create_bitlist_3d( sizes[X], sizes[Y], sizes[Z], &surface_bits );
+
+    set_random_seed( 4321 );
+    n_found = 0;
+
+    start = current_realtime_seconds();
+
+    for_less( ray, 0, n_rays )
+    {
+        fill_Point( origin,
+                    get_random_0_to_1() * (Real) (sizes[X] - 1),
+                    get_random_0_to_1() * (Real) (sizes[Y] - 1),
+                    get_random_0_to_1() * (Real) (sizes[Z] - 1) );
+
+        fill_Vector( pos_dir, get_random_0_to_1() - 0.5,
+                              get_random_0_to_1() - 0.5,
+                              get_random_0_to_1() - 0.5 );
+        NORMALIZE_VECTOR( pos_dir, pos_dir );
+        SCALE_VECTOR( neg_dir, pos_dir, -1.0 );
+
+        dist = 0.0;
+        found[ray] = find_boundary_in_direction( volume, NULL, &lookup,
+                                  &done_bits, &surface_bits,
+                                  (get_random_0_to_1() - 0.5) * 10.0,
+                                  &origin, &pos_dir, &neg_dir,
+                                  (Real) sizes[X], (Real) sizes[X],
+                                  degrees_continuity, boundary_def, &dist );
+        distances[ray] = dist;
+
+        if( found[ray] )
+            ++n_found;
+    }
+
+    *time_taken = current_realtime_seconds() - start;
+
+    delete_bitlist_3d( &done_bits );
+    delete_bitlist_3d( &surface_bits );
+    delete_lookup_volume_coeficients( &lookup );
+
+    return( n_found );
+}
+
+int  main(
+    int   argc,
+    char  *argv[] )
+{
+    int                         size, n_rays, degrees, b, ray, n_found[2];
+    int                         n_mismatches, total_mismatches;
+    BOOLEAN                     *found[2];
+    Real                        *distances[2], times[2];
+    Volume                      volume;
+    minmax_pyramid_struct       pyramid;
+    boundary_definition_struct  boundary_def;
+
+    initialize_argument_processing( argc, argv );
+
+    (void) get_int_argument( 64, &size );
+    (void) get_int_argument( 5000, &n_rays );
+
+    create_test_volume( size, &volume );
+
+    if( !create_minmax_pyramid( &pyramid, volume, 0 ) )
+        return( 1 );
+
+    ALLOC( found[0], n_rays );
+    ALLOC( found[1], n_rays );
+    ALLOC( distances[0], n_rays );
+    ALLOC( distances[1], n_rays );
+
+    print( "%d^3 voxels, %d rays\n", size, n_rays );
+    print( "%-8s %-9s %8s %8s %10s %10s %10s\n", "Degrees", "Boundary",
+           "Hits", "Pyr hits", "Mismatch", "Time (s)", "Pyr (s)" );
+
+    total_mismatches = 0;
+
+    for_less( degrees, 0, N_DEGREES )
+    {
+        for_less( b, 0, N_BOUNDARIES )
+        {
+            if( b == 0 )
+                set_boundary_definition( &boundary_def, 50.0, 50.0,
+                                         0.0, 90.0, ' ', 1.0e-4 );
+            else
+                set_boundary_definition( &boundary_def, 40.0, 60.0,
+                                         0.0, 90.0, ' ', 1.0e-4 );
+
+            n_found[0] = trace_rays( volume, NULL, degrees, &boundary_def,
+                                     n_rays, found[0], distances[0],
+                                     &times[0] );
+            n_found[1] = trace_rays( volume, &pyramid, degrees, &boundary_def,
+                                     n_rays, found[1], distances[1],
+                                     &times[1] );
+
+            n_mismatches = 0;
+            for_less( ray, 0, n_rays )
+            {
+                if( found[0][ray] != found[1][ray] ||
+                    (found[0][ray] &&
+                     FABS( distances[0][ray] - distances[1][ray] ) > 1.0e-6) )
+                    ++n_mismatches;
+            }
+
+            print( "%-8d %-9s %8d %8d %10d %10.4f %10.4f\n", degrees,
+                   b == 0 ? "Isovalue" : "Range", n_found[0], n_found[1],
+                   n_mismatches, times[0], times[1] );
+
+            total_mismatches += n_mismatches;
+        }
+    }
+
+    FREE( found[0] );
+    FREE( found[1] );
+    FREE( distances[0] );
+    FREE( distances[1] );
+    delete_minmax_pyramid( &pyramid );
+    delete_volume( volume );
+
+    return( total_mismatches == 0 ? 0 : 1 );
+}
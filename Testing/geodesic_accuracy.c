@@ -0,0 +1,173 @@
+#include  <bicpl.h>
+
+/*--- Compares the graph distances of compute_distances_from_point() and
+      the fast marching distances of
+      compute_fast_marching_distances_from_point() with the exact great
+      circle distances on unit spheres made by subdividing the platonic
+      solids, reporting the mean and maximum relative errors and the
+      time taken. */
+
+#define  N_SOLIDS   3
+
+static  STRING  solid_names[N_SOLIDS] = { "Tetrahedron",
+                                          "Octahedron",
+                                          "Icosahedron" };
+
+static  void  create_platonic_sphere(
+    int               solid,
+    int               n_subdivisions,
+    polygons_struct   *polygons )
+{
+    int    i, s;
+    Real   len;
+
+    switch( solid )
+    {
+    case 0:  create_unit_tetrahedron( polygons );  break;
+    case 1:  create_unit_octohedron( polygons );   break;
+    default: create_unit_icosahedron( polygons );  break;
+    }
+
+    for_less( s, 0, n_subdivisions )
+    {
+        subdivide_polygons( polygons );
+
+        for_less( i, 0, polygons->n_points )
+        {
+            len = sqrt( DOT_POINTS( polygons->points[i],
+                                    polygons->points[i] ) );
+            SCALE_POINT( polygons->points[i], polygons->points[i],
+                         1.0 / len );
+        }
+    }
+}
+
+/*--- accumulates the relative errors of the distances of the points
+      found, and resets their distances */
+
+static  void  accumulate_errors(
+    polygons_struct   *polygons,
+    int               source,
+    int               n_found,
+    int               list[],
+    float             distances[],
+    Real              *sum_error,
+    Real              *max_error,
+    int               *n_errors )
+{
+    int      i, p;
+    Real     exact, error;
+    Vector   v1, v2, cross;
+
+    CONVERT_POINT_TO_VECTOR( v1, polygons->points[source] );
+
+    for_less( i, 0, n_found )
+    {
+        p = list[i];
+
+        CONVERT_POINT_TO_VECTOR( v2, polygons->points[p] );
+        CROSS_VECTORS( cross, v1, v2 );
+        exact = atan2( MAGNITUDE( cross ), DOT_VECTORS( v1, v2 ) );
+
+        if( exact > 1.0e-6 )
+        {
+            error = FABS( (Real) distances[p] - exact ) / exact;
+            *sum_error += error;
+            *max_error = MAX( *max_error, error );
+            ++(*n_errors);
+        }
+
+        distances[p] = -1.0f;
+    }
+}
+
+int  main(
+    int   argc,
+    char  *argv[] )
+{
+    int              solid, n_subdivisions, n_sources, s, source, poly;
+    int              vertex, n_found, method, n_errors[2], *list;
+    int              *n_neighbours, **neighbours;
+    float            *distances;
+    Real             max_distance, start, times[2];
+    Real             sum_error[2], max_error[2];
+    polygons_struct  polygons;
+
+    initialize_argument_processing( argc, argv );
+
+    (void) get_int_argument( 5, &n_subdivisions );
+    (void) get_real_argument( 1.0, &max_distance );
+    (void) get_int_argument( 20, &n_sources );
+
+    print( "%d subdivisions, max distance %g, %d sources\n", n_subdivisions,
+           max_distance, n_sources );
+    print( "%-12s %8s  %-14s %10s %10s %10s\n", "Solid", "Points", "Method",
+           "Mean err", "Max err", "Time (s)" );
+
+    for_less( solid, 0, N_SOLIDS )
+    {
+        create_platonic_sphere( solid, n_subdivisions, &polygons );
+
+        create_polygon_point_neighbours( &polygons, FALSE, &n_neighbours,
+                                         &neighbours, NULL, NULL );
+        check_polygons_topology_computed( &polygons );
+
+        ALLOC( distances, polygons.n_points );
+        for_less( s, 0, polygons.n_points )
+            distances[s] = -1.0f;
+
+        for_less( method, 0, 2 )
+        {
+            sum_error[method] = 0.0;
+            max_error[method] = 0.0;
+            n_errors[method] = 0;
+            times[method] = 0.0;
+
+            for_less( s, 0, n_sources )
+            {
+                source = (int) ((long) s * 7919 % polygons.n_points);
+                (void) find_polygon_with_vertex( &polygons, source, &poly,
+                                                 &vertex );
+
+                start = current_realtime_seconds();
+
+                if( method == 0 )
+                {
+                    n_found = compute_distances_from_point( &polygons,
+                                      n_neighbours, neighbours,
+                                      &polygons.points[source], poly,
+                                      max_distance, TRUE, distances, &list );
+                }
+                else
+                {
+                    n_found = compute_fast_marching_distances_from_point(
+                                      &polygons, &polygons.points[source],
+                                      poly, max_distance, TRUE, distances,
+                                      &list );
+                }
+
+                times[method] += current_realtime_seconds() - start;
+
+                accumulate_errors( &polygons, source, n_found, list,
+                                   distances, &sum_error[method],
+                                   &max_error[method], &n_errors[method] );
+
+                if( n_found > 0 )
+                    FREE( list );
+            }
+
+            print( "%-12s %8d  %-14s %10.5f %10.5f %10.4f\n",
+                   solid_names[solid], polygons.n_points,
+                   method == 0 ? "Graph" : "Fast marching",
+                   sum_error[method] / (Real) MAX( 1, n_errors[method] ),
+                   max_error[method], times[method] );
+        }
+
+        FREE( distances );
+        delete_polygon_point_neighbours( &polygons, n_neighbours, neighbours,
+                                         NULL, NULL );
+        delete_polygons( &polygons );
+    }
+
+    return( 0 );
+}
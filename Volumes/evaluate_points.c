@@ -0,0 +1,784 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#include  "bicpl_internal.h"
+#include  <bicpl/splines.h>
+
+/*--- points are processed in blocks of this size, so the per-block
+      scratch arrays stay in the first level cache */
+
+#define  EVALUATION_BLOCK_SIZE   64
+
+/*--- expands the macro for the C type corresponding to data_type */
+
+#define  SWITCH_ON_DATA_TYPE( data_type, MACRO ) \
+         switch( data_type ) \
+         { \
+         case UNSIGNED_BYTE:   MACRO( unsigned char );   break; \
+         case SIGNED_BYTE:     MACRO( signed char );     break; \
+         case UNSIGNED_SHORT:  MACRO( unsigned short );  break; \
+         case SIGNED_SHORT:    MACRO( signed short );    break; \
+         case UNSIGNED_INT:    MACRO( unsigned int );    break; \
+         case SIGNED_INT:      MACRO( signed int );      break; \
+         case FLOAT:           MACRO( float );           break; \
+         case DOUBLE:          MACRO( double );          break; \
+         default:                                        break; \
+         }
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : initialize_volume_evaluator
+@INPUT      : volume
+              degrees_continuity - -1 = nearest, 0 = linear, 1 = quadratic,
+                                    2 = cubic
+              outside_value      - value of points outside the volume
+@OUTPUT     : evaluator
+@RETURNS    :
+@DESCRIPTION: Prepares to evaluate a 3D volume at many points with
+              evaluate_volume_at_points().  The world-to-voxel mapping and
+              the layout of the voxel array are looked up once here rather
+              than once per point.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  initialize_volume_evaluator(
+    volume_evaluator_struct  *evaluator,
+    Volume                   volume,
+    int                      degrees_continuity,
+    Real                     outside_value )
+{
+    int                dim, sizes[MAX_DIMENSIONS];
+    Data_types         type;
+    General_transform  *voxel_to_world;
+    Transform          *world_to_voxel;
+
+    evaluator->volume = volume;
+    evaluator->degrees_continuity = degrees_continuity;
+    evaluator->outside_value = outside_value;
+
+    voxel_to_world = get_voxel_to_world_transform( volume );
+    evaluator->linear_world_to_voxel =
+                        get_transform_type( voxel_to_world ) == LINEAR;
+
+    if( evaluator->linear_world_to_voxel )
+    {
+        world_to_voxel = get_inverse_linear_transform_ptr( voxel_to_world );
+
+        for_less( dim, 0, N_DIMENSIONS )
+        {
+            evaluator->world_to_voxel[dim][0] =
+                                Transform_elem( *world_to_voxel, dim, 0 );
+            evaluator->world_to_voxel[dim][1] =
+                                Transform_elem( *world_to_voxel, dim, 1 );
+            evaluator->world_to_voxel[dim][2] =
+                                Transform_elem( *world_to_voxel, dim, 2 );
+            evaluator->world_to_voxel[dim][3] =
+                                Transform_elem( *world_to_voxel, dim, 3 );
+        }
+    }
+
+    type = get_volume_data_type( volume );
+
+    evaluator->direct_access = get_volume_n_dimensions( volume ) ==
+                                                           N_DIMENSIONS &&
+                               !volume->is_cached_volume &&
+                               !is_an_rgb_volume( volume ) &&
+                               type != NO_DATA_TYPE &&
+                               type != MAX_DATA_TYPE &&
+                               (degrees_continuity == -1 ||
+                                degrees_continuity == 0 ||
+                                degrees_continuity == 2);
+
+    if( !evaluator->direct_access )
+        return;
+
+    evaluator->data_type = type;
+    GET_VOXEL_PTR( evaluator->data, volume, 0, 0, 0, 0, 0 );
+
+    get_volume_sizes( volume, sizes );
+
+    evaluator->strides[N_DIMENSIONS-1] = 1;
+    for_down( dim, N_DIMENSIONS-2, 0 )
+        evaluator->strides[dim] = evaluator->strides[dim+1] *
+                                  (size_t) sizes[dim+1];
+
+    for_less( dim, 0, N_DIMENSIONS )
+        evaluator->sizes[dim] = sizes[dim];
+
+    evaluator->value_translation = convert_voxel_to_value( volume, 0.0 );
+    evaluator->value_scale = convert_voxel_to_value( volume, 1.0 ) -
+                             evaluator->value_translation;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : delete_volume_evaluator
+@INPUT      : evaluator
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Frees anything allocated by initialize_volume_evaluator().
+              The volume itself is not deleted.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  delete_volume_evaluator(
+    volume_evaluator_struct  *evaluator )
+{
+    evaluator->volume = NULL;
+}
+
+/*--- the interpolation macros below expect, in the enclosing scope, the
+      block arrays, the strides s0, s1, s2 and the flags want_derivs and
+      want_second_derivs.  Derivatives are in voxel units. */
+
+#define  NEAREST_POINTS( type ) \
+         { \
+             const type  *data = (const type *) evaluator->data; \
+ \
+             for_less( p, 0, n ) \
+             { \
+                 if( inside[p] ) \
+                     val[p] = (Real) data[offsets[p]]; \
+             } \
+         }
+
+#define  TRILINEAR_POINTS( type ) \
+         { \
+             const type  *data = (const type *) evaluator->data; \
+             const type  *ptr; \
+             Real        c000, c001, c010, c011, c100, c101, c110, c111; \
+             Real        c00, c01, c10, c11, c0, c1; \
+             Real        d00, d01, d10, d11, d0, d1, e0, e1; \
+ \
+             for_less( p, 0, n ) \
+             { \
+                 if( !inside[p] ) \
+                     continue; \
+ \
+                 ptr = &data[offsets[p]]; \
+                 c000 = (Real) ptr[0]; \
+                 c001 = (Real) ptr[s2]; \
+                 c010 = (Real) ptr[s1]; \
+                 c011 = (Real) ptr[s1+s2]; \
+                 c100 = (Real) ptr[s0]; \
+                 c101 = (Real) ptr[s0+s2]; \
+                 c110 = (Real) ptr[s0+s1]; \
+                 c111 = (Real) ptr[s0+s1+s2]; \
+ \
+                 d00 = c001 - c000; \
+                 d01 = c011 - c010; \
+                 d10 = c101 - c100; \
+                 d11 = c111 - c110; \
+                 c00 = c000 + w[p] * d00; \
+                 c01 = c010 + w[p] * d01; \
+                 c10 = c100 + w[p] * d10; \
+                 c11 = c110 + w[p] * d11; \
+                 c0 = c00 + v[p] * (c01 - c00); \
+                 c1 = c10 + v[p] * (c11 - c10); \
+                 val[p] = c0 + u[p] * (c1 - c0); \
+ \
+                 if( want_derivs || want_second_derivs ) \
+                 { \
+                     d0 = d00 + v[p] * (d01 - d00); \
+                     d1 = d10 + v[p] * (d11 - d10); \
+                     e0 = c01 - c00; \
+                     e1 = c11 - c10; \
+                     dx[p] = c1 - c0; \
+                     dy[p] = e0 + u[p] * (e1 - e0); \
+                     dz[p] = d0 + u[p] * (d1 - d0); \
+                     dxx[p] = 0.0; \
+                     dyy[p] = 0.0; \
+                     dzz[p] = 0.0; \
+                     dxy[p] = e1 - e0; \
+                     dxz[p] = d1 - d0; \
+                     dyz[p] = (d01 - d00) + u[p] * ((d11 - d10) - \
+                                                    (d01 - d00)); \
+                 } \
+             } \
+         }
+
+#define  TRICUBIC_POINTS( type ) \
+         { \
+             const type  *data = (const type *) evaluator->data; \
+             const type  *ptr, *row_ptr, *col_ptr; \
+             Real        wu[4], wv[4], ww[4]; \
+             Real        du[4], dv[4], dw[4]; \
+             Real        ddu[4], ddv[4], ddw[4]; \
+             Real        c, f, fw, fdw, fddw; \
+             Real        g, gv, gdv, gddv, gwv, gdwv, gwdv; \
+             int         i, j, k; \
+ \
+             for_less( p, 0, n ) \
+             { \
+                 if( !inside[p] ) \
+                     continue; \
+ \
+                 COMPUTE_CUBIC_COEFFS( u[p], wu[0], wu[1], wu[2], wu[3] ); \
+                 COMPUTE_CUBIC_COEFFS( v[p], wv[0], wv[1], wv[2], wv[3] ); \
+                 COMPUTE_CUBIC_COEFFS( w[p], ww[0], ww[1], ww[2], ww[3] ); \
+ \
+                 ptr = &data[offsets[p]]; \
+ \
+                 if( !want_derivs && !want_second_derivs ) \
+                 { \
+                     f = 0.0; \
+                     for_less( i, 0, 4 ) \
+                     { \
+                         row_ptr = ptr + (size_t) i * s0; \
+                         g = 0.0; \
+                         for_less( j, 0, 4 ) \
+                         { \
+                             col_ptr = row_ptr + (size_t) j * s1; \
+                             g += wv[j] * (ww[0] * (Real) col_ptr[0] + \
+                                           ww[1] * (Real) col_ptr[s2] + \
+                                           ww[2] * (Real) col_ptr[2*s2] + \
+                                           ww[3] * (Real) col_ptr[3*s2]); \
+                         } \
+                         f += wu[i] * g; \
+                     } \
+                     val[p] = f; \
+                     continue; \
+                 } \
+ \
+                 COMPUTE_CUBIC_DERIV_COEFFS( u[p], du[0], du[1], du[2], du[3] ); \
+                 COMPUTE_CUBIC_DERIV_COEFFS( v[p], dv[0], dv[1], dv[2], dv[3] ); \
+                 COMPUTE_CUBIC_DERIV_COEFFS( w[p], dw[0], dw[1], dw[2], dw[3] ); \
+                 COMPUTE_CUBIC_DERIV2_COEFFS( u[p], ddu[0], ddu[1], ddu[2], \
+                                              ddu[3] ); \
+                 COMPUTE_CUBIC_DERIV2_COEFFS( v[p], ddv[0], ddv[1], ddv[2], \
+                                              ddv[3] ); \
+                 COMPUTE_CUBIC_DERIV2_COEFFS( w[p], ddw[0], ddw[1], ddw[2], \
+                                              ddw[3] ); \
+ \
+                 val[p] = dx[p] = dy[p] = dz[p] = 0.0; \
+                 dxx[p] = dxy[p] = dxz[p] = dyy[p] = dyz[p] = dzz[p] = 0.0; \
+ \
+                 for_less( i, 0, 4 ) \
+                 { \
+                     row_ptr = ptr + (size_t) i * s0; \
+                     gv = gdv = gddv = gwv = gdwv = gwdv = 0.0; \
+                     for_less( j, 0, 4 ) \
+                     { \
+                         col_ptr = row_ptr + (size_t) j * s1; \
+                         fw = fdw = fddw = 0.0; \
+                         for_less( k, 0, 4 ) \
+                         { \
+                             c = (Real) col_ptr[(size_t) k * s2]; \
+                             fw += ww[k] * c; \
+                             fdw += dw[k] * c; \
+                             fddw += ddw[k] * c; \
+                         } \
+                         gv += wv[j] * fw; \
+                         gdv += dv[j] * fw; \
+                         gddv += ddv[j] * fw; \
+                         gwv += wv[j] * fdw; \
+                         gdwv += dv[j] * fdw; \
+                         gwdv += wv[j] * fddw; \
+                     } \
+                     val[p] += wu[i] * gv; \
+                     dx[p] += du[i] * gv; \
+                     dy[p] += wu[i] * gdv; \
+                     dz[p] += wu[i] * gwv; \
+                     dxx[p] += ddu[i] * gv; \
+                     dxy[p] += du[i] * gdv; \
+                     dxz[p] += du[i] * gwv; \
+                     dyy[p] += wu[i] * gddv; \
+                     dyz[p] += wu[i] * gdwv; \
+                     dzz[p] += wu[i] * gwdv; \
+                 } \
+             } \
+         }
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : evaluate_point_generically
+@INPUT      : evaluator
+              world_coordinates
+              x
+              y
+              z
+@OUTPUT     : value
+              derivs         - 3 values, or NULL
+              second_derivs  - 6 values, or NULL
+@RETURNS    :
+@DESCRIPTION: Evaluates one point through the volume_io routines, for points
+              near the border or volumes that cannot be accessed directly.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  evaluate_point_generically(
+    volume_evaluator_struct  *evaluator,
+    BOOLEAN                  world_coordinates,
+    Real                     x,
+    Real                     y,
+    Real                     z,
+    Real                     *value,
+    Real                     derivs[],
+    Real                     second_derivs[] )
+{
+    int      i, j, k;
+    Real     voxel[MAX_DIMENSIONS];
+    Real     voxel_derivs[MAX_DIMENSIONS], *deriv_ptr[1];
+    Real     voxel_second[MAX_DIMENSIONS][MAX_DIMENSIONS];
+    Real     *second_rows[MAX_DIMENSIONS], **second_ptr[1];
+
+    if( world_coordinates )
+    {
+        if( derivs == NULL && second_derivs == NULL )
+        {
+            evaluate_volume_in_world( evaluator->volume, x, y, z,
+                         evaluator->degrees_continuity, FALSE,
+                         evaluator->outside_value, value,
+                         NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL );
+        }
+        else if( second_derivs == NULL )
+        {
+            evaluate_volume_in_world( evaluator->volume, x, y, z,
+                         evaluator->degrees_continuity, FALSE,
+                         evaluator->outside_value, value,
+                         &derivs[X], &derivs[Y], &derivs[Z],
+                         NULL, NULL, NULL, NULL, NULL, NULL );
+        }
+        else
+        {
+            evaluate_volume_in_world( evaluator->volume, x, y, z,
+                         evaluator->degrees_continuity, FALSE,
+                         evaluator->outside_value, value,
+                         &voxel_derivs[X], &voxel_derivs[Y], &voxel_derivs[Z],
+                         &second_derivs[0], &second_derivs[1],
+                         &second_derivs[2], &second_derivs[3],
+                         &second_derivs[4], &second_derivs[5] );
+
+            if( derivs != NULL )
+            {
+                for_less( i, 0, N_DIMENSIONS )
+                    derivs[i] = voxel_derivs[i];
+            }
+        }
+        return;
+    }
+
+    voxel[X] = x;
+    voxel[Y] = y;
+    voxel[Z] = z;
+
+    deriv_ptr[0] = voxel_derivs;
+    for_less( i, 0, N_DIMENSIONS )
+        second_rows[i] = voxel_second[i];
+    second_ptr[0] = second_rows;
+
+    evaluate_volume( evaluator->volume, voxel, NULL,
+                     evaluator->degrees_continuity, FALSE,
+                     evaluator->outside_value, value,
+                     (derivs != NULL || second_derivs != NULL) ?
+                                                deriv_ptr : NULL,
+                     (second_derivs != NULL) ? second_ptr : NULL );
+
+    if( derivs != NULL )
+    {
+        for_less( i, 0, N_DIMENSIONS )
+            derivs[i] = voxel_derivs[i];
+    }
+
+    if( second_derivs != NULL )
+    {
+        k = 0;
+        for_less( i, 0, N_DIMENSIONS )
+        for_less( j, i, N_DIMENSIONS )
+        {
+            second_derivs[k] = voxel_second[i][j];
+            ++k;
+        }
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : evaluate_block_directly
+@INPUT      : evaluator
+              n                  - number of points, at most the block size
+              vx, vy, vz         - voxel coordinates
+              want_derivs
+              want_second_derivs
+@OUTPUT     : val, dx, dy, dz, dxx, dxy, dxz, dyy, dyz, dzz
+              inside             - whether each point was evaluated
+@RETURNS    :
+@DESCRIPTION: Interpolates the points of a block whose interpolation stencil
+              lies inside the volume, reading the voxel array directly.
+              Values and derivatives are returned in real value units, but
+              the derivatives are with respect to voxel coordinates.
+@METHOD     : The stencil corners and fractions of the whole block are
+              computed first, then a loop specialized for the data type
+              interpolates them.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  evaluate_block_directly(
+    volume_evaluator_struct  *evaluator,
+    int                      n,
+    Real                     vx[],
+    Real                     vy[],
+    Real                     vz[],
+    BOOLEAN                  want_derivs,
+    BOOLEAN                  want_second_derivs,
+    Real                     val[],
+    Real                     dx[],
+    Real                     dy[],
+    Real                     dz[],
+    Real                     dxx[],
+    Real                     dxy[],
+    Real                     dxz[],
+    Real                     dyy[],
+    Real                     dyz[],
+    Real                     dzz[],
+    BOOLEAN                  inside[] )
+{
+    int      p, dim, degrees, low_limit, index;
+    Real     pos, low[N_DIMENSIONS], high[N_DIMENSIONS], scale;
+    Real     *coords[N_DIMENSIONS], *fracs[N_DIMENSIONS];
+    Real     u[EVALUATION_BLOCK_SIZE];
+    Real     v[EVALUATION_BLOCK_SIZE];
+    Real     w[EVALUATION_BLOCK_SIZE];
+    size_t   s0, s1, s2, offsets[EVALUATION_BLOCK_SIZE];
+
+    degrees = evaluator->degrees_continuity;
+    s0 = evaluator->strides[X];
+    s1 = evaluator->strides[Y];
+    s2 = evaluator->strides[Z];
+
+    coords[X] = vx;
+    coords[Y] = vy;
+    coords[Z] = vz;
+    fracs[X] = u;
+    fracs[Y] = v;
+    fracs[Z] = w;
+
+    /*--- the range of positions whose whole stencil is in the volume */
+
+    low_limit = (degrees == 2) ? 1 : 0;
+
+    for_less( dim, 0, N_DIMENSIONS )
+    {
+        if( degrees == -1 )
+        {
+            low[dim] = -0.5;
+            high[dim] = (Real) evaluator->sizes[dim] - 0.5;
+        }
+        else
+        {
+            low[dim] = (Real) low_limit;
+            high[dim] = (Real) (evaluator->sizes[dim] - 1 - low_limit);
+        }
+    }
+
+    for_less( p, 0, n )
+    {
+        inside[p] = TRUE;
+        offsets[p] = 0;
+    }
+
+    for_less( dim, 0, N_DIMENSIONS )
+    {
+        for_less( p, 0, n )
+        {
+            pos = coords[dim][p];
+
+            if( pos < low[dim] || pos >= high[dim] )
+            {
+                inside[p] = FALSE;
+                fracs[dim][p] = 0.0;
+                continue;
+            }
+
+            if( degrees == -1 )
+            {
+                index = FLOOR( pos + 0.5 );
+                fracs[dim][p] = 0.0;
+            }
+            else
+            {
+                index = FLOOR( pos );
+                fracs[dim][p] = pos - (Real) index;
+                index -= low_limit;
+            }
+
+            offsets[p] += (size_t) index * evaluator->strides[dim];
+        }
+    }
+
+    switch( degrees )
+    {
+    case -1:
+        SWITCH_ON_DATA_TYPE( evaluator->data_type, NEAREST_POINTS )
+
+        if( want_derivs || want_second_derivs )
+        {
+            for_less( p, 0, n )
+            {
+                dx[p] = dy[p] = dz[p] = 0.0;
+                dxx[p] = dxy[p] = dxz[p] = dyy[p] = dyz[p] = dzz[p] = 0.0;
+            }
+        }
+        break;
+
+    case 0:
+        SWITCH_ON_DATA_TYPE( evaluator->data_type, TRILINEAR_POINTS )
+        break;
+
+    case 2:
+        SWITCH_ON_DATA_TYPE( evaluator->data_type, TRICUBIC_POINTS )
+        break;
+    }
+
+    /*--- from voxel values to real values */
+
+    scale = evaluator->value_scale;
+
+    for_less( p, 0, n )
+        val[p] = scale * val[p] + evaluator->value_translation;
+
+    if( want_derivs || want_second_derivs )
+    {
+        for_less( p, 0, n )
+        {
+            dx[p] *= scale;
+            dy[p] *= scale;
+            dz[p] *= scale;
+            dxx[p] *= scale;
+            dxy[p] *= scale;
+            dxz[p] *= scale;
+            dyy[p] *= scale;
+            dyz[p] *= scale;
+            dzz[p] *= scale;
+        }
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : evaluate_volume_at_points
+@INPUT      : evaluator
+              n_points
+              x, y, z             - coordinates of the points
+              world_coordinates   - TRUE if x,y,z are world coordinates,
+                                    FALSE if they are voxel coordinates
+@OUTPUT     : values
+              derivs              - NULL, or 3 arrays of n_points values
+                                    receiving d/dx, d/dy, d/dz
+              second_derivs       - NULL, or 6 arrays of n_points values
+                                    receiving the xx, xy, xz, yy, yz and zz
+                                    second derivatives
+@RETURNS    :
+@DESCRIPTION: Evaluates the volume at an array of points, equivalent to
+              calling evaluate_volume_in_world() or evaluate_volume() on
+              each point in turn.  Derivatives are with respect to the
+              same coordinate system as the points.  Points whose
+              interpolation stencil lies inside an in-memory volume are
+              interpolated directly from the voxel array, block by block;
+              other points go through volume_io.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  evaluate_volume_at_points(
+    volume_evaluator_struct  *evaluator,
+    int                      n_points,
+    Real                     x[],
+    Real                     y[],
+    Real                     z[],
+    BOOLEAN                  world_coordinates,
+    Real                     values[],
+    Real                     *derivs[],
+    Real                     *second_derivs[] )
+{
+    int       start, n, p, i, j, k, c, index, dim;
+    BOOLEAN   want_derivs, want_second_derivs, transform_linearly;
+    BOOLEAN   inside[EVALUATION_BLOCK_SIZE];
+    Real      (*m)[4], d[N_DIMENSIONS], h[N_DIMENSIONS][N_DIMENSIONS];
+    Real      hm[N_DIMENSIONS][N_DIMENSIONS], sum;
+    Real      point_derivs[N_DIMENSIONS], point_second[6];
+    Real      vx[EVALUATION_BLOCK_SIZE];
+    Real      vy[EVALUATION_BLOCK_SIZE];
+    Real      vz[EVALUATION_BLOCK_SIZE];
+    Real      dx[EVALUATION_BLOCK_SIZE];
+    Real      dy[EVALUATION_BLOCK_SIZE];
+    Real      dz[EVALUATION_BLOCK_SIZE];
+    Real      second[6][EVALUATION_BLOCK_SIZE];
+    Real      *block_derivs[N_DIMENSIONS];
+
+    want_derivs = (derivs != NULL);
+    want_second_derivs = (second_derivs != NULL);
+
+    if( !evaluator->direct_access ||
+        (world_coordinates && !evaluator->linear_world_to_voxel) )
+    {
+        for_less( p, 0, n_points )
+        {
+            evaluate_point_generically( evaluator, world_coordinates,
+                                        x[p], y[p], z[p], &values[p],
+                                        want_derivs ? point_derivs : NULL,
+                                        want_second_derivs ? point_second :
+                                                             NULL );
+            if( want_derivs )
+            {
+                for_less( dim, 0, N_DIMENSIONS )
+                    derivs[dim][p] = point_derivs[dim];
+            }
+            if( want_second_derivs )
+            {
+                for_less( k, 0, 6 )
+                    second_derivs[k][p] = point_second[k];
+            }
+        }
+        return;
+    }
+
+    transform_linearly = world_coordinates;
+    m = evaluator->world_to_voxel;
+
+    block_derivs[X] = dx;
+    block_derivs[Y] = dy;
+    block_derivs[Z] = dz;
+
+    for( start = 0;  start < n_points;  start += EVALUATION_BLOCK_SIZE )
+    {
+        n = MIN( EVALUATION_BLOCK_SIZE, n_points - start );
+
+        if( transform_linearly )
+        {
+            for_less( p, 0, n )
+            {
+                index = start + p;
+                vx[p] = m[X][0] * x[index] + m[X][1] * y[index] +
+                        m[X][2] * z[index] + m[X][3];
+                vy[p] = m[Y][0] * x[index] + m[Y][1] * y[index] +
+                        m[Y][2] * z[index] + m[Y][3];
+                vz[p] = m[Z][0] * x[index] + m[Z][1] * y[index] +
+                        m[Z][2] * z[index] + m[Z][3];
+            }
+        }
+        else
+        {
+            for_less( p, 0, n )
+            {
+                vx[p] = x[start+p];
+                vy[p] = y[start+p];
+                vz[p] = z[start+p];
+            }
+        }
+
+        evaluate_block_directly( evaluator, n, vx, vy, vz,
+                                 want_derivs, want_second_derivs,
+                                 &values[start], dx, dy, dz,
+                                 second[0], second[1], second[2],
+                                 second[3], second[4], second[5], inside );
+
+        /*--- chain rule from voxel to world derivatives: with
+              voxel = M world + t, grad_w = M^T grad_v and
+              hessian_w = M^T hessian_v M */
+
+        if( world_coordinates && (want_derivs || want_second_derivs) )
+        {
+            for_less( p, 0, n )
+            {
+                if( !inside[p] )
+                    continue;
+
+                d[X] = dx[p];
+                d[Y] = dy[p];
+                d[Z] = dz[p];
+
+                for_less( i, 0, N_DIMENSIONS )
+                {
+                    block_derivs[i][p] = m[X][i] * d[X] + m[Y][i] * d[Y] +
+                                         m[Z][i] * d[Z];
+                }
+
+                if( !want_second_derivs )
+                    continue;
+
+                h[X][X] = second[0][p];
+                h[X][Y] = h[Y][X] = second[1][p];
+                h[X][Z] = h[Z][X] = second[2][p];
+                h[Y][Y] = second[3][p];
+                h[Y][Z] = h[Z][Y] = second[4][p];
+                h[Z][Z] = second[5][p];
+
+                for_less( i, 0, N_DIMENSIONS )
+                for_less( j, 0, N_DIMENSIONS )
+                {
+                    hm[i][j] = h[i][X] * m[X][j] + h[i][Y] * m[Y][j] +
+                               h[i][Z] * m[Z][j];
+                }
+
+                k = 0;
+                for_less( i, 0, N_DIMENSIONS )
+                for_less( j, i, N_DIMENSIONS )
+                {
+                    sum = 0.0;
+                    for_less( c, 0, N_DIMENSIONS )
+                        sum += m[c][i] * hm[c][j];
+                    second[k][p] = sum;
+                    ++k;
+                }
+            }
+        }
+
+        for_less( p, 0, n )
+        {
+            index = start + p;
+
+            if( !inside[p] )
+            {
+                evaluate_point_generically( evaluator, world_coordinates,
+                                        x[index], y[index], z[index],
+                                        &values[index],
+                                        want_derivs ? point_derivs : NULL,
+                                        want_second_derivs ? point_second :
+                                                             NULL );
+            }
+
+            if( want_derivs )
+            {
+                for_less( dim, 0, N_DIMENSIONS )
+                {
+                    derivs[dim][index] = inside[p] ? block_derivs[dim][p] :
+                                                     point_derivs[dim];
+                }
+            }
+
+            if( want_second_derivs )
+            {
+                for_less( k, 0, 6 )
+                {
+                    second_derivs[k][index] = inside[p] ? second[k][p] :
+                                                          point_second[k];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,479 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#include  "bicpl_internal.h"
+
+#define  DEFAULT_PYRAMID_BLOCK_SIZE   8
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : create_minmax_pyramid
+@INPUT      : volume
+              block_size  - voxels per block side, or <= 0 for the default
+@OUTPUT     : pyramid
+@RETURNS    : TRUE if successful
+@DESCRIPTION: Computes the range of real values in blocks of the volume, and
+              in successively coarser blocks of 2 by 2 by 2 of those, up to
+              a single block.  Level 0 block (i,j,k) covers voxels
+              i*block_size to (i+1)*block_size inclusive along the first
+              axis, and likewise along the others, so adjacent blocks share
+              a slice of voxels and any cube of 8 voxels lies entirely in
+              one block.  The pyramid must be recreated if the volume
+              changes.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  create_minmax_pyramid(
+    minmax_pyramid_struct  *pyramid,
+    Volume                 volume,
+    int                    block_size )
+{
+    int      dim, level, x, y, z, bx, by, bz, cx, cy, cz, sizes[MAX_DIMENSIONS];
+    int      b_start[N_DIMENSIONS], b_end[N_DIMENSIONS], *n_blocks, *n_sub;
+    size_t   block, sub_block;
+    Real     value, *slice;
+    BOOLEAN  done;
+
+    if( get_volume_n_dimensions( volume ) != N_DIMENSIONS )
+    {
+        print_error( "create_minmax_pyramid: volume must be 3D.\n" );
+        return( FALSE );
+    }
+
+    if( block_size <= 0 )
+        block_size = DEFAULT_PYRAMID_BLOCK_SIZE;
+
+    get_volume_sizes( volume, sizes );
+
+    pyramid->block_size = block_size;
+
+    for_less( dim, 0, N_DIMENSIONS )
+    {
+        pyramid->sizes[dim] = sizes[dim];
+        pyramid->n_blocks[0][dim] = MAX( 1, (sizes[dim] - 2) / block_size + 1 );
+    }
+
+    /*--- count the levels */
+
+    level = 0;
+    do
+    {
+        done = TRUE;
+        for_less( dim, 0, N_DIMENSIONS )
+        {
+            if( pyramid->n_blocks[level][dim] > 1 )
+                done = FALSE;
+        }
+
+        if( !done )
+        {
+            if( level + 1 >= MAX_MINMAX_PYRAMID_LEVELS )
+                break;
+
+            for_less( dim, 0, N_DIMENSIONS )
+                pyramid->n_blocks[level+1][dim] =
+                                   (pyramid->n_blocks[level][dim] + 1) / 2;
+            ++level;
+        }
+    }
+    while( !done );
+
+    pyramid->n_levels = level + 1;
+
+    for_less( level, 0, pyramid->n_levels )
+    {
+        n_blocks = pyramid->n_blocks[level];
+        ALLOC( pyramid->min_values[level],
+               (size_t) n_blocks[X] * (size_t) n_blocks[Y] *
+               (size_t) n_blocks[Z] );
+        ALLOC( pyramid->max_values[level],
+               (size_t) n_blocks[X] * (size_t) n_blocks[Y] *
+               (size_t) n_blocks[Z] );
+
+        for_less( block, 0, (size_t) n_blocks[X] * (size_t) n_blocks[Y] *
+                            (size_t) n_blocks[Z] )
+        {
+            pyramid->min_values[level][block] = 0.0;
+            pyramid->max_values[level][block] = 0.0;
+        }
+    }
+
+    /*--- level 0, from the voxels a slice at a time.  A voxel on a block
+          boundary belongs to the blocks on both sides. */
+
+    n_blocks = pyramid->n_blocks[0];
+    ALLOC( slice, sizes[Y] * sizes[Z] );
+
+    for_less( x, 0, sizes[X] )
+    {
+        get_volume_value_hyperslab_3d( volume, x, 0, 0, 1, sizes[Y], sizes[Z],
+                                       slice );
+
+        b_end[X] = MIN( x / block_size, n_blocks[X] - 1 );
+        b_start[X] = (x % block_size == 0 && x > 0) ? x / block_size - 1 :
+                                                      b_end[X];
+
+        for_less( y, 0, sizes[Y] )
+        {
+            b_end[Y] = MIN( y / block_size, n_blocks[Y] - 1 );
+            b_start[Y] = (y % block_size == 0 && y > 0) ? y / block_size - 1 :
+                                                          b_end[Y];
+
+            for_less( z, 0, sizes[Z] )
+            {
+                b_end[Z] = MIN( z / block_size, n_blocks[Z] - 1 );
+                b_start[Z] = (z % block_size == 0 && z > 0) ?
+                                        z / block_size - 1 : b_end[Z];
+
+                value = slice[y * sizes[Z] + z];
+
+                for_inclusive( bx, b_start[X], b_end[X] )
+                for_inclusive( by, b_start[Y], b_end[Y] )
+                for_inclusive( bz, b_start[Z], b_end[Z] )
+                {
+                    block = ((size_t) bx * (size_t) n_blocks[Y] +
+                             (size_t) by) * (size_t) n_blocks[Z] + (size_t) bz;
+
+                    /*--- the first voxel of a block is its lowest corner */
+
+                    if( x == bx * block_size && y == by * block_size &&
+                        z == bz * block_size )
+                    {
+                        pyramid->min_values[0][block] = value;
+                        pyramid->max_values[0][block] = value;
+                    }
+                    else
+                    {
+                        if( value < pyramid->min_values[0][block] )
+                            pyramid->min_values[0][block] = value;
+                        if( value > pyramid->max_values[0][block] )
+                            pyramid->max_values[0][block] = value;
+                    }
+                }
+            }
+        }
+    }
+
+    FREE( slice );
+
+    /*--- coarser levels, each block the union of up to 8 finer ones */
+
+    for_less( level, 1, pyramid->n_levels )
+    {
+        n_blocks = pyramid->n_blocks[level];
+        n_sub = pyramid->n_blocks[level-1];
+
+        for_less( bx, 0, n_blocks[X] )
+        for_less( by, 0, n_blocks[Y] )
+        for_less( bz, 0, n_blocks[Z] )
+        {
+            block = ((size_t) bx * (size_t) n_blocks[Y] + (size_t) by) *
+                    (size_t) n_blocks[Z] + (size_t) bz;
+            done = FALSE;
+
+            for_less( cx, 2 * bx, MIN( 2 * bx + 2, n_sub[X] ) )
+            for_less( cy, 2 * by, MIN( 2 * by + 2, n_sub[Y] ) )
+            for_less( cz, 2 * bz, MIN( 2 * bz + 2, n_sub[Z] ) )
+            {
+                sub_block = ((size_t) cx * (size_t) n_sub[Y] + (size_t) cy) *
+                            (size_t) n_sub[Z] + (size_t) cz;
+
+                if( !done || pyramid->min_values[level-1][sub_block] <
+                             pyramid->min_values[level][block] )
+                    pyramid->min_values[level][block] =
+                                    pyramid->min_values[level-1][sub_block];
+
+                if( !done || pyramid->max_values[level-1][sub_block] >
+                             pyramid->max_values[level][block] )
+                    pyramid->max_values[level][block] =
+                                    pyramid->max_values[level-1][sub_block];
+                done = TRUE;
+            }
+        }
+    }
+
+    return( TRUE );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : delete_minmax_pyramid
+@INPUT      : pyramid
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Frees the memory of a pyramid created by create_minmax_pyramid().
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  delete_minmax_pyramid(
+    minmax_pyramid_struct  *pyramid )
+{
+    int   level;
+
+    for_less( level, 0, pyramid->n_levels )
+    {
+        FREE( pyramid->min_values[level] );
+        FREE( pyramid->max_values[level] );
+    }
+
+    pyramid->n_levels = 0;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : search_pyramid_level
+@INPUT      : pyramid
+              level
+              parent_range  - range of blocks of this level to consider
+              low, high     - voxel box, inclusive
+              min_value
+              max_value
+              must_span     - see minmax_pyramid_box_spans_range()
+@OUTPUT     :
+@RETURNS    : TRUE if a block of this level overlapping the box may contain
+              the range
+@DESCRIPTION: Recursive step of the pyramid queries, descending only into
+              blocks that overlap the box and pass the test.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  BOOLEAN  search_pyramid_level(
+    minmax_pyramid_struct  *pyramid,
+    int                    level,
+    int                    parent_range[2][N_DIMENSIONS],
+    int                    low[],
+    int                    high[],
+    Real                   min_value,
+    Real                   max_value,
+    BOOLEAN                must_span )
+{
+    int      dim, b[N_DIMENSIONS], range[2][N_DIMENSIONS], child[2][N_DIMENSIONS];
+    int      block_voxels, *n_blocks;
+    size_t   block;
+    Real     block_min, block_max;
+
+    n_blocks = pyramid->n_blocks[level];
+    block_voxels = pyramid->block_size << level;
+
+    /*--- block b covers voxels b*block_voxels to (b+1)*block_voxels */
+
+    for_less( dim, 0, N_DIMENSIONS )
+    {
+        range[0][dim] = MAX( parent_range[0][dim],
+                             (low[dim] + block_voxels - 1) / block_voxels - 1 );
+        range[0][dim] = MAX( range[0][dim], 0 );
+        range[1][dim] = MIN( parent_range[1][dim], high[dim] / block_voxels );
+        range[1][dim] = MIN( range[1][dim], n_blocks[dim] - 1 );
+    }
+
+    for_inclusive( b[X], range[0][X], range[1][X] )
+    for_inclusive( b[Y], range[0][Y], range[1][Y] )
+    for_inclusive( b[Z], range[0][Z], range[1][Z] )
+    {
+        block = ((size_t) b[X] * (size_t) n_blocks[Y] + (size_t) b[Y]) *
+                (size_t) n_blocks[Z] + (size_t) b[Z];
+
+        block_min = pyramid->min_values[level][block];
+        block_max = pyramid->max_values[level][block];
+
+        if( block_max < min_value || block_min > max_value )
+            continue;
+
+        if( must_span && block_min >= min_value && block_max <= max_value &&
+            min_value < max_value )
+            continue;
+
+        if( level == 0 )
+            return( TRUE );
+
+        for_less( dim, 0, N_DIMENSIONS )
+        {
+            child[0][dim] = 2 * b[dim];
+            child[1][dim] = 2 * b[dim] + 1;
+        }
+
+        if( search_pyramid_level( pyramid, level - 1, child, low, high,
+                                  min_value, max_value, must_span ) )
+            return( TRUE );
+    }
+
+    return( FALSE );
+}
+
+static  BOOLEAN  search_pyramid(
+    minmax_pyramid_struct  *pyramid,
+    int                    low[],
+    int                    high[],
+    Real                   min_value,
+    Real                   max_value,
+    BOOLEAN                must_span )
+{
+    int     dim, top_range[2][N_DIMENSIONS], clipped_low[N_DIMENSIONS];
+    int     clipped_high[N_DIMENSIONS];
+
+    for_less( dim, 0, N_DIMENSIONS )
+    {
+        clipped_low[dim] = MAX( low[dim], 0 );
+        clipped_high[dim] = MIN( high[dim], pyramid->sizes[dim] - 1 );
+
+        if( clipped_low[dim] > clipped_high[dim] )
+            return( FALSE );
+
+        top_range[0][dim] = 0;
+        top_range[1][dim] = pyramid->n_blocks[pyramid->n_levels-1][dim] - 1;
+    }
+
+    return( search_pyramid_level( pyramid, pyramid->n_levels - 1, top_range,
+                                  clipped_low, clipped_high,
+                                  min_value, max_value, must_span ) );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : minmax_pyramid_box_intersects_range
+@INPUT      : pyramid
+              low, high   - voxel box, inclusive, clipped to the volume
+              min_value
+              max_value
+@OUTPUT     :
+@RETURNS    : FALSE if no voxel in the box has a value in the range
+@DESCRIPTION: Conservative test of whether a box of voxels may contain
+              values from min_value to max_value.  It may return TRUE for
+              boxes that do not, but never FALSE for boxes that do.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  minmax_pyramid_box_intersects_range(
+    minmax_pyramid_struct  *pyramid,
+    int                    low[],
+    int                    high[],
+    Real                   min_value,
+    Real                   max_value )
+{
+    return( search_pyramid( pyramid, low, high, min_value, max_value,
+                            FALSE ) );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : minmax_pyramid_box_spans_range
+@INPUT      : pyramid
+              low, high   - voxel box, inclusive, clipped to the volume
+              min_value
+              max_value
+@OUTPUT     :
+@RETURNS    : FALSE if the box certainly contains no boundary of the range
+@DESCRIPTION: Conservative test of whether a box of voxels may contain the
+              boundary of the region with values from min_value to
+              max_value, that is, whether any block overlapping the box has
+              some values in the range and some outside.  Since each cube of
+              8 voxels lies within a block, FALSE means that no cube in the
+              box crosses the boundary.  With min_value equal to max_value,
+              this tests whether the box may contain the isosurface at that
+              value.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  minmax_pyramid_box_spans_range(
+    minmax_pyramid_struct  *pyramid,
+    int                    low[],
+    int                    high[],
+    Real                   min_value,
+    Real                   max_value )
+{
+    return( search_pyramid( pyramid, low, high, min_value, max_value,
+                            TRUE ) );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_minmax_pyramid_box_range
+@INPUT      : pyramid
+              low, high   - voxel box, inclusive
+@OUTPUT     : min_value
+              max_value
+@RETURNS    : FALSE if the box does not overlap the volume
+@DESCRIPTION: Gets bounds on the values of a box of voxels, from the finest
+              level of the pyramid.  The bounds contain the actual range,
+              but may be wider.  Intended for small boxes, as the time taken
+              is proportional to the number of blocks overlapped.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  get_minmax_pyramid_box_range(
+    minmax_pyramid_struct  *pyramid,
+    int                    low[],
+    int                    high[],
+    Real                   *min_value,
+    Real                   *max_value )
+{
+    int      dim, bx, by, bz, range[2][N_DIMENSIONS], block_size, *n_blocks;
+    size_t   block;
+    BOOLEAN  first;
+
+    block_size = pyramid->block_size;
+    n_blocks = pyramid->n_blocks[0];
+
+    for_less( dim, 0, N_DIMENSIONS )
+    {
+        if( high[dim] < 0 || low[dim] > pyramid->sizes[dim] - 1 ||
+            low[dim] > high[dim] )
+            return( FALSE );
+
+        /*--- a voxel on a block boundary is in both blocks, so one of them
+              is enough */
+
+        range[0][dim] = MIN( MAX( low[dim], 0 ) / block_size,
+                             n_blocks[dim] - 1 );
+        range[1][dim] = MIN( (MIN( high[dim], pyramid->sizes[dim] - 1 ) - 1) /
+                             block_size, n_blocks[dim] - 1 );
+        range[1][dim] = MAX( range[0][dim], range[1][dim] );
+    }
+
+    first = TRUE;
+
+    for_inclusive( bx, range[0][X], range[1][X] )
+    for_inclusive( by, range[0][Y], range[1][Y] )
+    for_inclusive( bz, range[0][Z], range[1][Z] )
+    {
+        block = ((size_t) bx * (size_t) n_blocks[Y] + (size_t) by) *
+                (size_t) n_blocks[Z] + (size_t) bz;
+
+        if( first || pyramid->min_values[0][block] < *min_value )
+            *min_value = pyramid->min_values[0][block];
+        if( first || pyramid->max_values[0][block] > *max_value )
+            *max_value = pyramid->max_values[0][block];
+        first = FALSE;
+    }
+
+    return( TRUE );
+}
@@ -1,4 +1,7 @@
 #include  "bicpl_internal.h"
+#include  <bicpl/splines.h>
+#include  <limits.h>
+#include  <float.h>
 
 BICAPI void  initialize_resample_volume(
     resample_struct      *resample,
@@ -12,6 +15,8 @@ BICAPI void  initialize_resample_volume(
     resample->dest_volume = dest_volume;
     resample->x = 0;
     resample->y = 0;
+    resample->n_threads = 1;
+    resample->degrees_continuity = 0;
 
     copy_general_transform( get_voxel_to_world_transform(dest_volume),
                             &resample->transform );
@@ -33,82 +38,635 @@ BICAPI void  initialize_resample_volume(
     resample->transform = tmp;
 }
 
+/*--- number of destination slabs handed to each thread between checks
+      of the time limit in do_more_resampling() */
+
+#define  SLABS_PER_THREAD  2
+
+typedef struct
+{
+    BOOLEAN          possible;
+    int              degrees_continuity;
+    Data_types       src_type;
+    void             *src_data;
+    int              src_sizes[N_DIMENSIONS];
+    size_t           src_strides[N_DIMENSIONS];
+    Real             src_scale;
+    Real             src_translation;
+    Data_types       dest_type;
+    void             *dest_data;
+    size_t           dest_strides[N_DIMENSIONS];
+    Real             dest_scale;
+    Real             dest_translation;
+    BOOLEAN          dest_is_integer;
+    Real             dest_min;
+    Real             dest_max;
+} direct_access_struct;
+
+typedef struct
+{
+    resample_struct       *resample;
+    BOOLEAN               linear;
+    Vector                z_axis;
+    int                   n_z;
+    int                   first_x;
+    int                   n_y;
+    direct_access_struct  direct;
+} resample_job_struct;
+
+/*--- per-thread scratch space for one destination column */
+
+typedef struct
+{
+    size_t     *offsets;
+    Real       *u;
+    Real       *v;
+    Real       *w;
+    Real       *values;
+    Real       (*positions)[N_DIMENSIONS];
+    BOOLEAN    *inside;
+} column_workspace_struct;
+
+static  void  initialize_column_workspace(
+    column_workspace_struct  *workspace,
+    int                      n_z )
+{
+    ALLOC( workspace->offsets, n_z );
+    ALLOC( workspace->u, n_z );
+    ALLOC( workspace->v, n_z );
+    ALLOC( workspace->w, n_z );
+    ALLOC( workspace->values, n_z );
+    ALLOC( workspace->positions, n_z );
+    ALLOC( workspace->inside, n_z );
+}
+
+static  void  delete_column_workspace(
+    column_workspace_struct  *workspace )
+{
+    FREE( workspace->offsets );
+    FREE( workspace->u );
+    FREE( workspace->v );
+    FREE( workspace->w );
+    FREE( workspace->values );
+    FREE( workspace->positions );
+    FREE( workspace->inside );
+}
+
+/*--- expands the macro for the C type corresponding to data_type */
+
+#define  SWITCH_ON_DATA_TYPE( data_type, MACRO ) \
+         switch( data_type ) \
+         { \
+         case UNSIGNED_BYTE:   MACRO( unsigned char );   break; \
+         case SIGNED_BYTE:     MACRO( signed char );     break; \
+         case UNSIGNED_SHORT:  MACRO( unsigned short );  break; \
+         case SIGNED_SHORT:    MACRO( signed short );    break; \
+         case UNSIGNED_INT:    MACRO( unsigned int );    break; \
+         case SIGNED_INT:      MACRO( signed int );      break; \
+         case FLOAT:           MACRO( float );           break; \
+         case DOUBLE:          MACRO( double );          break; \
+         default:                                        break; \
+         }
+
+static  BOOLEAN  get_data_type_range(
+    Data_types   type,
+    Real         *min_value,
+    Real         *max_value )
+{
+    switch( type )
+    {
+    case UNSIGNED_BYTE:   *min_value = 0.0;
+                          *max_value = (Real) UCHAR_MAX;   break;
+    case SIGNED_BYTE:     *min_value = (Real) SCHAR_MIN;
+                          *max_value = (Real) SCHAR_MAX;   break;
+    case UNSIGNED_SHORT:  *min_value = 0.0;
+                          *max_value = (Real) USHRT_MAX;   break;
+    case SIGNED_SHORT:    *min_value = (Real) SHRT_MIN;
+                          *max_value = (Real) SHRT_MAX;    break;
+    case UNSIGNED_INT:    *min_value = 0.0;
+                          *max_value = (Real) UINT_MAX;    break;
+    case SIGNED_INT:      *min_value = (Real) INT_MIN;
+                          *max_value = (Real) INT_MAX;     break;
+    case FLOAT:           *min_value = (Real) -FLT_MAX;
+                          *max_value = (Real) FLT_MAX;     break;
+    case DOUBLE:          *min_value = -DBL_MAX;
+                          *max_value = DBL_MAX;            break;
+    default:              return( FALSE );
+    }
+
+    return( TRUE );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : initialize_direct_access
+@INPUT      : resample
+              linear
+@OUTPUT     : direct
+@RETURNS    : 
+@DESCRIPTION: Decides whether the resampling can bypass evaluate_volume()
+              and set_volume_real_value() by reading and writing the voxel
+              arrays directly, and if so records the data pointers, strides
+              and voxel-to-value mappings of both volumes, and the valid
+              voxel range of the destination.  This requires a
+              linear transform, 3D non-cached non-RGB volumes, and nearest
+              neighbour, linear or cubic interpolation.
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+static  void  initialize_direct_access(
+    resample_struct       *resample,
+    BOOLEAN               linear,
+    direct_access_struct  *direct )
+{
+    Volume   src, dest;
+    int      dim, dest_sizes[MAX_DIMENSIONS];
+    Real     type_min, type_max;
+
+    src = resample->src_volume;
+    dest = resample->dest_volume;
+
+    direct->degrees_continuity = resample->degrees_continuity;
+    direct->possible = linear &&
+                       (direct->degrees_continuity == -1 ||
+                        direct->degrees_continuity == 0 ||
+                        direct->degrees_continuity == 2) &&
+                       get_volume_n_dimensions( src ) == N_DIMENSIONS &&
+                       get_volume_n_dimensions( dest ) == N_DIMENSIONS &&
+                       !src->is_cached_volume && !dest->is_cached_volume &&
+                       !is_an_rgb_volume( src ) && !is_an_rgb_volume( dest );
+
+    if( !direct->possible )
+        return;
+
+    direct->src_type = get_volume_data_type( src );
+    direct->dest_type = get_volume_data_type( dest );
+
+    if( !get_data_type_range( direct->src_type, &type_min, &type_max ) ||
+        !get_data_type_range( direct->dest_type, &type_min, &type_max ) )
+    {
+        direct->possible = FALSE;
+        return;
+    }
+
+    /*--- set_volume_real_value() clamps to the valid range, which may be
+          narrower than that of the type */
+
+    get_volume_voxel_range( dest, &direct->dest_min, &direct->dest_max );
+
+    direct->dest_is_integer = (direct->dest_type != FLOAT &&
+                               direct->dest_type != DOUBLE);
+
+    GET_VOXEL_PTR( direct->src_data, src, 0, 0, 0, 0, 0 );
+    GET_VOXEL_PTR( direct->dest_data, dest, 0, 0, 0, 0, 0 );
+
+    get_volume_sizes( src, direct->src_sizes );
+    get_volume_sizes( dest, dest_sizes );
+
+    direct->src_strides[N_DIMENSIONS-1] = 1;
+    direct->dest_strides[N_DIMENSIONS-1] = 1;
+    for_down( dim, N_DIMENSIONS-2, 0 )
+    {
+        direct->src_strides[dim] = direct->src_strides[dim+1] *
+                                   (size_t) direct->src_sizes[dim+1];
+        direct->dest_strides[dim] = direct->dest_strides[dim+1] *
+                                    (size_t) dest_sizes[dim+1];
+    }
+
+    /*--- both value mappings are linear, so two samples define them */
+
+    direct->src_translation = convert_voxel_to_value( src, 0.0 );
+    direct->src_scale = convert_voxel_to_value( src, 1.0 ) -
+                        direct->src_translation;
+
+    direct->dest_translation = convert_value_to_voxel( dest, 0.0 );
+    direct->dest_scale = convert_value_to_voxel( dest, 1.0 ) -
+                         direct->dest_translation;
+}
+
+/*--- the interpolation macros below expect, in the enclosing scope,
+      z, n_z, the typed data pointer "data", the strides s0, s1, s2,
+      and the workspace arrays */
+
+#define  NEAREST_ROW( type ) \
+         { \
+             const type  *data = (const type *) direct->src_data; \
+ \
+             for_less( z, 0, n_z ) \
+             { \
+                 if( inside[z] ) \
+                     values[z] = (Real) data[offsets[z]]; \
+             } \
+         }
+
+#define  TRILINEAR_ROW( type ) \
+         { \
+             const type  *data = (const type *) direct->src_data; \
+             const type  *p; \
+             Real        c00, c01, c10, c11, c0, c1; \
+ \
+             for_less( z, 0, n_z ) \
+             { \
+                 if( !inside[z] ) \
+                     continue; \
+ \
+                 p = &data[offsets[z]]; \
+                 c00 = (Real) p[0] + w[z] * ((Real) p[s2] - (Real) p[0]); \
+                 c01 = (Real) p[s1] + w[z] * ((Real) p[s1+s2] - \
+                                              (Real) p[s1]); \
+                 c10 = (Real) p[s0] + w[z] * ((Real) p[s0+s2] - \
+                                              (Real) p[s0]); \
+                 c11 = (Real) p[s0+s1] + w[z] * ((Real) p[s0+s1+s2] - \
+                                                 (Real) p[s0+s1]); \
+                 c0 = c00 + v[z] * (c01 - c00); \
+                 c1 = c10 + v[z] * (c11 - c10); \
+                 values[z] = c0 + u[z] * (c1 - c0); \
+             } \
+         }
+
+#define  TRICUBIC_ROW( type ) \
+         { \
+             const type  *data = (const type *) direct->src_data; \
+             const type  *p, *q, *r; \
+             Real        wu[4], wv[4], ww[4], sum_v, sum_w, sum; \
+             int         i, j; \
+ \
+             for_less( z, 0, n_z ) \
+             { \
+                 if( !inside[z] ) \
+                     continue; \
+ \
+                 COMPUTE_CUBIC_COEFFS( u[z], wu[0], wu[1], wu[2], wu[3] ); \
+                 COMPUTE_CUBIC_COEFFS( v[z], wv[0], wv[1], wv[2], wv[3] ); \
+                 COMPUTE_CUBIC_COEFFS( w[z], ww[0], ww[1], ww[2], ww[3] ); \
+ \
+                 p = &data[offsets[z]]; \
+                 sum = 0.0; \
+                 for_less( i, 0, 4 ) \
+                 { \
+                     q = p + (size_t) i * s0; \
+                     sum_v = 0.0; \
+                     for_less( j, 0, 4 ) \
+                     { \
+                         r = q + (size_t) j * s1; \
+                         sum_w = ww[0] * (Real) r[0] + \
+                                 ww[1] * (Real) r[s2] + \
+                                 ww[2] * (Real) r[2*s2] + \
+                                 ww[3] * (Real) r[3*s2]; \
+                         sum_v += wv[j] * sum_w; \
+                     } \
+                     sum += wu[i] * sum_v; \
+                 } \
+                 values[z] = sum; \
+             } \
+         }
+
+#define  STORE_ROW( type ) \
+         { \
+             type  *data = (type *) direct->dest_data + dest_offset; \
+             Real  voxel; \
+ \
+             for_less( z, 0, n_z ) \
+             { \
+                 voxel = direct->dest_scale * values[z] + \
+                         direct->dest_translation; \
+                 if( direct->dest_is_integer ) \
+                     voxel = floor( voxel + 0.5 ); \
+                 if( voxel < direct->dest_min ) \
+                     voxel = direct->dest_min; \
+                 else if( voxel > direct->dest_max ) \
+                     voxel = direct->dest_max; \
+                 data[z] = (type) voxel; \
+             } \
+         }
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : resample_column_direct
+@INPUT      : job
+              x
+              y
+              workspace
+@OUTPUT     : 
+@RETURNS    : 
+@DESCRIPTION: Fills the destination column (x,y,*) by interpolating the
+              source voxel array directly.  The source positions of the
+              whole column are computed first; those whose interpolation
+              stencil lies inside the source volume are interpolated in a
+              tight loop specialized for the source data type, the rest
+              go through evaluate_volume() so the boundary handling is
+              unchanged.  The column is then converted and stored with a
+              loop specialized for the destination data type.
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+static  void  resample_column_direct(
+    resample_job_struct      *job,
+    int                      x,
+    int                      y,
+    column_workspace_struct  *workspace )
+{
+    direct_access_struct  *direct;
+    resample_struct       *resample;
+    int                   z, n_z, dim, degrees, index[N_DIMENSIONS];
+    int                   low_limit, high_limit;
+    BOOLEAN               in_bounds;
+    size_t                s0, s1, s2, offset, dest_offset;
+    Real                  start[N_DIMENSIONS], step[N_DIMENSIONS];
+    Real                  pos, frac[N_DIMENSIONS];
+    Real                  voxel[MAX_DIMENSIONS], outside_value;
+    size_t                *offsets;
+    Real                  *u, *v, *w, *values;
+    BOOLEAN               *inside;
+
+    resample = job->resample;
+    direct = &job->direct;
+    degrees = direct->degrees_continuity;
+    n_z = job->n_z;
+
+    offsets = workspace->offsets;
+    u = workspace->u;
+    v = workspace->v;
+    w = workspace->w;
+    values = workspace->values;
+    inside = workspace->inside;
+
+    s0 = direct->src_strides[X];
+    s1 = direct->src_strides[Y];
+    s2 = direct->src_strides[Z];
+
+    general_transform_point( &resample->transform, (Real) x, (Real) y, 0.0,
+                             &start[X], &start[Y], &start[Z] );
+    step[X] = (Real) Vector_x( job->z_axis );
+    step[Y] = (Real) Vector_y( job->z_axis );
+    step[Z] = (Real) Vector_z( job->z_axis );
+
+    /*--- source positions along the column */
+
+    for_less( z, 0, n_z )
+    {
+        workspace->positions[z][X] = start[X] + (Real) z * step[X];
+        workspace->positions[z][Y] = start[Y] + (Real) z * step[Y];
+        workspace->positions[z][Z] = start[Z] + (Real) z * step[Z];
+    }
+
+    /*--- lowest stencil corner, and the range it must lie in for the
+          whole stencil to be inside the source volume */
+
+    for_less( z, 0, n_z )
+    {
+        in_bounds = TRUE;
+        offset = 0;
+
+        for_less( dim, 0, N_DIMENSIONS )
+        {
+            pos = workspace->positions[z][dim];
+
+            if( degrees == -1 )
+            {
+                low_limit = 0;
+                high_limit = direct->src_sizes[dim] - 1;
+                in_bounds = in_bounds && pos >= -0.5 &&
+                            pos < (Real) high_limit + 0.5;
+                index[dim] = in_bounds ? FLOOR( pos + 0.5 ) : 0;
+                frac[dim] = 0.0;
+            }
+            else
+            {
+                low_limit = (degrees == 0) ? 0 : 1;
+                high_limit = direct->src_sizes[dim] - 1 - low_limit;
+                in_bounds = in_bounds && pos >= (Real) low_limit &&
+                            pos < (Real) high_limit;
+                index[dim] = in_bounds ? FLOOR( pos ) : 0;
+                frac[dim] = pos - (Real) index[dim];
+                index[dim] -= low_limit;
+            }
+
+            offset += (size_t) index[dim] * direct->src_strides[dim];
+        }
+
+        inside[z] = in_bounds;
+        offsets[z] = offset;
+        u[z] = frac[X];
+        v[z] = frac[Y];
+        w[z] = frac[Z];
+    }
+
+    /*--- interpolate the interior positions in voxel units */
+
+    switch( degrees )
+    {
+    case -1:
+        SWITCH_ON_DATA_TYPE( direct->src_type, NEAREST_ROW )
+        break;
+    case 0:
+        SWITCH_ON_DATA_TYPE( direct->src_type, TRILINEAR_ROW )
+        break;
+    case 2:
+        SWITCH_ON_DATA_TYPE( direct->src_type, TRICUBIC_ROW )
+        break;
+    }
+
+    outside_value = get_volume_real_min( resample->src_volume );
+
+    for_less( z, 0, n_z )
+    {
+        if( inside[z] )
+            values[z] = direct->src_scale * values[z] +
+                        direct->src_translation;
+        else
+        {
+            voxel[X] = workspace->positions[z][X];
+            voxel[Y] = workspace->positions[z][Y];
+            voxel[Z] = workspace->positions[z][Z];
+            evaluate_volume( resample->src_volume, voxel, NULL, degrees,
+                             FALSE, outside_value, &values[z], NULL, NULL );
+        }
+    }
+
+    dest_offset = (size_t) x * direct->dest_strides[X] +
+                  (size_t) y * direct->dest_strides[Y];
+
+    SWITCH_ON_DATA_TYPE( direct->dest_type, STORE_ROW )
+}
+
+static  void  resample_column(
+    resample_job_struct      *job,
+    int                      x,
+    int                      y,
+    column_workspace_struct  *workspace )
+{
+    resample_struct  *resample;
+    Real             value;
+    int              z;
+    Real             xv, yv, zv, voxel[MAX_DIMENSIONS];
+
+    if( job->direct.possible )
+    {
+        resample_column_direct( job, x, y, workspace );
+        return;
+    }
+
+    resample = job->resample;
+
+    for_less( z, 0, job->n_z )
+    {
+        if( !job->linear || z == 0 )
+            general_transform_point( &resample->transform,
+                                     (Real) x, (Real) y, (Real) z,
+                                     &xv, &yv, &zv );
+
+        voxel[X] = xv;
+        voxel[Y] = yv;
+        voxel[Z] = zv;
+        evaluate_volume( resample->src_volume, voxel, NULL,
+                         resample->degrees_continuity, FALSE,
+                         get_volume_real_min(resample->src_volume),
+                         &value, NULL, NULL );
+
+        set_volume_real_value( resample->dest_volume, x, y, z, 0, 0, value );
+
+        if( job->linear )
+        {
+            xv += (Real) Vector_x(job->z_axis);
+            yv += (Real) Vector_y(job->z_axis);
+            zv += (Real) Vector_z(job->z_axis);
+        }
+    }
+}
+
+/*--- resamples the slab of destination voxels at x = first_x + slab */
+
+static  void  resample_slab(
+    void   *data,
+    int    slab,
+    int    thread )
+{
+    resample_job_struct      *job;
+    column_workspace_struct  workspace;
+    int                      x, y;
+
+    job = (resample_job_struct *) data;
+    x = job->first_x + slab;
+
+    initialize_column_workspace( &workspace, job->n_z );
+
+    for_less( y, 0, job->n_y )
+        resample_column( job, x, y, &workspace );
+
+    delete_column_workspace( &workspace );
+}
+
+/*--- the slabs may only be filled concurrently if neither volume goes
+      through the volume_io cache, which is not thread safe */
+
+static  BOOLEAN  can_resample_in_parallel(
+    resample_struct  *resample )
+{
+    return( !resample->src_volume->is_cached_volume &&
+            !resample->dest_volume->is_cached_volume );
+}
+
+BICAPI void  set_resampling_degrees_continuity(
+    resample_struct  *resample,
+    int              degrees_continuity )
+{
+    resample->degrees_continuity = degrees_continuity;
+}
+
+BICAPI void  set_resampling_n_threads(
+    resample_struct  *resample,
+    int              n_threads )
+{
+    resample->n_threads = n_threads;
+}
+
 BICAPI BOOLEAN  do_more_resampling(
     resample_struct  *resample,
     Real             max_seconds,
     Real             *fraction_done )
 {
-    Real            value;
-    BOOLEAN         linear;
-    Vector          z_axis;
-    int             z;
-    Real            xv, yv, zv, voxel[MAX_DIMENSIONS];
-    Real            end_time;
-    int             dest_sizes[MAX_DIMENSIONS], src_sizes[MAX_DIMENSIONS];
+    resample_job_struct      job;
+    column_workspace_struct  workspace;
+    int                      n_threads, n_slabs;
+    Real                     end_time;
+    int                      dest_sizes[MAX_DIMENSIONS];
 
     if( max_seconds >= 0.0 )
         end_time = current_realtime_seconds() + max_seconds;
 
     get_volume_sizes( resample->dest_volume, dest_sizes );
-    get_volume_sizes( resample->src_volume, src_sizes );
 
-    linear = get_transform_type( &resample->transform ) == LINEAR;
-    if( linear )
+    job.resample = resample;
+    job.n_y = dest_sizes[Y];
+    job.n_z = dest_sizes[Z];
+    job.linear = get_transform_type( &resample->transform ) == LINEAR;
+    if( job.linear )
     {
         get_transform_z_axis( get_linear_transform_ptr(&resample->transform),
-                              &z_axis );
+                              &job.z_axis );
     }
 
+    initialize_direct_access( resample, job.linear, &job.direct );
+    initialize_column_workspace( &workspace, job.n_z );
+
+    if( resample->n_threads != 1 && can_resample_in_parallel( resample ) )
+        n_threads = get_n_threads_to_use( resample->n_threads,
+                                          dest_sizes[X] );
+    else
+        n_threads = 1;
+
     while( resample->x < dest_sizes[X] )
     {
-        for_less( z, 0, dest_sizes[Z] )
+        /*--- whole slabs are farmed out to the threads, but a slab that
+              was partly done by a serial call is finished column by column */
+
+        if( n_threads > 1 && resample->y == 0 )
         {
-            if( !linear || z == 0 )
-                general_transform_point( &resample->transform,
-                                         (Real) resample->x,
-                                         (Real) resample->y,
-                                         (Real) z,
-                                         &xv, &yv, &zv );
-
-            voxel[X] = xv;
-            voxel[Y] = yv;
-            voxel[Z] = zv;
-            evaluate_volume( resample->src_volume, voxel, NULL, 0, FALSE,
-                             get_volume_real_min(resample->src_volume),
-                             &value, NULL, NULL );
-
-            set_volume_real_value( resample->dest_volume,
-                                   resample->x, resample->y, z, 0, 0, value );
-
-            if( linear )
-            {
-                xv += (Real) Vector_x(z_axis);
-                yv += (Real) Vector_y(z_axis);
-                zv += (Real) Vector_z(z_axis);
-            }
-        }
+            n_slabs = MIN( n_threads * SLABS_PER_THREAD,
+                           dest_sizes[X] - resample->x );
+            job.first_x = resample->x;
 
-        ++resample->y;
-        if( resample->y >= dest_sizes[Y] )
+            do_parallel_jobs( n_threads, n_slabs, resample_slab,
+                              (void *) &job );
+
+            resample->x += n_slabs;
+        }
+        else
         {
-            resample->y = 0;
-            ++resample->x;
+            resample_column( &job, resample->x, resample->y, &workspace );
+
+            ++resample->y;
+            if( resample->y >= dest_sizes[Y] )
+            {
+                resample->y = 0;
+                ++resample->x;
+            }
         }
 
         if( max_seconds >= 0.0 && current_realtime_seconds() > end_time )
             break;
     }
 
+    delete_column_workspace( &workspace );
+
     *fraction_done = (Real) (resample->x * dest_sizes[Y] + resample->y) /
                      (Real) dest_sizes[Y] / (Real) dest_sizes[X];
 
     return( resample->x < dest_sizes[X] );
 }
 
-BICAPI void  resample_volume(
+static  void  resample_volume_with_threads(
     Volume                   src_volume,
     General_transform        *dest_to_src_transform,
-    Volume                   dest_volume )
+    Volume                   dest_volume,
+    int                      n_threads )
 {
     static const     int  FACTOR = 1000;
     resample_struct  resample;
@@ -117,6 +675,7 @@ BICAPI void  resample_volume(
 
     initialize_resample_volume( &resample, src_volume, dest_to_src_transform,
                                 dest_volume );
+    set_resampling_n_threads( &resample, n_threads );
 
     initialize_progress_report( &progress, FALSE, FACTOR, "Resampling" );
 
@@ -127,3 +686,44 @@ BICAPI void  resample_volume(
 
     terminate_progress_report( &progress );
 }
+
+BICAPI void  resample_volume(
+    Volume                   src_volume,
+    General_transform        *dest_to_src_transform,
+    Volume                   dest_volume )
+{
+    resample_volume_with_threads( src_volume, dest_to_src_transform,
+                                  dest_volume, 1 );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : resample_volume_in_parallel
+@INPUT      : src_volume
+              dest_to_src_transform
+              dest_volume
+              n_threads             - number of threads, or 0 for the default
+@OUTPUT     : 
+@RETURNS    : 
+@DESCRIPTION: Same as resample_volume(), but fills independent slabs of the
+              destination volume on a pool of threads.  The result is
+              identical to the serial version.  If either volume is cached,
+              the resampling is done serially.
+@METHOD     : 
+@GLOBALS    : 
+@CALLS      : 
+@CREATED    : Oct. 2026
+@MODIFIED   : 
+---------------------------------------------------------------------------- */
+
+BICAPI void  resample_volume_in_parallel(
+    Volume                   src_volume,
+    General_transform        *dest_to_src_transform,
+    Volume                   dest_volume,
+    int                      n_threads )
+{
+    if( n_threads < 0 )
+        n_threads = 0;
+
+    resample_volume_with_threads( src_volume, dest_to_src_transform,
+                                  dest_volume, n_threads );
+}
@@ -0,0 +1,691 @@
+/* ----------------------------------------------------------------------------
+@COPYRIGHT  :
+              Copyright 1993,1994,1995 David MacDonald,
+              McConnell Brain Imaging Centre,
+              Montreal Neurological Institute, McGill University.
+              Permission to use, copy, modify, and distribute this
+              software and its documentation for any purpose and without
+              fee is hereby granted, provided that the above copyright
+              notice appear in all copies.  The author and McGill University
+              make no representations about the suitability of this
+              software for any purpose.  It is provided "as is" without
+              express or implied warranty.
+---------------------------------------------------------------------------- */
+
+#include  "bicpl_internal.h"
+
+/*--- the pole of the cubic B-spline prefilter, sqrt(3) - 2 */
+
+#define  BSPLINE_POLE        -0.26794919243112270
+#define  BSPLINE_TOLERANCE   1.0e-10
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : mirror_index
+@INPUT      : index
+              size
+@OUTPUT     :
+@RETURNS    : index in 0 .. size-1
+@DESCRIPTION: Maps an index outside the volume back inside it by reflecting
+              about the first and last voxel, the boundary condition of the
+              prefilter.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  int  mirror_index(
+    int   index,
+    int   size )
+{
+    int   period;
+
+    if( size == 1 )
+        return( 0 );
+
+    period = 2 * size - 2;
+
+    index %= period;
+    if( index < 0 )
+        index += period;
+
+    if( index >= size )
+        index = period - index;
+
+    return( index );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : prefilter_line
+@INPUT      : n
+              line
+@OUTPUT     : line
+@RETURNS    :
+@DESCRIPTION: Replaces the samples of a line by the cubic B-spline
+              coefficients that interpolate them, with mirror boundaries.
+@METHOD     : A causal and an anti-causal recursive filter, as in Unser,
+              Aldroubi and Eden, IEEE Trans. Signal Proc., 41(2), 1993.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  prefilter_line(
+    int    n,
+    Real   line[] )
+{
+    int    i, horizon;
+    Real   z, zn, z2n, iz, sum, gain;
+
+    if( n < 2 )
+        return;
+
+    z = BSPLINE_POLE;
+    gain = (1.0 - z) * (1.0 - 1.0 / z);
+
+    for_less( i, 0, n )
+        line[i] *= gain;
+
+    /*--- initial value of the causal filter */
+
+    horizon = (int) ceil( log( BSPLINE_TOLERANCE ) / log( FABS( z ) ) );
+
+    if( horizon < n )
+    {
+        zn = z;
+        sum = line[0];
+        for_less( i, 1, horizon )
+        {
+            sum += zn * line[i];
+            zn *= z;
+        }
+    }
+    else
+    {
+        zn = z;
+        iz = 1.0 / z;
+        z2n = pow( z, (Real) (n - 1) );
+        sum = line[0] + z2n * line[n-1];
+        z2n *= z2n * iz;
+        for_less( i, 1, n-1 )
+        {
+            sum += (zn + z2n) * line[i];
+            zn *= z;
+            z2n *= iz;
+        }
+        sum /= 1.0 - zn * zn;
+    }
+
+    line[0] = sum;
+
+    for_less( i, 1, n )
+        line[i] += z * line[i-1];
+
+    line[n-1] = (z / (z * z - 1.0)) * (z * line[n-2] + line[n-1]);
+
+    for_down( i, n-2, 0 )
+        line[i] = z * (line[i+1] - line[i]);
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : create_spline_coef_volume
+@INPUT      : volume
+@OUTPUT     : spline
+@RETURNS    : TRUE if successful
+@DESCRIPTION: Prefilters a 3D volume into the coefficients of the cubic
+              B-spline that interpolates its real values.  Once created,
+              each evaluation by evaluate_spline_coef_volume() is a weighted
+              sum of 4 by 4 by 4 coefficients, with continuous first and
+              second derivatives.  The coefficients are stored as floats, so
+              the structure takes 4 bytes per voxel.  The volume must not be
+              deleted while the coefficients are in use, and they must be
+              recreated if its values change.
+@METHOD     : Separable recursive filtering along each axis.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  create_spline_coef_volume(
+    spline_coef_volume_struct  *spline,
+    Volume                     volume )
+{
+    int        dim, a1, a2, x, y, z, i, n, sizes[MAX_DIMENSIONS];
+    int        pos[N_DIMENSIONS];
+    size_t     offset, stride;
+    Real       *line;
+    float      *coefs;
+
+    if( get_volume_n_dimensions( volume ) != N_DIMENSIONS )
+    {
+        print_error( "create_spline_coef_volume: volume must be 3D.\n" );
+        return( FALSE );
+    }
+
+    get_volume_sizes( volume, sizes );
+
+    spline->volume = volume;
+
+    for_less( dim, 0, N_DIMENSIONS )
+        spline->sizes[dim] = sizes[dim];
+
+    spline->strides[Z] = 1;
+    spline->strides[Y] = (size_t) sizes[Z];
+    spline->strides[X] = (size_t) sizes[Y] * (size_t) sizes[Z];
+
+    ALLOC( spline->coefs, (size_t) sizes[X] * spline->strides[X] );
+    coefs = spline->coefs;
+
+    offset = 0;
+    for_less( x, 0, sizes[X] )
+    for_less( y, 0, sizes[Y] )
+    for_less( z, 0, sizes[Z] )
+    {
+        coefs[offset] = (float) get_volume_real_value( volume, x, y, z, 0, 0 );
+        ++offset;
+    }
+
+    ALLOC( line, MAX( sizes[X], MAX( sizes[Y], sizes[Z] ) ) );
+
+    for_less( dim, 0, N_DIMENSIONS )
+    {
+        a1 = (dim + 1) % N_DIMENSIONS;
+        a2 = (dim + 2) % N_DIMENSIONS;
+        n = sizes[dim];
+        stride = spline->strides[dim];
+
+        for_less( pos[a1], 0, sizes[a1] )
+        for_less( pos[a2], 0, sizes[a2] )
+        {
+            pos[dim] = 0;
+            offset = (size_t) pos[X] * spline->strides[X] +
+                     (size_t) pos[Y] * spline->strides[Y] +
+                     (size_t) pos[Z] * spline->strides[Z];
+
+            for_less( i, 0, n )
+                line[i] = (Real) coefs[offset + (size_t) i * stride];
+
+            prefilter_line( n, line );
+
+            for_less( i, 0, n )
+                coefs[offset + (size_t) i * stride] = (float) line[i];
+        }
+    }
+
+    FREE( line );
+
+    return( TRUE );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : delete_spline_coef_volume
+@INPUT      : spline
+@OUTPUT     :
+@RETURNS    :
+@DESCRIPTION: Frees the coefficients created by create_spline_coef_volume().
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  delete_spline_coef_volume(
+    spline_coef_volume_struct  *spline )
+{
+    if( spline->coefs != NULL )
+        FREE( spline->coefs );
+
+    spline->coefs = NULL;
+    spline->volume = NULL;
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_coef_offsets
+@INPUT      : spline
+              dim
+              start      - index of the first of the 4 coefficients
+@OUTPUT     : offsets
+@RETURNS    :
+@DESCRIPTION: Computes the array offsets of 4 consecutive coefficients
+              along an axis, reflecting those outside the volume.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  get_coef_offsets(
+    spline_coef_volume_struct  *spline,
+    int                        dim,
+    int                        start,
+    size_t                     offsets[4] )
+{
+    int    i, size;
+
+    size = spline->sizes[dim];
+
+    if( start >= 0 && start + 3 < size )
+    {
+        for_less( i, 0, 4 )
+            offsets[i] = (size_t) (start + i) * spline->strides[dim];
+    }
+    else
+    {
+        for_less( i, 0, 4 )
+            offsets[i] = (size_t) mirror_index( start + i, size ) *
+                         spline->strides[dim];
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_bspline_weights
+@INPUT      : t     - position in 0 .. 1 between the middle coefficients
+@OUTPUT     : w     - weights of the 4 coefficients
+              dw    - weights for the first derivative, or NULL
+              ddw   - weights for the second derivative, or NULL
+@RETURNS    :
+@DESCRIPTION: Evaluates the uniform cubic B-spline basis functions.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+static  void  get_bspline_weights(
+    Real   t,
+    Real   w[4],
+    Real   dw[4],
+    Real   ddw[4] )
+{
+    Real   s, t2, t3;
+
+    s = 1.0 - t;
+    t2 = t * t;
+    t3 = t2 * t;
+
+    w[0] = s * s * s / 6.0;
+    w[1] = (3.0 * t3 - 6.0 * t2 + 4.0) / 6.0;
+    w[2] = (-3.0 * t3 + 3.0 * t2 + 3.0 * t + 1.0) / 6.0;
+    w[3] = t3 / 6.0;
+
+    if( dw != NULL )
+    {
+        dw[0] = -0.5 * s * s;
+        dw[1] = 1.5 * t2 - 2.0 * t;
+        dw[2] = -1.5 * t2 + t + 0.5;
+        dw[3] = 0.5 * t2;
+    }
+
+    if( ddw != NULL )
+    {
+        ddw[0] = s;
+        ddw[1] = 3.0 * t - 2.0;
+        ddw[2] = 1.0 - 3.0 * t;
+        ddw[3] = t;
+    }
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : evaluate_spline_coef_volume
+@INPUT      : spline
+              voxel          - voxel coordinates
+              outside_value
+@OUTPUT     : value
+              derivs         - NULL, or 3 first derivatives
+              second_derivs  - NULL, or the xx, xy, xz, yy, yz and zz second
+                               derivatives
+@RETURNS    : TRUE if the point is inside the volume
+@DESCRIPTION: Evaluates the cubic B-spline of a volume at a voxel position,
+              with derivatives with respect to voxel coordinates.  Points
+              outside the volume get the outside value and zero derivatives.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  evaluate_spline_coef_volume(
+    spline_coef_volume_struct  *spline,
+    Real                       voxel[],
+    Real                       outside_value,
+    Real                       *value,
+    Real                       derivs[],
+    Real                       second_derivs[] )
+{
+    int      dim, i, j, k, index;
+    Real     t, w[N_DIMENSIONS][4], dw[N_DIMENSIONS][4];
+    Real     ddw[N_DIMENSIONS][4];
+    Real     c, fw, fdw, fddw, gv, gdv, gddv, gwv, gdwv, gwddv;
+    size_t   offsets[N_DIMENSIONS][4], row, col;
+    float    *coefs;
+    BOOLEAN  want_derivs;
+
+    want_derivs = (derivs != NULL || second_derivs != NULL);
+
+    for_less( dim, 0, N_DIMENSIONS )
+    {
+        if( voxel[dim] < 0.0 ||
+            voxel[dim] > (Real) (spline->sizes[dim] - 1) )
+        {
+            *value = outside_value;
+            if( derivs != NULL )
+            {
+                for_less( i, 0, N_DIMENSIONS )
+                    derivs[i] = 0.0;
+            }
+            if( second_derivs != NULL )
+            {
+                for_less( i, 0, 6 )
+                    second_derivs[i] = 0.0;
+            }
+            return( FALSE );
+        }
+
+        index = FLOOR( voxel[dim] );
+        if( index >= spline->sizes[dim] - 1 )
+            index = MAX( 0, spline->sizes[dim] - 2 );
+        t = voxel[dim] - (Real) index;
+
+        get_bspline_weights( t, w[dim], want_derivs ? dw[dim] : NULL,
+                             second_derivs != NULL ? ddw[dim] : NULL );
+
+        get_coef_offsets( spline, dim, index - 1, offsets[dim] );
+    }
+
+    coefs = spline->coefs;
+
+    if( !want_derivs )
+    {
+        *value = 0.0;
+        for_less( i, 0, 4 )
+        {
+            gv = 0.0;
+            for_less( j, 0, 4 )
+            {
+                col = offsets[X][i] + offsets[Y][j];
+                gv += w[Y][j] * (w[Z][0] * (Real) coefs[col+offsets[Z][0]] +
+                                 w[Z][1] * (Real) coefs[col+offsets[Z][1]] +
+                                 w[Z][2] * (Real) coefs[col+offsets[Z][2]] +
+                                 w[Z][3] * (Real) coefs[col+offsets[Z][3]]);
+            }
+            *value += w[X][i] * gv;
+        }
+        return( TRUE );
+    }
+
+    if( second_derivs == NULL )
+    {
+        for_less( dim, 0, N_DIMENSIONS )
+        for_less( i, 0, 4 )
+            ddw[dim][i] = 0.0;
+    }
+
+    *value = 0.0;
+    if( derivs != NULL )
+    {
+        for_less( i, 0, N_DIMENSIONS )
+            derivs[i] = 0.0;
+    }
+    if( second_derivs != NULL )
+    {
+        for_less( i, 0, 6 )
+            second_derivs[i] = 0.0;
+    }
+
+    for_less( i, 0, 4 )
+    {
+        row = offsets[X][i];
+        gv = gdv = gddv = gwv = gdwv = gwddv = 0.0;
+
+        for_less( j, 0, 4 )
+        {
+            col = row + offsets[Y][j];
+            fw = fdw = fddw = 0.0;
+            for_less( k, 0, 4 )
+            {
+                c = (Real) coefs[col + offsets[Z][k]];
+                fw += w[Z][k] * c;
+                fdw += dw[Z][k] * c;
+                fddw += ddw[Z][k] * c;
+            }
+            gv += w[Y][j] * fw;
+            gdv += dw[Y][j] * fw;
+            gddv += ddw[Y][j] * fw;
+            gwv += w[Y][j] * fdw;
+            gdwv += dw[Y][j] * fdw;
+            gwddv += w[Y][j] * fddw;
+        }
+
+        *value += w[X][i] * gv;
+
+        if( derivs != NULL )
+        {
+            derivs[X] += dw[X][i] * gv;
+            derivs[Y] += w[X][i] * gdv;
+            derivs[Z] += w[X][i] * gwv;
+        }
+
+        if( second_derivs != NULL )
+        {
+            second_derivs[0] += ddw[X][i] * gv;
+            second_derivs[1] += dw[X][i] * gdv;
+            second_derivs[2] += dw[X][i] * gwv;
+            second_derivs[3] += w[X][i] * gddv;
+            second_derivs[4] += w[X][i] * gdwv;
+            second_derivs[5] += w[X][i] * gwddv;
+        }
+    }
+
+    return( TRUE );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : evaluate_spline_coef_volume_in_world
+@INPUT      : spline
+              x
+              y
+              z
+              outside_value
+@OUTPUT     : value
+              deriv_x, deriv_y, deriv_z        - or NULL
+              deriv_xx, deriv_xy, deriv_xz,
+              deriv_yy, deriv_yz, deriv_zz     - or NULL
+@RETURNS    : TRUE if the point is inside the volume
+@DESCRIPTION: The world coordinate counterpart of
+              evaluate_spline_coef_volume(), a drop-in replacement for
+              evaluate_volume_in_world() with degrees_continuity 2 when the
+              same volume is evaluated many times.  As with volume_io, the
+              derivatives are converted to world space with the linear part
+              of the voxel to world transform.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  BOOLEAN  evaluate_spline_coef_volume_in_world(
+    spline_coef_volume_struct  *spline,
+    Real                       x,
+    Real                       y,
+    Real                       z,
+    Real                       outside_value,
+    Real                       *value,
+    Real                       *deriv_x,
+    Real                       *deriv_y,
+    Real                       *deriv_z,
+    Real                       *deriv_xx,
+    Real                       *deriv_xy,
+    Real                       *deriv_xz,
+    Real                       *deriv_yy,
+    Real                       *deriv_yz,
+    Real                       *deriv_zz )
+{
+    int      i;
+    BOOLEAN  inside, want_derivs, want_second_derivs;
+    Real     voxel[MAX_DIMENSIONS], derivs[N_DIMENSIONS], second[6];
+    Real     h[N_DIMENSIONS][N_DIMENSIONS], t[N_DIMENSIONS][N_DIMENSIONS];
+
+    want_derivs = (deriv_x != NULL);
+    want_second_derivs = (deriv_xx != NULL);
+
+    convert_world_to_voxel( spline->volume, x, y, z, voxel );
+
+    inside = evaluate_spline_coef_volume( spline, voxel, outside_value, value,
+                                          want_derivs ? derivs : NULL,
+                                          want_second_derivs ? second : NULL );
+
+    if( want_derivs )
+    {
+        convert_voxel_normal_vector_to_world( spline->volume, derivs,
+                                              deriv_x, deriv_y, deriv_z );
+    }
+
+    if( want_second_derivs )
+    {
+        h[X][X] = second[0];
+        h[X][Y] = h[Y][X] = second[1];
+        h[X][Z] = h[Z][X] = second[2];
+        h[Y][Y] = second[3];
+        h[Y][Z] = h[Z][Y] = second[4];
+        h[Z][Z] = second[5];
+
+        /*--- transform the columns, then the rows, of the hessian */
+
+        for_less( i, 0, N_DIMENSIONS )
+        {
+            convert_voxel_normal_vector_to_world( spline->volume, h[i],
+                                          &t[X][i], &t[Y][i], &t[Z][i] );
+        }
+
+        for_less( i, 0, N_DIMENSIONS )
+        {
+            convert_voxel_normal_vector_to_world( spline->volume, t[i],
+                                          &h[X][i], &h[Y][i], &h[Z][i] );
+        }
+
+        *deriv_xx = h[X][X];
+        *deriv_xy = h[X][Y];
+        *deriv_xz = h[X][Z];
+        *deriv_yy = h[Y][Y];
+        *deriv_yz = h[Y][Z];
+        *deriv_zz = h[Z][Z];
+    }
+
+    return( inside );
+}
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_spline_coef_volume_coefs
+@INPUT      : spline
+              x, y, z
+@OUTPUT     : coefs    - 4 by 4 by 4 coefficients, z varying fastest
+@RETURNS    :
+@DESCRIPTION: Returns the coefficients that determine the spline in the
+              cell from voxel (x,y,z) to (x+1,y+1,z+1), that is, those of
+              voxels x-1 .. x+2 along each axis.  The spline lies within
+              their range, so they bound the values in the cell.
+@METHOD     :
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  get_spline_coef_volume_coefs(
+    spline_coef_volume_struct  *spline,
+    int                        x,
+    int                        y,
+    int                        z,
+    Real                       coefs[] )
+{
+    int      i, j, k, n;
+    size_t   offsets[N_DIMENSIONS][4], col;
+
+    get_coef_offsets( spline, X, x - 1, offsets[X] );
+    get_coef_offsets( spline, Y, y - 1, offsets[Y] );
+    get_coef_offsets( spline, Z, z - 1, offsets[Z] );
+
+    n = 0;
+    for_less( i, 0, 4 )
+    for_less( j, 0, 4 )
+    {
+        col = offsets[X][i] + offsets[Y][j];
+        for_less( k, 0, 4 )
+        {
+            coefs[n] = (Real) spline->coefs[col + offsets[Z][k]];
+            ++n;
+        }
+    }
+}
+
+/*--- converts 4 B-spline coefficients, spaced by stride, to the 4 samples
+      whose Catmull-Rom spline is the same cubic between the middle two */
+
+#define  BSPLINE_TO_CATMULL_ROM( c, stride ) \
+         { \
+             Real  _c0, _c1, _c2, _c3, _v1, _v2; \
+ \
+             _c0 = (c)[0]; \
+             _c1 = (c)[(stride)]; \
+             _c2 = (c)[2*(stride)]; \
+             _c3 = (c)[3*(stride)]; \
+             _v1 = (_c0 + 4.0 * _c1 + _c2) / 6.0; \
+             _v2 = (_c1 + 4.0 * _c2 + _c3) / 6.0; \
+             (c)[0] = _v2 - (_c2 - _c0); \
+             (c)[(stride)] = _v1; \
+             (c)[2*(stride)] = _v2; \
+             (c)[3*(stride)] = _v1 + (_c3 - _c1); \
+         }
+
+/* ----------------------------- MNI Header -----------------------------------
+@NAME       : get_spline_coef_volume_samples
+@INPUT      : spline
+              x, y, z
+@OUTPUT     : samples  - 4 by 4 by 4 values, z varying fastest
+@RETURNS    :
+@DESCRIPTION: Returns, for the cell from voxel (x,y,z) to (x+1,y+1,z+1), the
+              4 by 4 by 4 values whose tricubic Catmull-Rom interpolation,
+              as used by evaluate_volume() with degrees_continuity 2 and by
+              find_voxel_line_polynomial(), is exactly the B-spline in that
+              cell.  This lets code written for the voxel neighbourhood of
+              a cell evaluate the B-spline instead.
+@METHOD     : In each dimension, the Catmull-Rom cubic is determined by its
+              values and slopes at both ends of the cell, so the samples are
+              chosen to match those of the B-spline.
+@GLOBALS    :
+@CALLS      :
+@CREATED    : Oct. 2026
+@MODIFIED   :
+---------------------------------------------------------------------------- */
+
+BICAPI  void  get_spline_coef_volume_samples(
+    spline_coef_volume_struct  *spline,
+    int                        x,
+    int                        y,
+    int                        z,
+    Real                       samples[] )
+{
+    int   i, j;
+
+    get_spline_coef_volume_coefs( spline, x, y, z, samples );
+
+    for_less( i, 0, 4 )
+    for_less( j, 0, 4 )
+        BSPLINE_TO_CATMULL_ROM( &samples[i*16+j*4], 1 )
+
+    for_less( i, 0, 4 )
+    for_less( j, 0, 4 )
+        BSPLINE_TO_CATMULL_ROM( &samples[i*16+j], 4 )
+
+    for_less( i, 0, 4 )
+    for_less( j, 0, 4 )
+        BSPLINE_TO_CATMULL_ROM( &samples[i*4+j], 16 )
+}
@@ -27,6 +27,12 @@ private  void  print_transform(
     Transform   *trans );
 #endif
 
+private  BOOLEAN  add_surface(
+    polygons_struct  *polygons,
+    polygons_struct  *average_polygons,
+    int              *n_surfaces,
+    Point            ***points_list );
+
 int  main(
     int    argc,
     char   *argv[] )
@@ -35,11 +41,12 @@ int  main(
     FILE             *rms_file, *variance_file;
     STRING           filename, output_filename;
     STRING           rms_filename, variance_filename;
-    int              i, n_objects, n_surfaces, n_groups;
+    int              n_objects, n_surfaces, n_groups, s;
     File_formats     format;
     object_struct    *out_object;
     object_struct    **object_list;
     polygons_struct  *polygons, *average_polygons;
+    surface_bundle_struct  bundle;
     Point            **points_list;
     Transform        *transforms;
 
@@ -55,7 +62,7 @@ int  main(
         print_error(
           "Usage: %s output.obj  none|rms_file  none|variance_file n_groups\n",
                   argv[0] );
-        print_error( "         [input1.obj] [input2.obj] ...\n" );
+        print_error( "         [input1.obj|bundle.sbd] [input2.obj] ...\n" );
         return( 1 );
     }
 
@@ -72,6 +79,30 @@ int  main(
 
     while( get_string_argument( NULL, &filename ) )
     {
+        if( is_surface_bundle_file( filename ) )
+        {
+            if( open_surface_bundle( filename, &bundle ) != OK )
+            {
+                print( "Couldn't read %s.\n", filename );
+                return( 1 );
+            }
+
+            format = BINARY_FORMAT;
+
+            for_less( s, 0, get_surface_bundle_n_subjects( &bundle ) )
+            {
+                if( input_surface_bundle_subject( &bundle, s, FALSE ) != OK ||
+                    !add_surface( &bundle.polygons, average_polygons,
+                                  &n_surfaces, &points_list ) )
+                    return( 1 );
+
+                print( "%d:  %s[%d]\n", n_surfaces, filename, s );
+            }
+
+            (void) close_surface_bundle( &bundle );
+            continue;
+        }
+
         if( input_graphics_file( filename, &format, &n_objects,
                                  &object_list ) != OK )
         {
@@ -87,23 +118,9 @@ int  main(
 
         polygons = get_polygons_ptr( object_list[0] );
 
-        if( n_surfaces == 0 )
-        {
-            copy_polygons( polygons, average_polygons );
-        }
-        else if( !polygons_are_same_topology( average_polygons, polygons ) )
-        {
-            print( "Invalid polygons topology in file.\n" );
+        if( !add_surface( polygons, average_polygons, &n_surfaces,
+                          &points_list ) )
             return( 1 );
-        }
-
-        SET_ARRAY_SIZE( points_list, n_surfaces, n_surfaces+1, 1 );
-        ALLOC( points_list[n_surfaces], polygons->n_points );
-
-        for_less( i, 0, polygons->n_points )
-            points_list[n_surfaces][i] = polygons->points[i];
-
-        ++n_surfaces;
 
         print( "%d:  %s\n", n_surfaces, filename );
 
@@ -116,8 +133,8 @@ int  main(
                         points_list, transforms );
 
 #ifdef  PRINT_TRANSFORMS
-    for_less( i, 0, n_surfaces )
-        print_transform( &transforms[i] );
+    for_less( s, 0, n_surfaces )
+        print_transform( &transforms[s] );
 #endif
 
     if( rms_filename != NULL )
@@ -160,6 +177,38 @@ int  main(
     return( status != OK );
 }
 
+/*--- copies the points of a surface to the end of the points list, the
+      first surface also giving the topology of the average */
+
+private  BOOLEAN  add_surface(
+    polygons_struct  *polygons,
+    polygons_struct  *average_polygons,
+    int              *n_surfaces,
+    Point            ***points_list )
+{
+    int   i;
+
+    if( *n_surfaces == 0 )
+    {
+        copy_polygons( polygons, average_polygons );
+    }
+    else if( !polygons_are_same_topology( average_polygons, polygons ) )
+    {
+        print( "Invalid polygons topology in file.\n" );
+        return( FALSE );
+    }
+
+    SET_ARRAY_SIZE( *points_list, *n_surfaces, *n_surfaces+1, 1 );
+    ALLOC( (*points_list)[*n_surfaces], polygons->n_points );
+
+    for_less( i, 0, polygons->n_points )
+        (*points_list)[*n_surfaces][i] = polygons->points[i];
+
+    ++(*n_surfaces);
+
+    return( TRUE );
+}
+
 #ifdef SIMPLE_TRANSFORMATION
 
 #ifndef  USE_IDENTITY_TRANSFORMS
@@ -0,0 +1,103 @@
+#include <bicpl.h>
+
+private  void  usage(
+    STRING   executable )
+{
+    STRING  usage_str = "\n\
+Usage: %s  output.sbd  float32|float16|delta  input1.obj [input2.obj] ...\n\
+\n\
+     Writes the surfaces, which must all have the same topology, to a\n\
+     surface bundle file, storing the topology once and the points of each\n\
+     surface in the given encoding.  delta stores half precision\n\
+     differences from the first surface.\n\n";
+
+    print_error( usage_str, executable );
+}
+
+int  main(
+    int    argc,
+    char   *argv[] )
+{
+    STRING                 output_filename, encoding_name, input_filename;
+    int                    n_objects;
+    File_formats           format;
+    object_struct          **object_list;
+    polygons_struct        *polygons, topology;
+    Bundle_encodings       encoding;
+    surface_bundle_struct  bundle;
+    int                    n_surfaces;
+
+    initialize_argument_processing( argc, argv );
+
+    if( !get_string_argument( NULL, &output_filename ) ||
+        !get_string_argument( NULL, &encoding_name ) )
+    {
+        usage( argv[0] );
+        return( 1 );
+    }
+
+    if( equal_strings( encoding_name, "float32" ) )
+        encoding = BUNDLE_FLOAT32;
+    else if( equal_strings( encoding_name, "float16" ) )
+        encoding = BUNDLE_FLOAT16;
+    else if( equal_strings( encoding_name, "delta" ) )
+        encoding = BUNDLE_DELTA_FLOAT16;
+    else
+    {
+        usage( argv[0] );
+        return( 1 );
+    }
+
+    n_surfaces = 0;
+
+    while( get_string_argument( NULL, &input_filename ) )
+    {
+        if( input_graphics_file( input_filename, &format, &n_objects,
+                                 &object_list ) != OK )
+            return( 1 );
+
+        if( n_objects != 1 || get_object_type(object_list[0]) != POLYGONS )
+        {
+            print_error( "File %s must contain exactly 1 polygons struct.\n",
+                         input_filename );
+            return( 1 );
+        }
+
+        polygons = get_polygons_ptr( object_list[0] );
+
+        if( n_surfaces == 0 )
+        {
+            copy_polygons( polygons, &topology );
+
+            if( create_surface_bundle( output_filename, &topology, encoding,
+                                       &bundle ) != OK )
+                return( 1 );
+        }
+        else if( !polygons_are_same_topology( &topology, polygons ) )
+        {
+            print_error( "Surface %s has a different topology.\n",
+                         input_filename );
+            return( 1 );
+        }
+
+        if( add_surface_bundle_subject( &bundle, polygons->points ) != OK )
+            return( 1 );
+
+        ++n_surfaces;
+
+        delete_object_list( n_objects, object_list );
+    }
+
+    if( n_surfaces == 0 )
+    {
+        usage( argv[0] );
+        return( 1 );
+    }
+
+    if( close_surface_bundle( &bundle ) != OK )
+        return( 1 );
+
+    delete_polygons( &topology );
+
+    return( 0 );
+}
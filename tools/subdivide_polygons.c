@@ -80,8 +80,8 @@ private  void  resample_polygons(
     polygons_struct    *polygons,
     int                new_n_polygons )
 {
-    int               p, poly;
-    Point             centre, *points, src_point;
+    int               p, *polys;
+    Point             centre, *points, *src_points;
     polygons_struct   src_unit_sphere, dest_unit_sphere;
 
     fill_Point( centre, 0.0, 0.0, 0.0 );
@@ -97,19 +97,23 @@ private  void  resample_polygons(
                                     BINTREE_FACTOR ) );
 
     ALLOC( points, dest_unit_sphere.n_points );
+    ALLOC( src_points, dest_unit_sphere.n_points );
+    ALLOC( polys, dest_unit_sphere.n_points );
+
+    find_closest_polygon_points( dest_unit_sphere.n_points,
+                                 dest_unit_sphere.points, &src_unit_sphere,
+                                 0, src_points, polys );
 
     for_less( p, 0, dest_unit_sphere.n_points )
     {
-        poly = find_closest_polygon_point( &dest_unit_sphere.points[p],
-                                           &src_unit_sphere,
-                                           &src_point );
-
-        
-        map_point_between_polygons( &src_unit_sphere, poly,
-                                    &src_point, polygons,
+        map_point_between_polygons( &src_unit_sphere, polys[p],
+                                    &src_points[p], polygons,
                                     &points[p] );
     }
 
+    FREE( src_points );
+    FREE( polys );
+
     delete_polygons( &src_unit_sphere );
     delete_polygons( polygons );
 